@@ -14,6 +14,7 @@ IF (${PACKAGE_NAME}_TRILINOS_TPL)
       # BoostOrg is listed twice to have -isystem added to the include directories for the TPL when compiling the tests.
       # This is a known limitation of TriBITS (c.f. https://tribits.org/doc/TribitsDevelopersGuide.html#project-name-tpl-system-include-dirs)
       BoostOrg
+      GoogleBenchmark
     )
 ELSE()
   TRIBITS_PACKAGE_DEFINE_DEPENDENCIES(
@@ -30,5 +31,6 @@ ELSE()
       # BoostOrg is listed twice to have -isystem added to the include directories for the TPL when compiling the tests.
       # This is a known limitation of TriBITS (c.f. https://tribits.org/doc/TribitsDevelopersGuide.html#project-name-tpl-system-include-dirs)
       BoostOrg
+      GoogleBenchmark
     )
 ENDIF()
@@ -0,0 +1,8 @@
+# Google Benchmark is only used by the micro-benchmarks of the kernels. The
+# library may need to be linked with the threading library, in which case
+# TPL_GoogleBenchmark_LIBRARIES must list it explicitly.
+TRIBITS_TPL_FIND_INCLUDE_DIRS_AND_LIBRARIES(
+  GoogleBenchmark
+  REQUIRED_HEADERS benchmark/benchmark.h
+  REQUIRED_LIBS_NAMES benchmark
+  )
@@ -0,0 +1,373 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+/*!
+ * \file
+ * \brief Time the transfers between the deterministic and the Monte Carlo
+ * meshes of the hybrid transport benchmark.
+ *
+ * The source is the deterministic mesh, the target is the Monte Carlo mesh.
+ * The nearest neighbor and moving least squares operators transfer values
+ * from the deterministic cell centers to the Monte Carlo nodes, the
+ * interpolation transfers values from the deterministic nodes to the Monte
+ * Carlo cell centers. The setup and the apply of each map are timed
+ * separately and the average over the repetitions of the slowest rank is
+ * appended to a CSV file read by scripts/performance_plot.py.
+ *
+ * A strong scaling sweep runs the driver with the same sizes on an increasing
+ * number of ranks. With -w, the sizes in the Z direction are multiplied by
+ * the number of ranks so that the work per rank stays the same. The label of
+ * each run defaults to the number of ranks so that the plots show the
+ * timings against the number of ranks.
+ */
+
+#include "DTK_Benchmark_DeterministicMesh.hpp"
+#include "DTK_Benchmark_MonteCarloMesh.hpp"
+
+#include <DTK_Interpolation.hpp>
+#include <DTK_Mesh.hpp>
+#include <DTK_MovingLeastSquaresOperator.hpp>
+#include <DTK_NearestNeighborOperator.hpp>
+#include <DTK_Version.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <Teuchos_DefaultComm.hpp>
+#include <Teuchos_GlobalMPISession.hpp>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <getopt.h>
+
+using DeviceType = Kokkos::View<DataTransferKit::Coordinate **>::device_type;
+using ExecutionSpace = DeviceType::execution_space;
+
+//---------------------------------------------------------------------------//
+// Split the blocks of a set in the three directions, as evenly as possible.
+std::array<int, 3> splitBlocks( int num_blocks )
+{
+    std::array<int, 3> blocks = {{1, 1, 1}};
+    std::vector<int> factors;
+    for ( int f = 2; num_blocks > 1; ++f )
+        for ( ; num_blocks % f == 0; num_blocks /= f )
+            factors.push_back( f );
+    for ( auto f = factors.rbegin(); f != factors.rend(); ++f )
+        *std::min_element( blocks.begin(), blocks.end() ) *= *f;
+    return blocks;
+}
+
+//---------------------------------------------------------------------------//
+// Planes splitting [0, length] into num_blocks slabs. The outer planes are
+// moved outside of the mesh so that every cell belongs to a block.
+std::vector<double> boundaryMesh( int num_blocks, double length )
+{
+    std::vector<double> planes( num_blocks + 1 );
+    for ( int b = 0; b <= num_blocks; ++b )
+        planes[b] = b * length / num_blocks;
+    planes.front() -= 0.1 * length;
+    planes.back() += 0.1 * length;
+    return planes;
+}
+
+//---------------------------------------------------------------------------//
+// Time a call on the slowest rank, in microseconds.
+template <typename Function>
+double elapsed( MPI_Comm comm, Function const &function )
+{
+    MPI_Barrier( comm );
+    double const start = MPI_Wtime();
+    function();
+    Kokkos::fence();
+    double const local_time = MPI_Wtime() - start;
+    double time = 0.;
+    MPI_Allreduce( &local_time, &time, 1, MPI_DOUBLE, MPI_MAX, comm );
+    return 1e6 * time;
+}
+
+//---------------------------------------------------------------------------//
+// Value of the transferred field at the given points.
+Kokkos::View<double *, DeviceType>
+makeField( Kokkos::View<DataTransferKit::Coordinate **, DeviceType> points )
+{
+    Kokkos::View<double *, DeviceType> values( "values",
+                                               points.extent( 0 ) );
+    Kokkos::parallel_for( "fill_field",
+                          Kokkos::RangePolicy<ExecutionSpace>(
+                              0, points.extent( 0 ) ),
+                          KOKKOS_LAMBDA( int i ) {
+                              values( i ) = points( i, 0 ) + points( i, 1 ) +
+                                            points( i, 2 );
+                          } );
+    Kokkos::fence();
+    return values;
+}
+
+//---------------------------------------------------------------------------//
+// Average setup and apply times of a point cloud operator.
+template <typename Operator>
+std::array<double, 2> timeOperator(
+    MPI_Comm comm, int repetitions,
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> source_points,
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> target_points )
+{
+    std::array<double, 2> times = {{0., 0.}};
+    std::unique_ptr<Operator> op;
+    for ( int r = 0; r < repetitions; ++r )
+    {
+        op.reset();
+        times[0] += elapsed( comm, [&]() {
+            op.reset( new Operator( comm, source_points, target_points ) );
+        } );
+    }
+
+    auto const source_values = makeField( source_points );
+    Kokkos::View<double *, DeviceType> target_values(
+        "target_values", target_points.extent( 0 ) );
+    for ( int r = 0; r < repetitions; ++r )
+        times[1] += elapsed(
+            comm, [&]() { op->apply( source_values, target_values ); } );
+
+    times[0] /= repetitions;
+    times[1] /= repetitions;
+    return times;
+}
+
+//---------------------------------------------------------------------------//
+// Average setup and apply times of the interpolation of a field given at the
+// nodes of the mesh.
+std::array<double, 2> timeInterpolation(
+    MPI_Comm comm, int repetitions,
+    DataTransferKit::Benchmark::CartesianMesh const &source_mesh,
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> target_points )
+{
+    auto const connectivity = source_mesh.localCellConnectivity();
+    int const n_cells = connectivity.extent( 0 );
+    int const n_cell_nodes = connectivity.extent( 1 );
+    Kokkos::View<DTK_CellTopology *, DeviceType> cell_topologies(
+        "cell_topologies", n_cells );
+    Kokkos::deep_copy( cell_topologies, DTK_HEX_8 );
+    Kokkos::View<unsigned int *, DeviceType> cells( "cells",
+                                                    n_cells * n_cell_nodes );
+    Kokkos::View<DataTransferKit::LocalOrdinal *, DeviceType> cell_dofs_ids(
+        "cell_dofs_ids", n_cells * n_cell_nodes );
+    Kokkos::parallel_for( "flatten_connectivity",
+                          Kokkos::RangePolicy<ExecutionSpace>( 0, n_cells ),
+                          KOKKOS_LAMBDA( int i ) {
+                              for ( int n = 0; n < n_cell_nodes; ++n )
+                              {
+                                  cells( i * n_cell_nodes + n ) =
+                                      connectivity( i, n );
+                                  cell_dofs_ids( i * n_cell_nodes + n ) =
+                                      connectivity( i, n );
+                              }
+                          } );
+    Kokkos::fence();
+    auto const nodes = source_mesh.localNodeCoordinates();
+    DataTransferKit::Mesh<DeviceType> mesh( cell_topologies, cells, nodes );
+
+    std::array<double, 2> times = {{0., 0.}};
+    std::unique_ptr<DataTransferKit::Interpolation<DeviceType>> interpolation;
+    for ( int r = 0; r < repetitions; ++r )
+    {
+        interpolation.reset();
+        times[0] += elapsed( comm, [&]() {
+            interpolation.reset( new DataTransferKit::Interpolation<DeviceType>(
+                comm, mesh, target_points, cell_dofs_ids, DTK_HGRAD ) );
+        } );
+    }
+
+    auto const node_values = makeField( nodes );
+    Kokkos::View<double **, DeviceType> X( "X", nodes.extent( 0 ), 1 );
+    Kokkos::deep_copy( Kokkos::subview( X, Kokkos::ALL, 0 ), node_values );
+    Kokkos::View<double **, DeviceType> Y( "Y", target_points.extent( 0 ), 1 );
+    for ( int r = 0; r < repetitions; ++r )
+        times[1] +=
+            elapsed( comm, [&]() { interpolation->apply( X, Y ); } );
+
+    times[0] /= repetitions;
+    times[1] /= repetitions;
+    return times;
+}
+
+//---------------------------------------------------------------------------//
+int main( int argc, char *argv[] )
+{
+    Teuchos::GlobalMPISession mpi_session( &argc, &argv );
+    Kokkos::initialize( argc, argv );
+
+    // Parse command line parameters
+    std::array<int, 3> det_cells = {{32, 32, 32}};
+    std::array<int, 3> mc_cells = {{24, 24, 24}};
+    int num_sets = 1;
+    int repetitions = 10;
+    bool weak_scaling = false;
+    std::string output = "hybrid_transport.csv";
+    std::string label;
+    int opt;
+    while ( ( opt = getopt( argc, argv, "i:j:k:I:J:K:s:r:wo:l:h" ) ) != -1 )
+    {
+        switch ( opt )
+        {
+        case 'i':
+            det_cells[0] = std::atoi( optarg );
+            break;
+        case 'j':
+            det_cells[1] = std::atoi( optarg );
+            break;
+        case 'k':
+            det_cells[2] = std::atoi( optarg );
+            break;
+        case 'I':
+            mc_cells[0] = std::atoi( optarg );
+            break;
+        case 'J':
+            mc_cells[1] = std::atoi( optarg );
+            break;
+        case 'K':
+            mc_cells[2] = std::atoi( optarg );
+            break;
+        case 's':
+            num_sets = std::atoi( optarg );
+            break;
+        case 'r':
+            repetitions = std::atoi( optarg );
+            break;
+        case 'w':
+            weak_scaling = true;
+            break;
+        case 'o':
+            output = optarg;
+            break;
+        case 'l':
+            label = optarg;
+            break;
+        case 'h':
+        default:
+            std::printf(
+                "Usage: %s [-i <cells>] [-j <cells>] [-k <cells>] "
+                "[-I <cells>] [-J <cells>] [-K <cells>] [-s <sets>] "
+                "[-r <repetitions>] [-w] [-o <file>] [-l <label>] [-h]\n"
+                "  -i, -j, -k  deterministic cells in each direction\n"
+                "  -I, -J, -K  Monte Carlo cells in each direction\n"
+                "  -s          Monte Carlo sets, must divide the ranks\n"
+                "  -r          repetitions of each measure\n"
+                "  -w          weak scaling, the Z sizes grow with the "
+                "ranks\n"
+                "  -o          CSV file the timings are appended to\n"
+                "  -l          label of the run, defaults to the ranks\n",
+                argv[0] );
+            Kokkos::finalize();
+            return opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    auto teuchos_comm = Teuchos::DefaultComm<int>::getComm();
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int const comm_rank = teuchos_comm->getRank();
+    int const comm_size = teuchos_comm->getSize();
+    if ( num_sets < 1 || comm_size % num_sets != 0 || repetitions < 1 )
+    {
+        if ( comm_rank == 0 )
+            std::fprintf( stderr, "The number of sets must divide the number "
+                                  "of ranks and repetitions must be "
+                                  "positive\n" );
+        Kokkos::finalize();
+        return EXIT_FAILURE;
+    }
+    if ( weak_scaling )
+    {
+        det_cells[2] *= comm_size;
+        mc_cells[2] *= comm_size;
+    }
+    if ( label.empty() )
+        label = std::to_string( comm_size );
+
+    int status = EXIT_SUCCESS;
+    {
+        // Both meshes cover the same domain, with unit deterministic cells.
+        std::array<double, 3> length;
+        std::array<double, 3> mc_delta;
+        for ( int d = 0; d < 3; ++d )
+        {
+            length[d] = det_cells[d];
+            mc_delta[d] = length[d] / mc_cells[d];
+        }
+        DataTransferKit::Benchmark::DeterministicMesh det_mesh(
+            teuchos_comm, det_cells[0], det_cells[1], det_cells[2], 1., 1.,
+            1. );
+        auto const blocks = splitBlocks( comm_size / num_sets );
+        DataTransferKit::Benchmark::MonteCarloMesh mc_mesh(
+            teuchos_comm, num_sets, mc_cells[0], mc_cells[1], mc_cells[2],
+            mc_delta[0], mc_delta[1], mc_delta[2],
+            boundaryMesh( blocks[0], length[0] ),
+            boundaryMesh( blocks[1], length[1] ),
+            boundaryMesh( blocks[2], length[2] ) );
+        auto const det = det_mesh.cartesianMesh();
+        auto const mc = mc_mesh.cartesianMesh();
+
+        std::vector<std::string> const titles = {
+            "Nearest neighbor, deterministic cells to Monte Carlo nodes",
+            "Moving least squares, deterministic cells to Monte Carlo nodes",
+            "Interpolation, deterministic nodes to Monte Carlo cells"};
+        using NearestNeighbor =
+            DataTransferKit::NearestNeighborOperator<DeviceType>;
+        using MovingLeastSquares =
+            DataTransferKit::MovingLeastSquaresOperator<DeviceType>;
+        std::vector<std::array<double, 2>> times;
+        times.push_back( timeOperator<NearestNeighbor>(
+            comm, repetitions, det->localCellCenterCoordinates(),
+            mc->localNodeCoordinates() ) );
+        times.push_back( timeOperator<MovingLeastSquares>(
+            comm, repetitions, det->localCellCenterCoordinates(),
+            mc->localNodeCoordinates() ) );
+        times.push_back( timeInterpolation(
+            comm, repetitions, *det, mc->localCellCenterCoordinates() ) );
+
+        // The header lists the benchmarks and the timings of every row, each
+        // run then appends the commit hash, its label and one row per
+        // benchmark.
+        if ( comm_rank == 0 )
+        {
+            bool const new_file = !std::ifstream( output ).good();
+            std::ofstream file( output, std::ios::app );
+            if ( !file )
+            {
+                std::fprintf( stderr, "Cannot open %s\n", output.c_str() );
+                status = EXIT_FAILURE;
+            }
+            else
+            {
+                if ( new_file )
+                {
+                    file << titles.size() << '\n';
+                    for ( auto const &title : titles )
+                        file << title << '\n';
+                    file << "setup apply\n";
+                }
+                file << DataTransferKit::gitCommitHash() << '\n';
+                file << label << '\n';
+                for ( auto const &t : times )
+                    file << t[0] << ',' << t[1] << '\n';
+            }
+        }
+    }
+
+    Kokkos::finalize();
+    return status;
+}
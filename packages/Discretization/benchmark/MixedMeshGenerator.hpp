@@ -0,0 +1,352 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+/*!
+ * \file
+ * \brief Large meshes mixing the 3D topologies supported by PointSearch.
+ *
+ * The domain is a box of unit bricks, split in the Z direction between the
+ * ranks. Each brick is a HEX_8, two WEDGE_6, six TET_4 or six PYRAMID_5 with
+ * their apex at the center of the brick, chosen at random with the requested
+ * weights. The vertices inside the box are moved randomly by up to the
+ * requested fraction of a brick. The choices only depend on the seed and on
+ * the global indices of the bricks and of the vertices, so that the mesh does
+ * not change with the number of ranks. Quadratic meshes use HEX_27, WEDGE_18
+ * and TET_10, whose nodes are the images of the reference nodes by the map of
+ * the linear cell, while the pyramids stay linear.
+ *
+ * The cells do not share their nodes. The faces between different
+ * topologies do not match exactly once perturbed, which does not matter for
+ * timing the search.
+ */
+#ifndef DTK_MIXEDMESHGENERATOR_HPP
+#define DTK_MIXEDMESHGENERATOR_HPP
+
+#include <DTK_CellTypes.h>
+#include <DTK_DBC.hpp>
+#include <DTK_Mesh.hpp>
+#include <DTK_Types.h>
+
+#include <Intrepid2_HGRAD_HEX_C1_FEM.hpp>
+#include <Intrepid2_HGRAD_HEX_C2_FEM.hpp>
+#include <Intrepid2_HGRAD_TET_C1_FEM.hpp>
+#include <Intrepid2_HGRAD_TET_C2_FEM.hpp>
+#include <Intrepid2_HGRAD_WEDGE_C1_FEM.hpp>
+#include <Intrepid2_HGRAD_WEDGE_C2_FEM.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DynRankView.hpp>
+
+#include <mpi.h>
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace DataTransferKit
+{
+namespace Benchmark
+{
+// Relative numbers of bricks split into each type of cell.
+struct CellMix
+{
+    double hex = 1.;
+    double tet = 0.;
+    double wedge = 0.;
+    double pyramid = 0.;
+};
+
+using Point = std::array<double, 3>;
+
+// First and past the last layer of bricks owned by the rank.
+inline std::array<int, 2> localLayers( MPI_Comm comm, int n_layers )
+{
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+    long long const n = n_layers;
+    return {{static_cast<int>( n * comm_rank / comm_size ),
+             static_cast<int>( n * ( comm_rank + 1 ) / comm_size )}};
+}
+
+// Value in [0, 1) only depending on the seed and on the indices.
+inline double hashUniform( unsigned int seed, long long i, long long j,
+                           long long k, int c )
+{
+    std::uint64_t h = seed;
+    for ( std::uint64_t v : {static_cast<std::uint64_t>( i ),
+                             static_cast<std::uint64_t>( j ),
+                             static_cast<std::uint64_t>( k ),
+                             static_cast<std::uint64_t>( c )} )
+    {
+        // splitmix64
+        h += v + 0x9e3779b97f4a7c15ULL;
+        h = ( h ^ ( h >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+        h = ( h ^ ( h >> 27 ) ) * 0x94d049bb133111ebULL;
+        h ^= h >> 31;
+    }
+    return ( h >> 11 ) * ( 1. / ( 1ULL << 53 ) );
+}
+
+// det(a - o, b - o, c - o), positive when the four points are ordered as
+// the vertices of the reference tetrahedron.
+inline double tripleProduct( Point const &o, Point const &a, Point const &b,
+                             Point const &c )
+{
+    Point u, v, w;
+    for ( int d = 0; d < 3; ++d )
+    {
+        u[d] = a[d] - o[d];
+        v[d] = b[d] - o[d];
+        w[d] = c[d] - o[d];
+    }
+    return u[0] * ( v[1] * w[2] - v[2] * w[1] ) -
+           u[1] * ( v[0] * w[2] - v[2] * w[0] ) +
+           u[2] * ( v[0] * w[1] - v[1] * w[0] );
+}
+
+// Weights of the vertices of a linear cell giving the nodes of the quadratic
+// cell with the same geometry, n_nodes x n_vertices.
+template <typename LinearBasis, typename QuadraticBasis>
+std::vector<double> quadraticNodeWeights()
+{
+    using ExecutionSpace = Kokkos::DefaultHostExecutionSpace;
+    LinearBasis linear;
+    QuadraticBasis quadratic;
+    int const n_vertices = linear.getCardinality();
+    int const n_nodes = quadratic.getCardinality();
+    Kokkos::DynRankView<double, ExecutionSpace> nodes( "nodes", n_nodes, 3 );
+    quadratic.getDofCoords( nodes );
+    Kokkos::DynRankView<double, ExecutionSpace> values( "values", n_vertices,
+                                                        n_nodes );
+    linear.getValues( values, nodes, Intrepid2::OPERATOR_VALUE );
+    std::vector<double> weights( n_nodes * n_vertices );
+    for ( int n = 0; n < n_nodes; ++n )
+        for ( int v = 0; v < n_vertices; ++v )
+            weights[n * n_vertices + v] = values( v, n );
+    return weights;
+}
+
+class MixedMeshBuilder
+{
+  public:
+    MixedMeshBuilder( std::array<int, 3> const &n_bricks, int order,
+                      double perturbation, unsigned int seed )
+        : _n_bricks( n_bricks )
+        , _perturbation( perturbation )
+        , _seed( seed )
+        , _quadratic( order == 2 )
+    {
+        DTK_REQUIRE( order == 1 || order == 2 );
+        if ( _quadratic )
+        {
+            using ExecutionSpace = Kokkos::DefaultHostExecutionSpace;
+            _node_weights[DTK_HEX_8] = quadraticNodeWeights<
+                Intrepid2::Basis_HGRAD_HEX_C1_FEM<ExecutionSpace>,
+                Intrepid2::Basis_HGRAD_HEX_C2_FEM<ExecutionSpace>>();
+            _node_weights[DTK_TET_4] = quadraticNodeWeights<
+                Intrepid2::Basis_HGRAD_TET_C1_FEM<ExecutionSpace>,
+                Intrepid2::Basis_HGRAD_TET_C2_FEM<ExecutionSpace>>();
+            _node_weights[DTK_WEDGE_6] = quadraticNodeWeights<
+                Intrepid2::Basis_HGRAD_WEDGE_C1_FEM<ExecutionSpace>,
+                Intrepid2::Basis_HGRAD_WEDGE_C2_FEM<ExecutionSpace>>();
+        }
+    }
+
+    // Vertex (i, j, k) of the global grid of bricks.
+    Point vertex( int i, int j, int k ) const
+    {
+        Point p = {{static_cast<double>( i ), static_cast<double>( j ),
+                    static_cast<double>( k )}};
+        bool const interior = i > 0 && i < _n_bricks[0] && j > 0 &&
+                              j < _n_bricks[1] && k > 0 && k < _n_bricks[2];
+        if ( interior )
+            for ( int d = 0; d < 3; ++d )
+                p[d] += _perturbation *
+                        ( 2. * hashUniform( _seed, i, j, k, d ) - 1. );
+        return p;
+    }
+
+    // Split the brick (i, j, k) into cells of the topology.
+    void addBrick( int i, int j, int k, DTK_CellTopology topo )
+    {
+        // Corners in the order of the vertices of a HEX_8.
+        std::array<Point, 8> c;
+        for ( int n = 0; n < 8; ++n )
+            c[n] = vertex( i + ( ( n + 1 ) / 2 ) % 2, j + ( n / 2 ) % 2,
+                           k + n / 4 );
+
+        switch ( topo )
+        {
+        case DTK_HEX_8:
+        {
+            addCell( DTK_HEX_8, std::vector<Point>( c.begin(), c.end() ) );
+            break;
+        }
+        case DTK_WEDGE_6:
+        {
+            // Split along the diagonal of the bottom and top faces.
+            addCell( DTK_WEDGE_6, {c[0], c[1], c[2], c[4], c[5], c[6]} );
+            addCell( DTK_WEDGE_6, {c[0], c[2], c[3], c[4], c[6], c[7]} );
+            break;
+        }
+        case DTK_TET_4:
+        {
+            // The six paths along the edges from corner 0 to corner 6.
+            int const paths[6][2] = {{1, 2}, {1, 5}, {3, 2},
+                                     {3, 7}, {4, 5}, {4, 7}};
+            for ( auto const &path : paths )
+            {
+                std::vector<Point> tet = {c[0], c[path[0]], c[path[1]], c[6]};
+                if ( tripleProduct( tet[0], tet[1], tet[2], tet[3] ) < 0. )
+                    std::swap( tet[1], tet[2] );
+                addCell( DTK_TET_4, tet );
+            }
+            break;
+        }
+        case DTK_PYRAMID_5:
+        {
+            // One pyramid per face, with the center of the brick as apex.
+            Point center = {{0., 0., 0.}};
+            for ( auto const &p : c )
+                for ( int d = 0; d < 3; ++d )
+                    center[d] += p[d] / 8.;
+            int const faces[6][4] = {{0, 1, 2, 3}, {4, 5, 6, 7},
+                                     {0, 1, 5, 4}, {3, 2, 6, 7},
+                                     {0, 3, 7, 4}, {1, 2, 6, 5}};
+            for ( auto const &face : faces )
+            {
+                std::vector<Point> pyramid = {c[face[0]], c[face[1]],
+                                              c[face[2]], c[face[3]], center};
+                if ( tripleProduct( pyramid[0], pyramid[1], pyramid[3],
+                                    center ) < 0. )
+                    std::swap( pyramid[1], pyramid[3] );
+                addCell( DTK_PYRAMID_5, pyramid );
+            }
+            break;
+        }
+        default:
+            throw DataTransferKitException( "Unsupported topology" );
+        }
+    }
+
+    template <typename DeviceType>
+    Mesh<DeviceType> mesh() const
+    {
+        unsigned int const n_cells = _topologies.size();
+        unsigned int const n_nodes = _coordinates.size() / 3;
+        Kokkos::View<DTK_CellTopology *, DeviceType> cell_topologies(
+            "cell_topologies", n_cells );
+        Kokkos::View<unsigned int *, DeviceType> cells( "cells", n_nodes );
+        Kokkos::View<Coordinate **, DeviceType> coordinates( "coordinates",
+                                                             n_nodes, 3 );
+        auto cell_topologies_host =
+            Kokkos::create_mirror_view( cell_topologies );
+        auto cells_host = Kokkos::create_mirror_view( cells );
+        auto coordinates_host = Kokkos::create_mirror_view( coordinates );
+        for ( unsigned int i = 0; i < n_cells; ++i )
+            cell_topologies_host( i ) = _topologies[i];
+        for ( unsigned int n = 0; n < n_nodes; ++n )
+        {
+            cells_host( n ) = n;
+            for ( int d = 0; d < 3; ++d )
+                coordinates_host( n, d ) = _coordinates[3 * n + d];
+        }
+        Kokkos::deep_copy( cell_topologies, cell_topologies_host );
+        Kokkos::deep_copy( cells, cells_host );
+        Kokkos::deep_copy( coordinates, coordinates_host );
+        return Mesh<DeviceType>( cell_topologies, cells, coordinates );
+    }
+
+  private:
+    void addCell( DTK_CellTopology topo, std::vector<Point> const &vertices )
+    {
+        if ( !_quadratic || topo == DTK_PYRAMID_5 )
+        {
+            _topologies.push_back( topo );
+            for ( auto const &p : vertices )
+                _coordinates.insert( _coordinates.end(), p.begin(), p.end() );
+            return;
+        }
+
+        if ( topo == DTK_HEX_8 )
+            _topologies.push_back( DTK_HEX_27 );
+        else if ( topo == DTK_TET_4 )
+            _topologies.push_back( DTK_TET_10 );
+        else
+            _topologies.push_back( DTK_WEDGE_18 );
+        auto const &weights = _node_weights[topo];
+        unsigned int const n_vertices = vertices.size();
+        unsigned int const n_nodes = weights.size() / n_vertices;
+        for ( unsigned int n = 0; n < n_nodes; ++n )
+            for ( int d = 0; d < 3; ++d )
+            {
+                double x = 0.;
+                for ( unsigned int v = 0; v < n_vertices; ++v )
+                    x += weights[n * n_vertices + v] * vertices[v][d];
+                _coordinates.push_back( x );
+            }
+    }
+
+    std::array<int, 3> _n_bricks;
+    double _perturbation;
+    unsigned int _seed;
+    bool _quadratic;
+    std::array<std::vector<double>, DTK_N_TOPO> _node_weights;
+    std::vector<DTK_CellTopology> _topologies;
+    std::vector<double> _coordinates;
+};
+
+/*!
+ * Build the cells of the layers of bricks owned by the rank.
+ *
+ * \param n_bricks Number of bricks of the whole box in each direction.
+ * \param mix Relative numbers of bricks split into each type of cell.
+ * \param order 1 for linear cells, 2 for quadratic cells.
+ * \param perturbation Largest displacement of the vertices, as a fraction of
+ * the size of a brick. It must stay below 0.25 for the cells to stay valid.
+ * \param seed Seed of the random choices.
+ */
+template <typename DeviceType>
+Mesh<DeviceType> buildMixedMesh( MPI_Comm comm,
+                                 std::array<int, 3> const &n_bricks,
+                                 CellMix const &mix, int order,
+                                 double perturbation, unsigned int seed = 0 )
+{
+    double const total = mix.hex + mix.tet + mix.wedge + mix.pyramid;
+    DTK_REQUIRE( mix.hex >= 0. && mix.tet >= 0. && mix.wedge >= 0. &&
+                 mix.pyramid >= 0. && total > 0. );
+    std::array<std::pair<double, DTK_CellTopology>, 4> const thresholds = {
+        {{mix.hex / total, DTK_HEX_8},
+         {( mix.hex + mix.tet ) / total, DTK_TET_4},
+         {( mix.hex + mix.tet + mix.wedge ) / total, DTK_WEDGE_6},
+         {1., DTK_PYRAMID_5}}};
+
+    MixedMeshBuilder builder( n_bricks, order, perturbation, seed );
+    auto const layers = localLayers( comm, n_bricks[2] );
+    for ( int k = layers[0]; k < layers[1]; ++k )
+        for ( int j = 0; j < n_bricks[1]; ++j )
+            for ( int i = 0; i < n_bricks[0]; ++i )
+            {
+                // Components 0 to 2 perturb the vertices.
+                double const u = hashUniform( seed, i, j, k, 3 );
+                unsigned int t = 0;
+                while ( t < thresholds.size() - 1 && u >= thresholds[t].first )
+                    ++t;
+                builder.addBrick( i, j, k, thresholds[t].second );
+            }
+    return builder.mesh<DeviceType>();
+}
+} // namespace Benchmark
+} // namespace DataTransferKit
+
+#endif
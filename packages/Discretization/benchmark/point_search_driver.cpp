@@ -0,0 +1,438 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+/*!
+ * \file
+ * \brief Time the phases of PointSearch and the interpolation on large
+ * meshes mixing several topologies.
+ *
+ * The mesh is built by buildMixedMesh() and the points are drawn at random in
+ * the box, half a slab of bricks above the part of the mesh owned by the
+ * rank so that about half of them are found on the next rank. The phases of
+ * PointSearch are the regions of the built-in profiler: the bounding boxes,
+ * the distributed search that moves the points to the ranks owning the
+ * candidate cells, PointInCell for each topology, the distributor sending
+ * the results back, and getSearchResults(). The profiler fences at the end
+ * of every region, so that the total is slightly larger than without
+ * profiling. The interpolation is then set up and applied for each type of
+ * finite element. HDIV and HCURL are only available on HEX_8 and TET_4
+ * cells, so that they use a linear mesh where the bricks that are not split
+ * into tetrahedra are hexahedra.
+ *
+ * The average over the ranks and the time of the slowest rank, averaged over
+ * the repetitions, are printed and appended to a CSV file read by
+ * scripts/performance_plot.py. The rows depend on the topologies in the
+ * mesh, so that each mesh configuration needs its own file. With -w, the
+ * bricks in the Z direction and the points are multiplied by the number of
+ * ranks so that the work per rank stays the same.
+ */
+
+#include "MixedMeshGenerator.hpp"
+
+#include <DTK_FE.hpp>
+#include <DTK_Interpolation.hpp>
+#include <DTK_Mesh.hpp>
+#include <DTK_PointSearch.hpp>
+#include <DTK_Profiling.hpp>
+#include <DTK_Version.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <Teuchos_GlobalMPISession.hpp>
+
+#include <mpi.h>
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <getopt.h>
+
+using DeviceType = Kokkos::View<DataTransferKit::Coordinate **>::device_type;
+using ExecutionSpace = DeviceType::execution_space;
+
+//---------------------------------------------------------------------------//
+char const *topologyName( int topo )
+{
+    char const *names[DTK_N_TOPO] = {
+        "TRI_3",     "TRI_6",      "QUAD_4",  "QUAD_9",   "TET_4",
+        "TET_10",    "TET_11",     "HEX_8",   "HEX_20",   "HEX_27",
+        "PYRAMID_5", "PYRAMID_13", "WEDGE_6", "WEDGE_15", "WEDGE_18"};
+    return names[topo];
+}
+
+//---------------------------------------------------------------------------//
+// Average over the ranks and largest time of the ranks, in microseconds.
+std::array<double, 2> reduceTime( MPI_Comm comm, double local_time )
+{
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+    double sum = 0.;
+    double max = 0.;
+    MPI_Allreduce( &local_time, &sum, 1, MPI_DOUBLE, MPI_SUM, comm );
+    MPI_Allreduce( &local_time, &max, 1, MPI_DOUBLE, MPI_MAX, comm );
+    return {{1e6 * sum / comm_size, 1e6 * max}};
+}
+
+//---------------------------------------------------------------------------//
+// Time of a call on this rank, in seconds.
+template <typename Function>
+double localElapsed( MPI_Comm comm, Function const &function )
+{
+    MPI_Barrier( comm );
+    double const start = MPI_Wtime();
+    function();
+    Kokkos::fence();
+    return MPI_Wtime() - start;
+}
+
+//---------------------------------------------------------------------------//
+// Points drawn at random in the box, half a slab above the bricks of the
+// rank and wrapped around in the Z direction.
+Kokkos::View<DataTransferKit::Coordinate **, DeviceType>
+makePoints( MPI_Comm comm, std::array<int, 3> const &n_bricks,
+            long long n_points, unsigned int seed )
+{
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+    int const n_local = n_points * ( comm_rank + 1 ) / comm_size -
+                        n_points * comm_rank / comm_size;
+    auto const layers = DataTransferKit::Benchmark::localLayers(
+        comm, n_bricks[2] );
+    double const shift = 0.5 * ( layers[1] - layers[0] );
+
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> points(
+        "points", n_local, 3 );
+    auto points_host = Kokkos::create_mirror_view( points );
+    std::mt19937 generator( seed + comm_rank );
+    std::uniform_real_distribution<double> x( 0., n_bricks[0] );
+    std::uniform_real_distribution<double> y( 0., n_bricks[1] );
+    std::uniform_real_distribution<double> z( layers[0] + shift,
+                                              layers[1] + shift );
+    for ( int i = 0; i < n_local; ++i )
+    {
+        points_host( i, 0 ) = x( generator );
+        points_host( i, 1 ) = y( generator );
+        double const z_i = z( generator );
+        points_host( i, 2 ) = z_i < n_bricks[2] ? z_i : z_i - n_bricks[2];
+    }
+    Kokkos::deep_copy( points, points_host );
+    return points;
+}
+
+//---------------------------------------------------------------------------//
+// Timings of the phases of PointSearch, in the order of the titles.
+std::vector<std::array<double, 2>> timePointSearch(
+    MPI_Comm comm, int repetitions,
+    DataTransferKit::Mesh<DeviceType> const &mesh,
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> points,
+    std::vector<std::string> &titles )
+{
+    namespace Profiling = DataTransferKit::Profiling;
+
+    // One PointInCell row for each topology of the mesh of any rank.
+    auto cell_topologies_host =
+        Kokkos::create_mirror_view( mesh.cell_topologies );
+    Kokkos::deep_copy( cell_topologies_host, mesh.cell_topologies );
+    std::array<int, DTK_N_TOPO> local_present;
+    local_present.fill( 0 );
+    for ( unsigned int i = 0; i < cell_topologies_host.extent( 0 ); ++i )
+        local_present[cell_topologies_host( i )] = 1;
+    std::array<int, DTK_N_TOPO> present;
+    MPI_Allreduce( local_present.data(), present.data(), DTK_N_TOPO, MPI_INT,
+                   MPI_MAX, comm );
+
+    std::vector<std::string> regions = {"DTK_point_search_setup",
+                                        "DTK_bounding_boxes",
+                                        "DTK_perform_distributed_search"};
+    titles.push_back( "PointSearch setup" );
+    titles.push_back( "PointSearch bounding boxes" );
+    titles.push_back( "PointSearch distributed search" );
+    for ( int topo = 0; topo < DTK_N_TOPO; ++topo )
+        if ( present[topo] )
+        {
+            regions.push_back( "DTK_point_in_cell_" + std::to_string( topo ) );
+            titles.push_back( std::string( "PointSearch PointInCell " ) +
+                              topologyName( topo ) );
+        }
+    regions.push_back( "DTK_build_distributor" );
+    titles.push_back( "PointSearch distributor" );
+    regions.push_back( "DTK_search_results" );
+    titles.push_back( "PointSearch results" );
+
+    std::vector<std::array<double, 2>> times( regions.size(), {{0., 0.}} );
+    for ( int r = 0; r < repetitions; ++r )
+    {
+        MPI_Barrier( comm );
+        Profiling::reset();
+        Profiling::enable();
+        {
+            DataTransferKit::PointSearch<DeviceType> search( comm, mesh,
+                                                             points );
+            search.getSearchResults();
+        }
+        Profiling::disable();
+        for ( unsigned int p = 0; p < regions.size(); ++p )
+        {
+            auto const t =
+                reduceTime( comm, Profiling::totalTime( regions[p] ) );
+            times[p][0] += t[0] / repetitions;
+            times[p][1] += t[1] / repetitions;
+        }
+    }
+    Profiling::reset();
+    return times;
+}
+
+//---------------------------------------------------------------------------//
+// Timings of the setup and of the apply of the interpolation of a field
+// with independent degrees of freedom in each cell.
+std::array<std::array<double, 2>, 2> timeInterpolation(
+    MPI_Comm comm, int repetitions,
+    DataTransferKit::Mesh<DeviceType> const &mesh,
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> points,
+    DTK_FEType fe_type )
+{
+    auto cell_topologies_host =
+        Kokkos::create_mirror_view( mesh.cell_topologies );
+    Kokkos::deep_copy( cell_topologies_host, mesh.cell_topologies );
+    std::array<int, DTK_N_TOPO> cardinality;
+    cardinality.fill( -1 );
+    unsigned int n_dofs = 0;
+    for ( unsigned int i = 0; i < cell_topologies_host.extent( 0 ); ++i )
+    {
+        auto const topo = cell_topologies_host( i );
+        if ( cardinality[topo] < 0 )
+            cardinality[topo] = DataTransferKit::getCardinality<DeviceType>(
+                DataTransferKit::getFE( topo, fe_type ) );
+        n_dofs += cardinality[topo];
+    }
+    Kokkos::View<DataTransferKit::LocalOrdinal *, DeviceType> cell_dofs_ids(
+        "cell_dofs_ids", n_dofs );
+    Kokkos::parallel_for( "fill_cell_dofs_ids",
+                          Kokkos::RangePolicy<ExecutionSpace>( 0, n_dofs ),
+                          KOKKOS_LAMBDA( int i ) { cell_dofs_ids( i ) = i; } );
+    Kokkos::fence();
+
+    std::array<std::array<double, 2>, 2> times = {{{{0., 0.}}, {{0., 0.}}}};
+    using Interpolation = DataTransferKit::Interpolation<DeviceType>;
+    std::unique_ptr<Interpolation> interpolation;
+    auto const setup = [&]() {
+        interpolation.reset(
+            new Interpolation( comm, mesh, points, cell_dofs_ids, fe_type ) );
+    };
+    for ( int r = 0; r < repetitions; ++r )
+    {
+        interpolation.reset();
+        auto const t = reduceTime( comm, localElapsed( comm, setup ) );
+        times[0][0] += t[0] / repetitions;
+        times[0][1] += t[1] / repetitions;
+    }
+
+    Kokkos::View<double **, DeviceType> X( "X", n_dofs, 1 );
+    Kokkos::deep_copy( X, 1. );
+    Kokkos::View<double **, DeviceType> Y( "Y", points.extent( 0 ), 1 );
+    auto const apply = [&]() { interpolation->apply( X, Y ); };
+    for ( int r = 0; r < repetitions; ++r )
+    {
+        auto const t = reduceTime( comm, localElapsed( comm, apply ) );
+        times[1][0] += t[0] / repetitions;
+        times[1][1] += t[1] / repetitions;
+    }
+    return times;
+}
+
+//---------------------------------------------------------------------------//
+int main( int argc, char *argv[] )
+{
+    Teuchos::GlobalMPISession mpi_session( &argc, &argv );
+    Kokkos::initialize( argc, argv );
+
+    // Parse command line parameters
+    std::array<int, 3> n_bricks = {{32, 32, 32}};
+    DataTransferKit::Benchmark::CellMix mix;
+    mix.hex = mix.tet = mix.wedge = mix.pyramid = 1.;
+    int order = 1;
+    double perturbation = 0.2;
+    long long n_points = 1 << 20;
+    unsigned int seed = 0;
+    int repetitions = 5;
+    bool weak_scaling = false;
+    std::string output = "point_search.csv";
+    std::string label;
+    int opt;
+    while ( ( opt = getopt( argc, argv, "i:j:k:m:p:d:n:s:r:wo:l:h" ) ) != -1 )
+    {
+        switch ( opt )
+        {
+        case 'i':
+            n_bricks[0] = std::atoi( optarg );
+            break;
+        case 'j':
+            n_bricks[1] = std::atoi( optarg );
+            break;
+        case 'k':
+            n_bricks[2] = std::atoi( optarg );
+            break;
+        case 'm':
+            if ( std::sscanf( optarg, "%lf,%lf,%lf,%lf", &mix.hex, &mix.tet,
+                              &mix.wedge, &mix.pyramid ) != 4 )
+                mix.hex = -1.;
+            break;
+        case 'p':
+            order = std::atoi( optarg );
+            break;
+        case 'd':
+            perturbation = std::atof( optarg );
+            break;
+        case 'n':
+            n_points = std::atoll( optarg );
+            break;
+        case 's':
+            seed = std::atoi( optarg );
+            break;
+        case 'r':
+            repetitions = std::atoi( optarg );
+            break;
+        case 'w':
+            weak_scaling = true;
+            break;
+        case 'o':
+            output = optarg;
+            break;
+        case 'l':
+            label = optarg;
+            break;
+        case 'h':
+        default:
+            std::printf(
+                "Usage: %s [-i <bricks>] [-j <bricks>] [-k <bricks>] "
+                "[-m <hex,tet,wedge,pyramid>] [-p <order>] "
+                "[-d <perturbation>] [-n <points>] [-s <seed>] "
+                "[-r <repetitions>] [-w] [-o <file>] [-l <label>] [-h]\n"
+                "  -i, -j, -k  bricks in each direction\n"
+                "  -m          relative numbers of bricks split into each "
+                "topology\n"
+                "  -p          1 for linear cells, 2 for quadratic cells\n"
+                "  -d          displacement of the vertices, below 0.25\n"
+                "  -n          points searched\n"
+                "  -s          seed of the mesh and of the points\n"
+                "  -r          repetitions of each measure\n"
+                "  -w          weak scaling, the Z bricks and the points "
+                "grow with the ranks\n"
+                "  -o          CSV file the timings are appended to\n"
+                "  -l          label of the run, defaults to the ranks\n",
+                argv[0] );
+            Kokkos::finalize();
+            return opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+    if ( weak_scaling )
+    {
+        n_bricks[2] *= comm_size;
+        n_points *= comm_size;
+    }
+    bool const valid_mix = mix.hex >= 0. && mix.tet >= 0. &&
+                           mix.wedge >= 0. && mix.pyramid >= 0. &&
+                           mix.hex + mix.tet + mix.wedge + mix.pyramid > 0.;
+    if ( n_bricks[0] < 1 || n_bricks[1] < 1 || n_bricks[2] < comm_size ||
+         !valid_mix || ( order != 1 && order != 2 ) || perturbation < 0. ||
+         perturbation >= 0.25 || n_points < 1 || repetitions < 1 )
+    {
+        if ( comm_rank == 0 )
+            std::fprintf( stderr, "Invalid parameters, every rank needs a "
+                                  "layer of bricks, see -h\n" );
+        Kokkos::finalize();
+        return EXIT_FAILURE;
+    }
+    if ( label.empty() )
+        label = std::to_string( comm_size );
+
+    int status = EXIT_SUCCESS;
+    {
+        using DataTransferKit::Benchmark::buildMixedMesh;
+        auto const mesh = buildMixedMesh<DeviceType>(
+            comm, n_bricks, mix, order, perturbation, seed );
+        auto const points = makePoints( comm, n_bricks, n_points, seed );
+
+        std::vector<std::string> titles;
+        auto times = timePointSearch( comm, repetitions, mesh, points, titles );
+
+        // HDIV and HCURL are only implemented for HEX_8 and TET_4.
+        DataTransferKit::Benchmark::CellMix linear_mix;
+        linear_mix.hex = mix.hex + mix.wedge + mix.pyramid;
+        linear_mix.tet = mix.tet;
+        auto const linear_mesh = buildMixedMesh<DeviceType>(
+            comm, n_bricks, linear_mix, 1, perturbation, seed );
+        std::array<std::pair<DTK_FEType, std::string>, 3> const fe_types = {
+            {{DTK_HGRAD, "HGRAD"}, {DTK_HDIV, "HDIV"}, {DTK_HCURL, "HCURL"}}};
+        for ( auto const &fe_type : fe_types )
+        {
+            auto const &fe_mesh =
+                fe_type.first == DTK_HGRAD ? mesh : linear_mesh;
+            auto const t = timeInterpolation( comm, repetitions, fe_mesh,
+                                              points, fe_type.first );
+            titles.push_back( "Interpolation " + fe_type.second + " setup" );
+            times.push_back( t[0] );
+            titles.push_back( "Interpolation " + fe_type.second + " apply" );
+            times.push_back( t[1] );
+        }
+
+        if ( comm_rank == 0 )
+        {
+            std::printf( "%-40s %12s %12s\n", "", "average [us]", "max [us]" );
+            for ( unsigned int b = 0; b < titles.size(); ++b )
+                std::printf( "%-40s %12.0f %12.0f\n", titles[b].c_str(),
+                             times[b][0], times[b][1] );
+
+            // The header lists the benchmarks and the timings of every row,
+            // each run then appends the commit hash, its label and one row
+            // per benchmark.
+            bool const new_file = !std::ifstream( output ).good();
+            std::ofstream file( output, std::ios::app );
+            if ( !file )
+            {
+                std::fprintf( stderr, "Cannot open %s\n", output.c_str() );
+                status = EXIT_FAILURE;
+            }
+            else
+            {
+                if ( new_file )
+                {
+                    file << titles.size() << '\n';
+                    for ( auto const &title : titles )
+                        file << title << '\n';
+                    file << "average max\n";
+                }
+                file << DataTransferKit::gitCommitHash() << '\n';
+                file << label << '\n';
+                for ( auto const &t : times )
+                    file << t[0] << ',' << t[1] << '\n';
+            }
+        }
+    }
+
+    Kokkos::finalize();
+    return status;
+}
@@ -74,20 +74,22 @@ std::array<unsigned int, DTK_N_TOPO> computeNCellsPerTopology(
     return n_cells_per_topo;
 }
 
-template <typename DeviceType>
-void checkOffsetOverflow( Kokkos::View<unsigned int *, DeviceType> offset )
+// The offsets are exclusive prefix sums of nonnegative values, so they wrap
+// around if they are decreasing somewhere.
+template <typename DeviceType, typename OffsetType>
+void checkOffsetOverflow( Kokkos::View<OffsetType *, DeviceType> offset )
 {
 #if HAVE_DTK_DBC
     // Check that we didn't overflow offset
     Kokkos::View<int[1], DeviceType> overflow( "overflow" );
 
-    unsigned int const size = overflow.extent( 0 );
+    int const size = offset.extent( 0 );
     using ExecutionSpace = typename DeviceType::execution_space;
     Kokkos::parallel_for(
         DTK_MARK_REGION( "check_overflow" ),
-        Kokkos::RangePolicy<ExecutionSpace>( 0, size - 1 ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, size > 0 ? size - 1 : 0 ),
         KOKKOS_LAMBDA( int const i ) {
-            if ( static_cast<int>( offset( i + 1 ) - offset( i ) ) < 0 )
+            if ( offset( i + 1 ) < offset( i ) )
                 overflow[0] = 1;
         } );
     Kokkos::fence();
@@ -99,9 +101,9 @@ void checkOffsetOverflow( Kokkos::View<unsigned int *, DeviceType> offset )
 #endif
 }
 
-template <typename DeviceType, typename T1, typename T2>
+template <typename DeviceType, typename T1, typename T2, typename OffsetType>
 void computeOffset( Kokkos::View<T1 *, DeviceType> predicate, T2 value,
-                    Kokkos::View<unsigned int *, DeviceType> offset )
+                    Kokkos::View<OffsetType *, DeviceType> offset )
 {
     DTK_REQUIRE( predicate.extent( 0 ) == offset.extent( 0 ) );
 
@@ -109,7 +111,7 @@ void computeOffset( Kokkos::View<T1 *, DeviceType> predicate, T2 value,
     // with zeros everywhere else.
     unsigned int const size = predicate.extent( 0 );
     using ExecutionSpace = typename DeviceType::execution_space;
-    Kokkos::View<unsigned int *, DeviceType> mask( "mask", size );
+    Kokkos::View<OffsetType *, DeviceType> mask( "mask", size );
     Kokkos::parallel_for( DTK_MARK_REGION( "compute_mask" ),
                           Kokkos::RangePolicy<ExecutionSpace>( 0, size ),
                           KOKKOS_LAMBDA( int const i ) {
@@ -127,15 +129,15 @@ void computeOffset( Kokkos::View<T1 *, DeviceType> predicate, T2 value,
     checkOffsetOverflow( offset );
 }
 
-template <typename DeviceType>
+template <typename DeviceType, typename OffsetType>
 void computeNodeOffset(
     Kokkos::View<DTK_CellTopology *, DeviceType> cell_topologies,
     Kokkos::View<unsigned int[DTK_N_TOPO], DeviceType> n_nodes_per_topo,
-    Kokkos::View<unsigned int *, DeviceType> node_offset )
+    Kokkos::View<OffsetType *, DeviceType> node_offset )
 {
     unsigned int const n_cells = cell_topologies.extent( 0 );
-    Kokkos::View<unsigned int *, DeviceType> nodes_per_cell( "nodes_per_cell",
-                                                             n_cells );
+    Kokkos::View<OffsetType *, DeviceType> nodes_per_cell( "nodes_per_cell",
+                                                           n_cells );
 
     using ExecutionSpace = typename DeviceType::execution_space;
     Kokkos::parallel_for( DTK_MARK_REGION( "fill_nodes_per_cell" ),
@@ -235,7 +237,8 @@ void convertMesh( Mesh<DeviceType> const &mesh,
         auto offset = mesh_offsets.offsets[topo_id];
 
         Kokkos::parallel_for(
-            DTK_MARK_REGION( "build_block_cells_" + std::to_string( topo_id ) ),
+            DTK_MARK_DYNAMIC_REGION( "build_block_cells_" +
+                                     std::to_string( topo_id ) ),
             Kokkos::RangePolicy<ExecutionSpace>( 0, n_cells ),
             KOKKOS_LAMBDA( int const i ) {
                 if ( mesh.cell_topologies( i ) == topo_id )
@@ -315,8 +318,8 @@ void createBoundingBoxes(
         auto offset = mesh_offsets.offsets[topo_id];
 
         Kokkos::parallel_for(
-            DTK_MARK_REGION( "build_bounding_boxes_" +
-                             std::to_string( topo_id ) ),
+            DTK_MARK_DYNAMIC_REGION( "build_bounding_boxes_" +
+                                     std::to_string( topo_id ) ),
             Kokkos::RangePolicy<ExecutionSpace>( 0, n_cells ),
             KOKKOS_LAMBDA( int const i ) {
                 if ( mesh.cell_topologies( i ) == topo_id )
@@ -332,8 +335,8 @@ void createBoundingBoxes(
 
         // Build map between BoundingBoxes and BlockCells
         Kokkos::parallel_for(
-            DTK_MARK_REGION( "build_bounding_boxes_to_block_cells_" +
-                             std::to_string( topo_id ) ),
+            DTK_MARK_DYNAMIC_REGION( "build_bounding_boxes_to_block_cells_" +
+                                     std::to_string( topo_id ) ),
             Kokkos::RangePolicy<ExecutionSpace>( 0, n_cells ),
             KOKKOS_LAMBDA( int const i ) {
                 if ( mesh.cell_topologies( i ) == topo_id )
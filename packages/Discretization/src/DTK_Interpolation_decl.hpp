@@ -178,12 +178,16 @@ Interpolation<DeviceType>::apply( Kokkos::View<Scalar **, DeviceType> X,
         "imported_query_ids", n_imports );
     Kokkos::View<Scalar **, DeviceType> imported_Y( "imported_Y", n_imports,
                                                     n_fields );
-    ArborX::Details::DistributedSearchTreeImpl<DeviceType>::sendAcrossNetwork(
-        space, _point_search._target_to_source_distributor, query_ids,
-        imported_query_ids );
-    ArborX::Details::DistributedSearchTreeImpl<DeviceType>::sendAcrossNetwork(
-        space, _point_search._target_to_source_distributor, Y_buffer,
-        imported_Y );
+    {
+        DTK_MARK_SCOPE( "send_across_network" );
+        auto const &distributor = _point_search._target_to_source_distributor;
+        ArborX::Details::DistributedSearchTreeImpl<
+            DeviceType>::sendAcrossNetwork( space, distributor, query_ids,
+                                            imported_query_ids );
+        ArborX::Details::DistributedSearchTreeImpl<
+            DeviceType>::sendAcrossNetwork( space, distributor, Y_buffer,
+                                            imported_Y );
+    }
 
     Kokkos::View<int *, DeviceType> found_query_ids( "found_query_ids",
                                                      Y.extent( 0 ) );
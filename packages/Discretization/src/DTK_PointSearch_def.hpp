@@ -91,6 +91,7 @@ void sendDataAcrossNetwork(
         &distributor,
     std::pair<ViewType, ViewType> data )
 {
+    DTK_MARK_SCOPE( "send_across_network" );
     ArborX::Details::DistributedSearchTreeImpl<typename ViewType::device_type>::
         sendAcrossNetwork( typename ViewType::execution_space{}, distributor,
                            data.first, data.second );
@@ -181,6 +182,7 @@ PointSearch<DeviceType>::PointSearch(
 {
     DTK_REQUIRE( points_coordinates.extent( 1 ) ==
                  mesh.nodes_coordinates.extent( 1 ) );
+    DTK_MARK_SCOPE( "point_search_setup" );
     _dim = points_coordinates.extent( 1 );
 
     // Compute the number of cells of each of the supported topologies.
@@ -212,8 +214,13 @@ PointSearch<DeviceType>::PointSearch(
 
     Kokkos::View<ArborX::Box *, DeviceType> bounding_boxes(
         "bounding_boxes", mesh.cell_topologies.extent( 0 ) );
-    Discretization::Helpers::createBoundingBoxes(
-        mesh, mesh_offsets, block_cells, bounding_boxes, bounding_box_to_cell );
+    {
+        DTK_MARK_SCOPE( "bounding_boxes" );
+        Discretization::Helpers::createBoundingBoxes( mesh, mesh_offsets,
+                                                      block_cells,
+                                                      bounding_boxes,
+                                                      bounding_box_to_cell );
+    }
 
     // Perform the distributed search. At the end of the distributed search the
     // points are moved from the "source processors" to the "target processors".
@@ -269,6 +276,8 @@ std::tuple<Kokkos::View<int *, DeviceType>, Kokkos::View<int *, DeviceType>,
            Kokkos::View<Coordinate *[3], DeviceType>,
            Kokkos::View<unsigned int *, DeviceType>>
 PointSearch<DeviceType>::getSearchResults() const {
+    DTK_MARK_SCOPE( "search_results" );
+
     // Flatten the results
     using ExecutionSpace = typename DeviceType::execution_space;
     unsigned int n_ref_pts = 0;
@@ -381,6 +390,7 @@ std::tuple<Kokkos::View<ArborX::Point *, DeviceType>,
         Kokkos::View<ArborX::Box *, DeviceType> bounding_boxes )
 {
     DTK_REQUIRE( points_coord.extent( 1 ) == 3 );
+    DTK_MARK_SCOPE( "perform_distributed_search" );
 
     ArborX::DistributedSearchTree<DeviceType> distributed_tree(
         _comm, bounding_boxes );
@@ -407,7 +417,10 @@ std::tuple<Kokkos::View<ArborX::Point *, DeviceType>,
     Kokkos::View<int *, DeviceType> indices( "indices", 0 );
     Kokkos::View<int *, DeviceType> offset( "offset", 0 );
     Kokkos::View<int *, DeviceType> ranks( "ranks", 0 );
-    distributed_tree.query( queries, indices, offset, ranks );
+    {
+        DTK_MARK_SCOPE( "distributed_search" );
+        distributed_tree.query( queries, indices, offset, ranks );
+    }
 
     // Move the points from the source processors to the target processors
     return internal::moveDataFromSourceToTarget( _comm, indices, offset, ranks,
@@ -547,6 +560,8 @@ Kokkos::View<int *, DeviceType> PointSearch<DeviceType>::performPointInCell(
     Kokkos::View<unsigned int *, DeviceType> topo, unsigned int topo_id,
     unsigned int size )
 {
+    DTK_MARK_DYNAMIC_SCOPE( "point_in_cell_" + std::to_string( topo_id ) );
+
     // Filter the data for a given topology
     Kokkos::View<Coordinate **, DeviceType> filtered_per_topo_points;
     Kokkos::View<int *, DeviceType> filtered_per_topo_cell_indices;
@@ -585,6 +600,8 @@ void PointSearch<DeviceType>::build_distributor(
     std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> const
         &filtered_ranks )
 {
+    DTK_MARK_SCOPE( "build_distributor" );
+
     // Flatten the filtered ranks to be used by the distributor
     std::vector<int> flatten_ranks;
     for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
@@ -11,6 +11,7 @@
 
 #include "DTK_C_API.hpp"
 #include "DTK_Core.hpp"
+#include "DTK_Profiling.hpp"
 
 #include "DTK_Version.hpp"
 
@@ -332,6 +333,50 @@ void DTK_finalize()
     DataTransferKit::finalize();
 }
 
+void DTK_enableProfiling( bool trace )
+{
+    errno = DTK_SUCCESS;
+    DataTransferKit::Profiling::enable( trace );
+}
+
+void DTK_disableProfiling()
+{
+    errno = DTK_SUCCESS;
+    DataTransferKit::Profiling::disable();
+}
+
+const char *DTK_getProfilingReport( MPI_Comm comm )
+{
+    errno = DTK_SUCCESS;
+    static std::string report;
+    report = DataTransferKit::Profiling::report( comm );
+    return report.c_str();
+}
+
+const char *DTK_getMemoryReport( MPI_Comm comm )
+{
+    errno = DTK_SUCCESS;
+    static std::string report;
+    int local_tracks = DataTransferKit::Profiling::tracksMemory() ? 1 : 0;
+    int tracks = 0;
+    MPI_Allreduce( &local_tracks, &tracks, 1, MPI_INT, MPI_MAX, comm );
+    report = tracks ? DataTransferKit::Profiling::memoryReport( comm ) : "";
+    return report.c_str();
+}
+
+void DTK_writeProfilingTrace( const char *filename )
+{
+    errno = DTK_SUCCESS;
+    try
+    {
+        DataTransferKit::Profiling::writeChromeTrace( filename );
+    }
+    catch ( ... )
+    {
+        errno = DTK_UNKNOWN;
+    }
+}
+
 void DTK_setUserFunction( DTK_UserApplicationHandle handle,
                           DTK_FunctionType type, void ( *f )(),
                           void *user_data )
@@ -440,6 +485,87 @@ void DTK_setUserFunction( DTK_UserApplicationHandle handle,
     }
 }
 
+void DTK_setNodeListBuffer( DTK_UserApplicationHandle handle,
+                            Coordinate *coordinates, size_t local_num_nodes,
+                            unsigned space_dim, size_t entity_stride,
+                            size_t component_stride )
+{
+    errno = DTK_SUCCESS;
+
+    if ( !DTK_isValidUserApplication( handle ) )
+    {
+        errno = DTK_INVALID_HANDLE;
+        return;
+    }
+
+    try
+    {
+        auto dtk = reinterpret_cast<DataTransferKit::DTK_Registry *>( handle );
+        dtk->_registry->setNodeListBuffer( coordinates, local_num_nodes,
+                                           space_dim, entity_stride,
+                                           component_stride );
+    }
+    catch ( ... )
+    {
+        errno = DTK_UNKNOWN;
+    }
+}
+
+void DTK_setCellListBuffers( DTK_UserApplicationHandle handle,
+                             Coordinate *coordinates, size_t local_num_nodes,
+                             unsigned space_dim, LocalOrdinal *cells,
+                             size_t total_cell_nodes,
+                             DTK_CellTopology *cell_topologies,
+                             size_t local_num_cells, size_t entity_stride,
+                             size_t component_stride )
+{
+    errno = DTK_SUCCESS;
+
+    if ( !DTK_isValidUserApplication( handle ) )
+    {
+        errno = DTK_INVALID_HANDLE;
+        return;
+    }
+
+    try
+    {
+        auto dtk = reinterpret_cast<DataTransferKit::DTK_Registry *>( handle );
+        dtk->_registry->setCellListBuffers(
+            coordinates, local_num_nodes, space_dim, cells, total_cell_nodes,
+            cell_topologies, local_num_cells, entity_stride, component_stride );
+    }
+    catch ( ... )
+    {
+        errno = DTK_UNKNOWN;
+    }
+}
+
+void DTK_setFieldBuffer( DTK_UserApplicationHandle handle,
+                         const char *field_name, double *dofs,
+                         size_t local_num_dofs, unsigned field_dimension,
+                         size_t entity_stride, size_t component_stride )
+{
+    errno = DTK_SUCCESS;
+
+    if ( !DTK_isValidUserApplication( handle ) )
+    {
+        errno = DTK_INVALID_HANDLE;
+        return;
+    }
+
+    try
+    {
+        auto dtk = reinterpret_cast<DataTransferKit::DTK_Registry *>( handle );
+        dtk->_registry->setFieldBuffer( field_name, dofs, local_num_dofs,
+                                        field_dimension, entity_stride,
+                                        component_stride );
+    }
+    catch ( ... )
+    {
+        errno = DTK_UNKNOWN;
+    }
+}
+
 const char *DTK_error( int err )
 {
     errno = DTK_SUCCESS;
@@ -92,6 +92,59 @@ extern void DTK_finalize();
 
 /**@}*/
 
+/**
+ * \defgroup c_interface_profiling Profiling
+ * @{
+ */
+
+/** \brief Start timing the parallel kernels and communication steps of DTK.
+ *
+ *  Profiling may also be enabled by setting the environment variable
+ *  DTK_PROFILING, and tracing by setting it to "trace".
+ *
+ *  \param trace Whether to also record every region for
+ *  DTK_writeProfilingTrace().
+ */
+extern void DTK_enableProfiling( bool trace );
+
+/** \brief Stop timing. The timings collected so far are kept.
+ */
+extern void DTK_disableProfiling();
+
+/** \brief Get the time spent in every region of DTK.
+ *
+ *  The report lists the number of calls and the minimum, average and
+ *  maximum time over the ranks of \p comm. This function is collective over
+ *  \p comm.
+ *
+ *  \param comm The MPI communicator over which to aggregate the timings.
+ *  \return Returns the report, valid until the next call.
+ */
+extern const char *DTK_getProfilingReport( MPI_Comm comm );
+
+/** \brief Get the peak memory of every region of DTK.
+ *
+ *  The report lists the largest number of bytes held by the Kokkos
+ *  allocations while each region was open, and the largest growth during
+ *  the region, over the ranks of \p comm. It is empty when memory is not
+ *  tracked. Memory is tracked with Kokkos 3.2 or later when no Kokkos Tools
+ *  library is loaded. With older versions of Kokkos, a Kokkos Tools library
+ *  must forward the allocations to the profiler.
+ *  This function is collective over \p comm.
+ *
+ *  \param comm The MPI communicator over which to aggregate the peaks.
+ *  \return Returns the report, valid until the next call.
+ */
+extern const char *DTK_getMemoryReport( MPI_Comm comm );
+
+/** \brief Write the regions recorded on this rank as a Chrome trace.
+ *
+ *  \param filename Name of the JSON file, e.g. one per rank.
+ */
+extern void DTK_writeProfilingTrace( const char *filename );
+
+/**@}*/
+
 /**
  * \defgroup c_error_handling Error Handling
  * @{
@@ -292,6 +345,28 @@ typedef struct _DTK_MapHandle *DTK_MapHandle;
  *                        "\"OptionBarDouble\": 1.32 }";
  *  \endcode
  *
+ *  Set the option "Share Source Index" to true to share the search tree
+ *  built over the source nodes between the maps created with this option
+ *  from the same source application, on the same communicator and in the
+ *  same execution space, for as long as one of them exists. The coordinates
+ *  are not compared: an application whose nodes moved must register its
+ *  node list function or buffer again, after which the maps build a new
+ *  tree. By default every map builds its own tree.
+ *
+ *  Set the options "Coordinates Compression" and "Values Compression" to
+ *  "Lossless" or "Float32" to encode the coordinates exchanged on creation
+ *  and the values exchanged on every transfer, with "Float32 Tolerance" the
+ *  largest error accepted by "Float32". The payloads are encoded on the host,
+ *  so maps executing on a device raise an error on creation when either
+ *  option is set. By default the payloads are sent as they are.
+ *
+ *  Set the option "Surface Only" to true to couple the applications through
+ *  their boundaries only. The map then searches and transfers between the
+ *  nodes of the boundary faces given by the DTK_BOUNDARY_SIZE_FUNCTION and
+ *  DTK_BOUNDARY_DATA_FUNCTION callbacks over the cells of the cell list. The
+ *  fields are defined on the nodes of the cell lists and the target values
+ *  away from the boundary are left unchanged.
+ *
  *  \param[in] space Execution space where the map will execute. Operations on
  *  user data for transfer operations will occur in this execution space. If
  *  the source or target applications reside in memory spaces that are not
@@ -344,6 +419,42 @@ extern DTK_MapHandle DTK_createMap( DTK_ExecutionSpace space, MPI_Comm comm,
                                     DTK_UserApplicationHandle target,
                                     const char *options );
 
+/** \brief Create a DTK handle to a group of maps from one source to several
+ *  targets.
+ *
+ *  The group behaves like num_targets maps created with DTK_createMap() from
+ *  the same source, with the same options. When the group is applied with
+ *  DTK_applyMapGroup(), the source field is pulled once and the source values
+ *  needed by any of the targets are exchanged in a single round, each value
+ *  being sent at most once to a given rank, before the values of each target
+ *  are computed and pushed.
+ *
+ *  \param[in] space Execution space where the maps will execute.
+ *
+ *  \param[in] comm The MPI communicator over which to build the maps.
+ *
+ *  \param[in] source Handle to the source application.
+ *
+ *  \param[in] num_targets Number of target applications.
+ *
+ *  \param[in,out] targets Array of num_targets handles to the target
+ *  applications. All of them must be in the same memory space.
+ *
+ *  \param[in] options Options string for building the maps. See
+ *  DTK_createMap() for details.
+ *
+ *  \return DTK_createMapGroup returns a map handle. This handle must be
+ *  destroyed with DTK_destroyMap() when the lifetime of the group has ended
+ *  in the program. DTK_applyMap() transfers the source field to the field of
+ *  the same name on every target.
+ */
+extern DTK_MapHandle DTK_createMapGroup( DTK_ExecutionSpace space,
+                                         MPI_Comm comm,
+                                         DTK_UserApplicationHandle source,
+                                         int num_targets,
+                                         DTK_UserApplicationHandle *targets,
+                                         const char *options );
+
 /** \brief Indicates whether a DTK handle to a map is valid.
  *
  *  A handle is valid if it was created by DTK_create() and has not yet been
@@ -386,6 +497,100 @@ extern bool DTK_isValidMap( DTK_MapHandle handle );
 extern void DTK_applyMap( DTK_MapHandle handle, const char *source_field,
                           const char *target_field );
 
+/** \brief Apply the DTK map to several pairs of fields at once.
+ *
+ *  This function is equivalent to calling DTK_applyMap() on each pair of
+ *  fields but all the fields are pulled first, packed together and
+ *  transferred with a single exchange before being pushed to the target.
+ *  The cost of the communication therefore does not grow with the number of
+ *  fields beyond the volume of data.
+ *
+ *  \note This function call is a collective over the map's communicator.
+ *
+ *  \param[in] handle Map handle. This handle must be valid on all calling MPI
+ *  ranks.
+ *
+ *  \param[in] num_fields Number of pairs of fields to transfer.
+ *
+ *  \param[in] source_fields Array of num_fields names of fields in the source
+ *  user application. DTK will read data from these fields.
+ *
+ *  \param[in] target_fields Array of num_fields names of fields in the target
+ *  user application. DTK will write the data transferred from
+ *  source_fields[i] to target_fields[i].
+ */
+extern void DTK_applyMapBatch( DTK_MapHandle handle, int num_fields,
+                               const char **source_fields,
+                               const char **target_fields );
+
+/** \brief Apply a group of maps to one source field.
+ *
+ *  \note This function call is a collective over the map's communicator.
+ *
+ *  \param[in] handle Map handle created with DTK_createMapGroup(). This
+ *  handle must be valid on all calling MPI ranks.
+ *
+ *  \param[in] source_field Name of the field in the source user application.
+ *  DTK will read data from this field once.
+ *
+ *  \param[in] target_fields Array of names of fields, one for each target
+ *  user application in the order given to DTK_createMapGroup(). DTK will
+ *  write the data transferred to the k-th target to target_fields[k].
+ */
+extern void DTK_applyMapGroup( DTK_MapHandle handle, const char *source_field,
+                               const char **target_fields );
+
+/** \brief Number of bins of the stencil size histogram of a map.
+ */
+#define DTK_STENCIL_SIZE_BINS 32
+
+/** \brief Cost of a map on the calling rank.
+ *
+ *  The communication volumes are those of a single-component field
+ *  transferred by DTK_applyMap(), before any payload compression.
+ */
+typedef struct
+{
+    /** Number of target nodes whose value is computed from s source values,
+     *  for s < DTK_STENCIL_SIZE_BINS - 1. The last bin counts the larger
+     *  stencils. */
+    int stencil_sizes[DTK_STENCIL_SIZE_BINS];
+    /** Stencil entries whose source value lives on this rank. */
+    int local_entries;
+    /** Stencil entries whose source value lives on another rank. */
+    int remote_entries;
+    /** Bytes sent to other ranks. */
+    long long bytes_sent;
+    /** Bytes received from other ranks. */
+    long long bytes_received;
+    /** Number of ranks this rank sends to. */
+    int send_neighbors;
+    /** Number of ranks this rank receives from. */
+    int recv_neighbors;
+    /** Number of target nodes on this rank. */
+    int num_targets;
+    /** Maximum over average number of target nodes across the ranks. */
+    double target_imbalance;
+    /** Number of rank-deficient moment matrices (moving least squares). */
+    int num_underdetermined;
+} DTK_MapStatistics;
+
+/** \brief Get the stencil sizes, communication volume and load balance of
+ *  a map.
+ *
+ *  They are computed when requested and cost nothing otherwise. For a group
+ *  of maps, the stencils and targets are summed over the maps of the group
+ *  and the communication is that of the source exchange they share.
+ *
+ *  \note This function call is a collective over the map's communicator.
+ *
+ *  \param[in] handle Map handle created with DTK_createMap().
+ *
+ *  \param[out] statistics Statistics of the map on the calling rank.
+ */
+extern void DTK_getMapStatistics( DTK_MapHandle handle,
+                                  DTK_MapStatistics *statistics );
+
 /** \brief Destroy a DTK handle to a map.
  *
  *  \param[in,out] handle map handle. If this handle has already been
@@ -478,6 +683,113 @@ extern void DTK_setUserFunction( DTK_UserApplicationHandle handle,
 
 /**@}*/
 
+/**
+ * \defgroup c_buffer_registration User application buffer registration.
+ *
+ * As an alternative to the size and data callbacks, arrays that already hold
+ * the node list, the cell list, or a field can be handed to DTK directly. DTK
+ * then reads (and for fields, writes) the application memory in place
+ * instead of allocating its own arrays and asking the application to fill
+ * them. A registered buffer takes precedence over the callbacks for the same
+ * data.
+ *
+ * Entry (i, d) of a buffer (entity i, component d) is located at
+ * <code>data[i * entity_stride + d * component_stride]</code>. Passing zero
+ * for both strides selects the layout used by the callbacks where values are
+ * blocked by dimension. Interleaved arrays (x0, y0, z0, x1, ...) use
+ * <code>entity_stride = dim</code> and <code>component_stride = 1</code>;
+ * such arrays are copied once when DTK accesses them since they cannot be
+ * aliased.
+ *
+ * Lifetime contract: the memory must reside in the memory space of the user
+ * application handle and must stay allocated, with the registered size, until
+ * it is registered again or the handle is destroyed. The application is
+ * responsible for keeping the contents up to date before each map creation or
+ * application.
+ * @{
+ */
+
+/** \brief Register the coordinates of the node list.
+ *
+ *  \param[in,out] handle User application handle.
+ *
+ *  \param[in] coordinates Pointer to the node coordinates.
+ *
+ *  \param[in] local_num_nodes Number of nodes.
+ *
+ *  \param[in] space_dim Spatial dimension of the node coordinates.
+ *
+ *  \param[in] entity_stride Distance between two consecutive nodes, or zero.
+ *
+ *  \param[in] component_stride Distance between two consecutive
+ *  coordinates of the same node, or zero.
+ */
+extern void DTK_setNodeListBuffer( DTK_UserApplicationHandle handle,
+                                   Coordinate *coordinates,
+                                   size_t local_num_nodes, unsigned space_dim,
+                                   size_t entity_stride,
+                                   size_t component_stride );
+
+/** \brief Register the arrays describing the cell list.
+ *
+ *  \param[in,out] handle User application handle.
+ *
+ *  \param[in] coordinates Pointer to the node coordinates.
+ *
+ *  \param[in] local_num_nodes Number of nodes.
+ *
+ *  \param[in] space_dim Spatial dimension of the node coordinates.
+ *
+ *  \param[in] cells Connectivity of the cells, see DTK_CellListDataFunction().
+ *
+ *  \param[in] total_cell_nodes Length of the \p cells array.
+ *
+ *  \param[in] cell_topologies Topology of each cell.
+ *
+ *  \param[in] local_num_cells Number of cells.
+ *
+ *  \param[in] entity_stride Distance between two consecutive nodes, or zero.
+ *
+ *  \param[in] component_stride Distance between two consecutive
+ *  coordinates of the same node, or zero.
+ */
+extern void
+DTK_setCellListBuffers( DTK_UserApplicationHandle handle,
+                        Coordinate *coordinates, size_t local_num_nodes,
+                        unsigned space_dim, LocalOrdinal *cells,
+                        size_t total_cell_nodes,
+                        DTK_CellTopology *cell_topologies,
+                        size_t local_num_cells, size_t entity_stride,
+                        size_t component_stride );
+
+/** \brief Register the degrees of freedom of a field.
+ *
+ *  DTK reads from this buffer when the field is pulled from the source and
+ *  writes into it when the field is pushed to the target.
+ *
+ *  \param[in,out] handle User application handle.
+ *
+ *  \param[in] field_name Name of the field.
+ *
+ *  \param[in,out] dofs Pointer to the degrees of freedom.
+ *
+ *  \param[in] local_num_dofs Number of degrees of freedom.
+ *
+ *  \param[in] field_dimension Dimension of the field.
+ *
+ *  \param[in] entity_stride Distance between two consecutive degrees of
+ *  freedom, or zero.
+ *
+ *  \param[in] component_stride Distance between two consecutive components
+ *  of the same degree of freedom, or zero.
+ */
+extern void DTK_setFieldBuffer( DTK_UserApplicationHandle handle,
+                                const char *field_name, double *dofs,
+                                size_t local_num_dofs, unsigned field_dimension,
+                                size_t entity_stride, size_t component_stride );
+
+/**@}*/
+
 /**
  * \defgroup c_function_prototypes User application data interface function
  * prototypes.
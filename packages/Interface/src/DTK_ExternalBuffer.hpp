@@ -0,0 +1,103 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+/*!
+ * \file DTK_ExternalBuffer.hpp
+ * \brief Description of application-owned arrays registered with DTK.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef DTK_EXTERNALBUFFER_HPP
+#define DTK_EXTERNALBUFFER_HPP
+
+#include <Kokkos_Core.hpp>
+
+#include <cstddef>
+#include <memory>
+
+namespace DataTransferKit
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \class ExternalBuffer
+ *
+ * \brief Raw pointer, extents, and strides of a rank-2 array owned by the
+ * user application.
+ *
+ * Entry (i, d) of the array (entity i, component d) lives at
+ * data[i * entity_stride + d * component_stride]. The default strides
+ * describe the DTK layout where values are blocked by dimension, i.e. a
+ * Kokkos::LayoutLeft view of extents (extent_0, extent_1). Interleaved
+ * (array-of-structs) data is described with entity_stride = extent_1 and
+ * component_stride = 1.
+ *
+ * Lifetime contract: the memory must be accessible from the memory space of
+ * the user application, must not be freed or resized while it is registered,
+ * and its contents must be up to date whenever DTK pulls data. DTK holds a
+ * copy of the optional owner pointer until the buffer is replaced or the
+ * registry is destroyed, which can be used to tie the lifetime of the array
+ * to the registry.
+ */
+template <class T>
+struct ExternalBuffer
+{
+    //! Whether a buffer was registered at all. An empty buffer (e.g. on a
+    //! rank that holds no data) may have a null pointer.
+    bool registered = false;
+
+    //! Pointer to the first entry.
+    T *data = nullptr;
+
+    //! Number of entities (nodes, cells, dofs).
+    std::size_t extent_0 = 0;
+
+    //! Number of components per entity (space or field dimension).
+    std::size_t extent_1 = 1;
+
+    //! Distance, in elements, between two consecutive entities.
+    std::size_t entity_stride = 1;
+
+    //! Distance, in elements, between two consecutive components.
+    std::size_t component_stride = 0;
+
+    //! Optional handle keeping the memory alive.
+    std::shared_ptr<void> owner;
+
+    //! Whether the buffer can be aliased by a LayoutLeft view without copy.
+    bool isLayoutLeft() const
+    {
+        return entity_stride == 1 &&
+               ( extent_1 <= 1 || component_stride == extent_0 );
+    }
+
+    //! Unmanaged view of the buffer with its actual strides.
+    template <class MemorySpace>
+    Kokkos::View<T **, Kokkos::LayoutStride, MemorySpace,
+                 Kokkos::MemoryUnmanaged>
+    stridedView() const
+    {
+        return Kokkos::View<T **, Kokkos::LayoutStride, MemorySpace,
+                            Kokkos::MemoryUnmanaged>(
+            data, Kokkos::LayoutStride( extent_0, entity_stride, extent_1,
+                                        component_stride ) );
+    }
+};
+
+//---------------------------------------------------------------------------//
+
+} // namespace DataTransferKit
+
+//---------------------------------------------------------------------------//
+
+#endif // end DTK_EXTERNALBUFFER_HPP
+
+//---------------------------------------------------------------------------//
+// end DTK_ExternalBuffer.hpp
+//---------------------------------------------------------------------------//
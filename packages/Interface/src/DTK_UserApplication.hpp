@@ -30,6 +30,7 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <vector>
@@ -70,6 +71,13 @@ class UserApplication
     //! Get a node list from the application.
     NodeList<Kokkos::LayoutLeft, MemorySpace> getNodeList();
 
+    //! Number identifying the node list registered by the application. It
+    //! changes every time a node list function or buffer is registered.
+    std::size_t getNodeListGeneration() const
+    {
+        return _user_functions->_node_list_generation;
+    }
+
     //! Get a bounding volume list from the application.
     BoundingVolumeList<Kokkos::LayoutLeft, MemorySpace> getBoundingVolumeList();
 
@@ -91,6 +99,11 @@ class UserApplication
     DOFMap<Kokkos::LayoutLeft, MemorySpace>
     getDOFMap( std::string &discretization_type );
 
+    //! Get the dimension and local number of dofs of a field with a given
+    //! name without allocating it.
+    void getFieldSize( const std::string &field_name, unsigned &field_dim,
+                       size_t &local_num_dofs );
+
     //! Get a field with a given name from the application.
     Field<Scalar, Kokkos::LayoutLeft, MemorySpace>
     getField( const std::string &field_name );
@@ -110,6 +123,13 @@ class UserApplication
         const EvaluationSet<Kokkos::LayoutLeft, MemorySpace> eval_set,
         Field<Scalar, Kokkos::LayoutLeft, MemorySpace> field );
 
+  private:
+    // Alias an external buffer with a LayoutLeft view. The data is copied
+    // only if the strides of the buffer cannot be represented that way.
+    template <class T>
+    static Kokkos::View<T **, Kokkos::LayoutLeft, MemorySpace>
+    wrapExternalBuffer( const ExternalBuffer<T> &buffer );
+
   private:
     // User function registry for this application.
     std::shared_ptr<UserFunctionRegistry<Scalar>> _user_functions;
@@ -37,6 +37,15 @@ template <class Scalar, class ParallelModel>
 auto UserApplication<Scalar, ParallelModel>::getNodeList()
     -> NodeList<Kokkos::LayoutLeft, MemorySpace>
 {
+    // Alias the application memory if it was registered.
+    const auto &buffer = _user_functions->_node_list_buffer;
+    if ( buffer.registered )
+    {
+        NodeList<Kokkos::LayoutLeft, MemorySpace> node_list;
+        node_list.coordinates = wrapExternalBuffer( buffer );
+        return node_list;
+    }
+
     // Get the size of the node list.
     unsigned space_dim;
     size_t local_num_nodes;
@@ -120,6 +129,23 @@ template <class Scalar, class ParallelModel>
 auto UserApplication<Scalar, ParallelModel>::getCellList()
     -> CellList<Kokkos::LayoutLeft, MemorySpace>
 {
+    // Alias the application memory if it was registered.
+    if ( _user_functions->_cell_list_coordinates_buffer.registered )
+    {
+        const auto &cells = _user_functions->_cell_list_cells_buffer;
+        const auto &topologies = _user_functions->_cell_list_topologies_buffer;
+        CellList<Kokkos::LayoutLeft, MemorySpace> cell_list;
+        cell_list.coordinates = wrapExternalBuffer(
+            _user_functions->_cell_list_coordinates_buffer );
+        cell_list.cells =
+            Kokkos::View<LocalOrdinal *, Kokkos::LayoutLeft, MemorySpace>(
+                cells.data, cells.extent_0 );
+        cell_list.cell_topologies =
+            Kokkos::View<DTK_CellTopology *, Kokkos::LayoutLeft, MemorySpace>(
+                topologies.data, topologies.extent_0 );
+        return cell_list;
+    }
+
     // Get the size of the cell list.
     unsigned space_dim;
     size_t local_num_nodes;
@@ -251,6 +277,24 @@ auto UserApplication<Scalar, ParallelModel>::getDOFMap(
     return dof_map;
 }
 
+//---------------------------------------------------------------------------//
+// Get the size of a field with a given name.
+template <class Scalar, class ParallelModel>
+void UserApplication<Scalar, ParallelModel>::getFieldSize(
+    const std::string &field_name, unsigned &field_dim, size_t &local_num_dofs )
+{
+    auto buffer = _user_functions->_field_buffers.find( field_name );
+    if ( buffer != _user_functions->_field_buffers.end() )
+    {
+        field_dim = buffer->second.extent_1;
+        local_num_dofs = buffer->second.extent_0;
+        return;
+    }
+
+    callUserFunction( _user_functions->_field_size_func, field_name, field_dim,
+                      local_num_dofs );
+}
+
 //---------------------------------------------------------------------------//
 // Get a field with a given name from the application.
 template <class Scalar, class ParallelModel>
@@ -258,12 +302,19 @@ auto UserApplication<Scalar, ParallelModel>::getField(
     const std::string &field_name )
     -> Field<Scalar, Kokkos::LayoutLeft, MemorySpace>
 {
+    // Alias the application memory if it was registered.
+    auto buffer = _user_functions->_field_buffers.find( field_name );
+    if ( buffer != _user_functions->_field_buffers.end() )
+    {
+        Field<Scalar, Kokkos::LayoutLeft, MemorySpace> field;
+        field.dofs = wrapExternalBuffer( buffer->second );
+        return field;
+    }
+
     // Get the size of the field.
     unsigned field_dim;
     size_t local_num_dofs;
-
-    callUserFunction( _user_functions->_field_size_func, field_name, field_dim,
-                      local_num_dofs );
+    getFieldSize( field_name, field_dim, local_num_dofs );
 
     // Allocate the field.
     auto field = InputAllocators<Kokkos::LayoutLeft, MemorySpace>::
@@ -279,6 +330,17 @@ void UserApplication<Scalar, ParallelModel>::pullField(
     const std::string &field_name,
     Field<Scalar, Kokkos::LayoutLeft, MemorySpace> field )
 {
+    // Read the registered buffer unless the field already aliases it.
+    auto buffer = _user_functions->_field_buffers.find( field_name );
+    if ( buffer != _user_functions->_field_buffers.end() )
+    {
+        const auto &external = buffer->second;
+        if ( field.dofs.data() != external.data )
+            Kokkos::deep_copy( field.dofs,
+                               external.template stridedView<MemorySpace>() );
+        return;
+    }
+
     // Get the field from the user.
     View<Scalar> field_dofs( field.dofs );
     callUserFunction( _user_functions->_pull_field_func, field_name,
@@ -292,6 +354,17 @@ void UserApplication<Scalar, ParallelModel>::pushField(
     const std::string &field_name,
     const Field<Scalar, Kokkos::LayoutLeft, MemorySpace> field )
 {
+    // Write the registered buffer unless the field already aliases it.
+    auto buffer = _user_functions->_field_buffers.find( field_name );
+    if ( buffer != _user_functions->_field_buffers.end() )
+    {
+        const auto &external = buffer->second;
+        if ( field.dofs.data() != external.data )
+            Kokkos::deep_copy( external.template stridedView<MemorySpace>(),
+                               field.dofs );
+        return;
+    }
+
     // Give the field to the user.
     View<Scalar> field_dofs( field.dofs );
     callUserFunction( _user_functions->_push_field_func, field_name,
@@ -314,6 +387,24 @@ void UserApplication<Scalar, ParallelModel>::evaluateField(
                       evaluation_points, object_ids, values );
 }
 
+//---------------------------------------------------------------------------//
+// Alias an external buffer with a LayoutLeft view.
+template <class Scalar, class ParallelModel>
+template <class T>
+auto UserApplication<Scalar, ParallelModel>::wrapExternalBuffer(
+    const ExternalBuffer<T> &buffer )
+    -> Kokkos::View<T **, Kokkos::LayoutLeft, MemorySpace>
+{
+    if ( buffer.isLayoutLeft() )
+        return Kokkos::View<T **, Kokkos::LayoutLeft, MemorySpace>(
+            buffer.data, buffer.extent_0, buffer.extent_1 );
+
+    Kokkos::View<T **, Kokkos::LayoutLeft, MemorySpace> view(
+        "external_buffer", buffer.extent_0, buffer.extent_1 );
+    Kokkos::deep_copy( view, buffer.template stridedView<MemorySpace>() );
+    return view;
+}
+
 //---------------------------------------------------------------------------//
 
 } // namespace DataTransferKit
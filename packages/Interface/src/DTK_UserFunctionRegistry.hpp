@@ -18,9 +18,11 @@
 #define DTK_USERFUNCTIONREGISTRY_HPP
 
 #include "DTK_DBC.hpp"
+#include "DTK_ExternalBuffer.hpp"
 #include "DTK_UserDataInterface.hpp"
 #include "DTK_View.hpp"
 
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <string>
@@ -169,7 +171,51 @@ class UserFunctionRegistry
                                    std::shared_ptr<void> user_data = nullptr );
     //@}
 
+    //! @name Register External Buffers
+    //! A registered buffer takes precedence over the size and data functions
+    //! of the corresponding list or field. DTK wraps the application memory
+    //! in an unmanaged view instead of allocating a new one and asking the
+    //! application to fill it. A copy is only made when the strides cannot
+    //! be represented by the Kokkos::LayoutLeft views of the DTK input data
+    //! structures. Strides equal to zero select the default layout where
+    //! values are blocked by dimension. See ExternalBuffer for the lifetime
+    //! contract.
+    //@{
+
+    //! Node list coordinates.
+    void setNodeListBuffer( Coordinate *coordinates, size_t local_num_nodes,
+                            unsigned space_dim, size_t entity_stride = 0,
+                            size_t component_stride = 0,
+                            std::shared_ptr<void> owner = nullptr );
+
+    //! Cell list coordinates, connectivity, and topologies.
+    void setCellListBuffers( Coordinate *coordinates, size_t local_num_nodes,
+                             unsigned space_dim, LocalOrdinal *cells,
+                             size_t total_cell_nodes,
+                             DTK_CellTopology *cell_topologies,
+                             size_t local_num_cells, size_t entity_stride = 0,
+                             size_t component_stride = 0,
+                             std::shared_ptr<void> owner = nullptr );
+
+    //! Field degrees of freedom. DTK reads from this buffer when the field is
+    //! pulled and writes into it when the field is pushed.
+    void setFieldBuffer( const std::string &field_name, Scalar *dofs,
+                         size_t local_num_dofs, unsigned field_dim,
+                         size_t entity_stride = 0, size_t component_stride = 0,
+                         std::shared_ptr<void> owner = nullptr );
+    //@}
+
   private:
+    // Give the node list a new generation number.
+    void nodeListChanged();
+
+    // Fill in the description of an external buffer.
+    template <class T>
+    static ExternalBuffer<T>
+    makeExternalBuffer( T *data, size_t extent_0, size_t extent_1,
+                        size_t entity_stride, size_t component_stride,
+                        const std::shared_ptr<void> &owner );
+
     //@{
     //! User Geometry functions.
 
@@ -241,6 +287,29 @@ class UserFunctionRegistry
     //! Field evaluate data function.
     UserImpl<EvaluateFieldFunction<Scalar>> _eval_field_func;
     //@}
+
+    //@{
+    //! External buffers.
+
+    //! Node list coordinates.
+    ExternalBuffer<Coordinate> _node_list_buffer;
+
+    //! Cell list coordinates.
+    ExternalBuffer<Coordinate> _cell_list_coordinates_buffer;
+
+    //! Cell list connectivity.
+    ExternalBuffer<LocalOrdinal> _cell_list_cells_buffer;
+
+    //! Cell list topologies.
+    ExternalBuffer<DTK_CellTopology> _cell_list_topologies_buffer;
+
+    //! Field degrees of freedom indexed by field name.
+    std::unordered_map<std::string, ExternalBuffer<Scalar>> _field_buffers;
+    //@}
+
+    //! Number of the node list currently registered, unique over all the
+    //! registries. Zero if no node list was registered.
+    std::size_t _node_list_generation = 0;
 };
 
 //---------------------------------------------------------------------------//
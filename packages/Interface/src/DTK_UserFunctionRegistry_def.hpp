@@ -26,6 +26,7 @@ void UserFunctionRegistry<Scalar>::setNodeListSizeFunction(
     NodeListSizeFunction &&func, std::shared_ptr<void> user_data )
 {
     _node_list_size_func = std::make_pair( func, user_data );
+    nodeListChanged();
 }
 
 //---------------------------------------------------------------------------//
@@ -35,6 +36,7 @@ void UserFunctionRegistry<Scalar>::setNodeListDataFunction(
     NodeListDataFunction &&func, std::shared_ptr<void> user_data )
 {
     _node_list_data_func = std::make_pair( func, user_data );
+    nodeListChanged();
 }
 
 //---------------------------------------------------------------------------//
@@ -199,6 +201,89 @@ void UserFunctionRegistry<Scalar>::setEvaluateFieldFunction(
     _eval_field_func = std::make_pair( func, user_data );
 }
 
+//---------------------------------------------------------------------------//
+// Node list coordinates.
+template <class Scalar>
+void UserFunctionRegistry<Scalar>::setNodeListBuffer(
+    Coordinate *coordinates, size_t local_num_nodes, unsigned space_dim,
+    size_t entity_stride, size_t component_stride,
+    std::shared_ptr<void> owner )
+{
+    _node_list_buffer =
+        makeExternalBuffer( coordinates, local_num_nodes, space_dim,
+                            entity_stride, component_stride, owner );
+    nodeListChanged();
+}
+
+//---------------------------------------------------------------------------//
+// New generation of the node list.
+template <class Scalar>
+void UserFunctionRegistry<Scalar>::nodeListChanged()
+{
+    static std::size_t last_generation = 0;
+    _node_list_generation = ++last_generation;
+}
+
+//---------------------------------------------------------------------------//
+// Cell list coordinates, connectivity, and topologies.
+template <class Scalar>
+void UserFunctionRegistry<Scalar>::setCellListBuffers(
+    Coordinate *coordinates, size_t local_num_nodes, unsigned space_dim,
+    LocalOrdinal *cells, size_t total_cell_nodes,
+    DTK_CellTopology *cell_topologies, size_t local_num_cells,
+    size_t entity_stride, size_t component_stride,
+    std::shared_ptr<void> owner )
+{
+    _cell_list_coordinates_buffer =
+        makeExternalBuffer( coordinates, local_num_nodes, space_dim,
+                            entity_stride, component_stride, owner );
+    _cell_list_cells_buffer =
+        makeExternalBuffer( cells, total_cell_nodes, 1, 1, 0, owner );
+    _cell_list_topologies_buffer =
+        makeExternalBuffer( cell_topologies, local_num_cells, 1, 1, 0, owner );
+}
+
+//---------------------------------------------------------------------------//
+// Field degrees of freedom.
+template <class Scalar>
+void UserFunctionRegistry<Scalar>::setFieldBuffer(
+    const std::string &field_name, Scalar *dofs, size_t local_num_dofs,
+    unsigned field_dim, size_t entity_stride, size_t component_stride,
+    std::shared_ptr<void> owner )
+{
+    _field_buffers[field_name] =
+        makeExternalBuffer( dofs, local_num_dofs, field_dim, entity_stride,
+                            component_stride, owner );
+}
+
+//---------------------------------------------------------------------------//
+// Fill in the description of an external buffer.
+template <class Scalar>
+template <class T>
+ExternalBuffer<T> UserFunctionRegistry<Scalar>::makeExternalBuffer(
+    T *data, size_t extent_0, size_t extent_1, size_t entity_stride,
+    size_t component_stride, const std::shared_ptr<void> &owner )
+{
+    DTK_REQUIRE( data != nullptr || extent_0 * extent_1 == 0 );
+
+    ExternalBuffer<T> buffer;
+    buffer.registered = true;
+    buffer.data = data;
+    buffer.extent_0 = extent_0;
+    buffer.extent_1 = extent_1;
+    buffer.entity_stride = ( entity_stride > 0 ) ? entity_stride : 1;
+    buffer.component_stride =
+        ( component_stride > 0 ) ? component_stride : extent_0;
+    buffer.owner = owner;
+
+    // Distinct entries must not overlap.
+    DTK_REQUIRE( extent_1 <= 1 ||
+                 buffer.component_stride >= extent_0 * buffer.entity_stride ||
+                 buffer.entity_stride >= extent_1 * buffer.component_stride );
+
+    return buffer;
+}
+
 //---------------------------------------------------------------------------//
 
 } // namespace DataTransferKit
@@ -29,16 +29,29 @@
 %rename DTK_destroyUserApplication DTK_destroy_user_application;
 
 %rename DTK_createMap DTK_create_map;
+%rename DTK_createMapGroup DTK_create_map_group;
 %rename DTK_isValidMap DTK_is_valid_map;
 %rename DTK_applyMap DTK_apply_map;
+%rename DTK_applyMapBatch DTK_apply_map_batch;
+%rename DTK_applyMapGroup DTK_apply_map_group;
+%rename DTK_getMapStatistics DTK_get_map_statistics;
 %rename DTK_destroyMap DTK_destroy_map;
 
+%rename DTK_enableProfiling DTK_enable_profiling;
+%rename DTK_disableProfiling DTK_disable_profiling;
+%rename DTK_writeProfilingTrace DTK_write_profiling_trace;
+
 %rename DTK_setUserFunction DTK_set_user_function;
+%rename DTK_setNodeListBuffer DTK_set_node_list_buffer;
+%rename DTK_setCellListBuffers DTK_set_cell_list_buffers;
+%rename DTK_setFieldBuffer DTK_set_field_buffer;
 
 %include <std_string.i>
 
 %rename DTK_string_version DTK_version;
 %rename DTK_string_git_commit_hash DTK_git_commit_hash;
+%rename DTK_string_profiling_report DTK_get_profiling_report;
+%rename DTK_string_memory_report DTK_get_memory_report;
 %inline %{
   std::string DTK_string_version() {
     return std::string(DTK_version());
@@ -46,9 +59,17 @@
   std::string DTK_string_git_commit_hash() {
     return std::string(DTK_gitCommitHash());
   }
+  std::string DTK_string_profiling_report(MPI_Comm comm) {
+    return std::string(DTK_getProfilingReport(comm));
+  }
+  std::string DTK_string_memory_report(MPI_Comm comm) {
+    return std::string(DTK_getMemoryReport(comm));
+  }
 %}
 %ignore DTK_version;
 %ignore DTK_gitCommitHash;;
+%ignore DTK_getProfilingReport;
+%ignore DTK_getMemoryReport;
 
 %include "DTK_CellTypes.h"
 %include "DTK_C_API.h"
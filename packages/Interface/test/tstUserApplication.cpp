@@ -812,6 +812,72 @@ TEUCHOS_UNIT_TEST_TEMPLATE_2_DECL( UserApplication, field_eval, SC, DeviceType )
     test_field_eval( user_app, out, success );
 }
 
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST_TEMPLATE_2_DECL( UserApplication, external_buffers, SC,
+                                   DeviceType )
+{
+    // Test types.
+    using ExecutionSpace = typename DeviceType::execution_space;
+    using MemorySpace = typename ExecutionSpace::memory_space;
+    using Scalar = SC;
+
+    // Application-owned coordinates blocked by dimension.
+    Kokkos::View<DataTransferKit::Coordinate **, Kokkos::LayoutLeft,
+                 MemorySpace>
+        coordinates( "coordinates", SIZE_1, SPACE_DIM );
+    auto host_coordinates = Kokkos::create_mirror_view( coordinates );
+    for ( unsigned i = 0; i < SIZE_1; ++i )
+        for ( unsigned d = 0; d < SPACE_DIM; ++d )
+            host_coordinates( i, d ) = i + d + OFFSET;
+    Kokkos::deep_copy( coordinates, host_coordinates );
+
+    // Application-owned fields, one blocked by dimension and one interleaved.
+    Kokkos::View<Scalar **, Kokkos::LayoutLeft, MemorySpace> blocked_dofs(
+        "blocked_dofs", SIZE_1, SPACE_DIM );
+    Kokkos::View<Scalar **, Kokkos::LayoutRight, MemorySpace> interleaved_dofs(
+        "interleaved_dofs", SIZE_1, SPACE_DIM );
+
+    // Register the buffers.
+    auto registry =
+        std::make_shared<DataTransferKit::UserFunctionRegistry<Scalar>>();
+    registry->setNodeListBuffer( coordinates.data(), SIZE_1, SPACE_DIM );
+    registry->setFieldBuffer( FIELD_NAME, blocked_dofs.data(), SIZE_1,
+                              SPACE_DIM );
+    registry->setFieldBuffer( "interleaved", interleaved_dofs.data(), SIZE_1,
+                              SPACE_DIM, SPACE_DIM, 1 );
+
+    // Create the user application.
+    DataTransferKit::UserApplication<Scalar, ExecutionSpace> user_app(
+        registry );
+
+    // The node list aliases the application memory.
+    test_node_list( user_app, out, success );
+    TEST_EQUALITY( user_app.getNodeList().coordinates.data(),
+                   coordinates.data() );
+
+    // Registering the node list again marks it as changed.
+    auto generation = user_app.getNodeListGeneration();
+    TEST_EQUALITY( user_app.getNodeListGeneration(), generation );
+    registry->setNodeListBuffer( coordinates.data(), SIZE_1, SPACE_DIM );
+    TEST_INEQUALITY( user_app.getNodeListGeneration(), generation );
+
+    // So does the field blocked by dimension.
+    test_field_push_pull( user_app, out, success );
+    TEST_EQUALITY( user_app.getField( FIELD_NAME ).dofs.data(),
+                   blocked_dofs.data() );
+
+    // The interleaved field is copied in and out.
+    auto field = user_app.getField( "interleaved" );
+    TEST_INEQUALITY( field.dofs.data(), interleaved_dofs.data() );
+    Kokkos::deep_copy( field.dofs, blocked_dofs );
+    user_app.pushField( "interleaved", field );
+    auto host_dofs = Kokkos::create_mirror_view( interleaved_dofs );
+    Kokkos::deep_copy( host_dofs, interleaved_dofs );
+    for ( unsigned i = 0; i < SIZE_1; ++i )
+        for ( unsigned d = 0; d < SPACE_DIM; ++d )
+            TEST_EQUALITY( host_dofs( i, d ), i + d );
+}
+
 //---------------------------------------------------------------------------//
 TEUCHOS_UNIT_TEST_TEMPLATE_2_DECL( UserApplication, missing_function, SC,
                                    DeviceType )
@@ -900,6 +966,8 @@ TEUCHOS_UNIT_TEST_TEMPLATE_2_DECL( UserApplication, too_many_functions, SC,
                                           SCALAR, DeviceType##NODE )           \
     TEUCHOS_UNIT_TEST_TEMPLATE_2_INSTANT( UserApplication, field_eval, SCALAR, \
                                           DeviceType##NODE )                   \
+    TEUCHOS_UNIT_TEST_TEMPLATE_2_INSTANT( UserApplication, external_buffers,   \
+                                          SCALAR, DeviceType##NODE )           \
     TEUCHOS_UNIT_TEST_TEMPLATE_2_INSTANT( UserApplication, missing_function,   \
                                           SCALAR, DeviceType##NODE )           \
     TEUCHOS_UNIT_TEST_TEMPLATE_2_INSTANT( UserApplication, too_many_functions, \
@@ -12,8 +12,11 @@
 #include <DTK_C_API.h>
 #include <DTK_C_API_Map.hpp>
 
+#include <algorithm>
 #include <cerrno>
 #include <set>
+#include <string>
+#include <vector>
 
 //---------------------------------------------------------------------------//
 namespace DataTransferKit
@@ -52,6 +55,31 @@ DTK_MapHandle DTK_createMap( DTK_ExecutionSpace space, MPI_Comm comm,
     return handle;
 }
 
+//---------------------------------------------------------------------------//
+DTK_MapHandle DTK_createMapGroup( DTK_ExecutionSpace space, MPI_Comm comm,
+                                  DTK_UserApplicationHandle source,
+                                  int num_targets,
+                                  DTK_UserApplicationHandle *targets,
+                                  const char *options )
+{
+    if ( !DTK_isInitialized() )
+    {
+        errno = DTK_UNINITIALIZED;
+        return nullptr;
+    }
+
+    std::vector<DTK_UserApplicationHandle> target_handles(
+        targets, targets + num_targets );
+    auto handle = reinterpret_cast<DTK_MapHandle>(
+        DataTransferKit::createMapGroup( space, comm, source, target_handles,
+                                         options ) );
+    DataTransferKit::valid_map_handles.insert( handle );
+
+    errno = DTK_SUCCESS;
+
+    return handle;
+}
+
 //---------------------------------------------------------------------------//
 bool DTK_isValidMap( DTK_MapHandle handle )
 {
@@ -75,6 +103,79 @@ void DTK_applyMap( DTK_MapHandle handle, const char *source_field,
     errno = DTK_SUCCESS;
 }
 
+//---------------------------------------------------------------------------//
+void DTK_applyMapBatch( DTK_MapHandle handle, int num_fields,
+                        const char **source_fields,
+                        const char **target_fields )
+{
+    if ( !DTK_isValidMap( handle ) )
+    {
+        errno = DTK_INVALID_HANDLE;
+        return;
+    }
+
+    std::vector<std::string> source_field_names( source_fields,
+                                                 source_fields + num_fields );
+    std::vector<std::string> target_field_names( target_fields,
+                                                 target_fields + num_fields );
+    reinterpret_cast<DataTransferKit::DTK_Map *>( handle )->apply(
+        source_field_names, target_field_names );
+
+    errno = DTK_SUCCESS;
+}
+
+//---------------------------------------------------------------------------//
+void DTK_applyMapGroup( DTK_MapHandle handle, const char *source_field,
+                        const char **target_fields )
+{
+    if ( !DTK_isValidMap( handle ) )
+    {
+        errno = DTK_INVALID_HANDLE;
+        return;
+    }
+
+    auto map = reinterpret_cast<DataTransferKit::DTK_Map *>( handle );
+    std::vector<std::string> target_field_names(
+        target_fields, target_fields + map->numTargets() );
+    map->apply( std::string( source_field ), target_field_names );
+
+    errno = DTK_SUCCESS;
+}
+
+//---------------------------------------------------------------------------//
+void DTK_getMapStatistics( DTK_MapHandle handle,
+                           DTK_MapStatistics *statistics )
+{
+    errno = DTK_SUCCESS;
+
+    if ( !DTK_isValidMap( handle ) )
+    {
+        errno = DTK_INVALID_HANDLE;
+        return;
+    }
+
+    auto const map_statistics =
+        reinterpret_cast<DataTransferKit::DTK_Map *>( handle )->statistics();
+
+    std::fill( statistics->stencil_sizes,
+               statistics->stencil_sizes + DTK_STENCIL_SIZE_BINS, 0 );
+    auto const &sizes = map_statistics.stencil_sizes;
+    for ( unsigned int s = 0; s < sizes.size(); ++s )
+        statistics->stencil_sizes[std::min<unsigned int>(
+            s, DTK_STENCIL_SIZE_BINS - 1 )] += sizes[s];
+    statistics->local_entries = map_statistics.local_entries;
+    statistics->remote_entries = map_statistics.remote_entries;
+    statistics->bytes_sent = map_statistics.bytes_sent;
+    statistics->bytes_received = map_statistics.bytes_received;
+    statistics->send_neighbors = map_statistics.send_neighbors;
+    statistics->recv_neighbors = map_statistics.recv_neighbors;
+    statistics->num_targets = map_statistics.num_targets;
+    statistics->target_imbalance = map_statistics.target_imbalance;
+    statistics->num_underdetermined = map_statistics.num_underdetermined;
+
+    errno = DTK_SUCCESS;
+}
+
 //---------------------------------------------------------------------------//
 void DTK_destroyMap( DTK_MapHandle handle )
 {
@@ -21,7 +21,11 @@
 #include <DTK_MovingLeastSquaresOperator.hpp>
 #include <DTK_NearestNeighborOperator.hpp>
 #include <DTK_ParallelTraits.hpp>
+#include <DTK_PayloadCompression.hpp>
 #include <DTK_PointCloudOperator.hpp>
+#include <DTK_PointCloudOperatorGroup.hpp>
+#include <DTK_SourceIndex.hpp>
+#include <DTK_SurfaceNodes.hpp>
 #include <DTK_UserApplication.hpp>
 
 #include <boost/property_tree/json_parser.hpp>
@@ -29,9 +33,16 @@
 
 #include <mpi.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <map>
 #include <memory>
 #include <string>
 #include <tuple>
+#include <type_traits>
+#include <vector>
 
 namespace DataTransferKit
 {
@@ -48,8 +59,151 @@ struct DTK_Map
 
     virtual void apply( const std::string &source_field_name,
                         const std::string &target_field_name ) = 0;
+
+    // Transfer source_field_names[i] to target_field_names[i] for all i with
+    // a single application of the operator.
+    virtual void
+    apply( const std::vector<std::string> &source_field_names,
+           const std::vector<std::string> &target_field_names ) = 0;
+
+    // Number of target applications of the map.
+    virtual int numTargets() const { return 1; }
+
+    // Cost of the operator of the map. Collective.
+    virtual OperatorStatistics statistics() const = 0;
+
+    // Transfer the source field to target_field_names[k] of the k-th target
+    // of the map.
+    virtual void
+    apply( const std::string &source_field_name,
+           const std::vector<std::string> &target_field_names ) = 0;
 };
 
+//---------------------------------------------------------------------------//
+// Read the encoding of the payloads exchanged by the operator. Both fields
+// accept "None" (default), "Lossless", or "Float32". "Float32 Tolerance"
+// bounds the absolute error of the latter.
+inline PayloadCompressionOptions
+parsePayloadCompressionOptions( boost::property_tree::ptree const &ptree )
+{
+    auto const parse =
+        [&ptree]( std::string const &key ) -> PayloadCompression {
+        auto const value = ptree.get<std::string>( key, "None" );
+        if ( value == "None" )
+            return PayloadCompression::None;
+        else if ( value == "Lossless" )
+            return PayloadCompression::Lossless;
+        else if ( value == "Float32" )
+            return PayloadCompression::BoundedFloat32;
+        else
+            throw DataTransferKitException( "Invalid value \"" + value +
+                                            "\" for field \"" + key + "\"" );
+    };
+    PayloadCompressionOptions options;
+    options.coordinates = parse( "Coordinates Compression" );
+    options.values = parse( "Values Compression" );
+    options.float32_tolerance =
+        ptree.get<double>( "Float32 Tolerance", options.float32_tolerance );
+    return options;
+}
+
+//---------------------------------------------------------------------------//
+// Index over the source nodes. When sharing is requested, it is cached for
+// each source application, communicator and generation of its node list as
+// long as a map holds it. Registering the node list again starts a new
+// generation, so that a tree is not reused after the application said that
+// its nodes moved. Building the index is collective, and so is creating maps,
+// hence the ranks agree on reusing a cached index only if it is still valid
+// on all of them.
+template <class DeviceType, class SourceMemSpace>
+std::shared_ptr<SourceIndex<DeviceType> const>
+sharedSourceIndex( MPI_Comm comm, DTK_UserApplicationHandle handle,
+                   UserApplication<double, SourceMemSpace> &source,
+                   bool share )
+{
+    // The operators accept any layout so the coordinates are only copied if
+    // they do not live in the memory space of the map.
+    auto const build = [comm, &source]() {
+        using memory_space = typename DeviceType::memory_space;
+        auto source_nodes = Kokkos::create_mirror_view_and_copy(
+            memory_space(), source.getNodeList().coordinates );
+        return std::make_shared<SourceIndex<DeviceType> const>( comm,
+                                                                source_nodes );
+    };
+    if ( !share )
+        return build();
+
+    using Key = std::tuple<DTK_UserApplicationHandle, MPI_Comm, std::size_t>;
+    static std::map<Key, std::weak_ptr<SourceIndex<DeviceType> const>> cache;
+    for ( auto it = cache.begin(); it != cache.end(); )
+        it = it->second.expired() ? cache.erase( it ) : std::next( it );
+
+    auto const key =
+        std::make_tuple( handle, comm, source.getNodeListGeneration() );
+    std::shared_ptr<SourceIndex<DeviceType> const> index;
+    auto it = cache.find( key );
+    if ( it != cache.end() )
+        index = it->second.lock();
+    int const local_hit = index ? 1 : 0;
+    int hit = 0;
+    MPI_Allreduce( &local_hit, &hit, 1, MPI_INT, MPI_MIN, comm );
+    if ( hit )
+        return index;
+
+    index = build();
+    cache[key] = index;
+    return index;
+}
+
+//---------------------------------------------------------------------------//
+// Create the operator selected by the options.
+// FOR NOW JUST CREATE POINT CLOUD OPERATORS FOR DEMONSTRATION PURPOSES. THIS
+// WILL BE REPLACED BY A PROPER FACTORY.
+template <class DeviceType>
+std::unique_ptr<PointCloudOperator<DeviceType>> createPointCloudOperator(
+    boost::property_tree::ptree const &ptree,
+    SourceIndex<DeviceType> const &source_index,
+    Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+        target_nodes )
+{
+    auto const compression = parsePayloadCompressionOptions( ptree );
+
+    auto const which_map = ptree.get<std::string>( "Map Type", "Undefined" );
+    if ( which_map == "Undefined" )
+        throw DataTransferKitException(
+            R"(Field "Map Type" is not defined in options string argument for map creation)" );
+    else if ( which_map == "Nearest Neighbor" || which_map == "NN" )
+        return std::unique_ptr<PointCloudOperator<DeviceType>>(
+            new NearestNeighborOperator<DeviceType>(
+                source_index, target_nodes, compression ) );
+    else if ( which_map == "Moving Least Squares" || which_map == "MLS" )
+    {
+        // NOTE if field "Order" is misspelled (for instance first letter not
+        // capitalized), the default value (linear polynomials) will be picked
+        // up without a warning or an error being raised.
+        auto const order = ptree.get<std::string>( "Order", "Linear" );
+        if ( order == "Linear" || order == "1" )
+            return std::unique_ptr<PointCloudOperator<DeviceType>>(
+                new MovingLeastSquaresOperator<
+                    DeviceType, Wendland<0>,
+                    MultivariatePolynomialBasis<Linear, 3>>(
+                    source_index, target_nodes, compression ) );
+        else if ( order == "Quadratic" || order == "2" )
+            return std::unique_ptr<PointCloudOperator<DeviceType>>(
+                new MovingLeastSquaresOperator<
+                    DeviceType, Wendland<0>,
+                    MultivariatePolynomialBasis<Quadratic, 3>>(
+                    source_index, target_nodes, compression ) );
+        else
+            throw DataTransferKitException(
+                "Invalid order \"" + order +
+                "\" for creating a moving least squares map" );
+    }
+    else
+        throw DataTransferKitException( "Invalid map type \"" + which_map +
+                                        "\"" );
+}
+
 //---------------------------------------------------------------------------//
 template <class MapExecSpace, class SourceMemSpace, class TargetMemSpace>
 struct DTK_MapImpl : public DTK_Map
@@ -61,102 +215,599 @@ struct DTK_MapImpl : public DTK_Map
                  boost::property_tree::ptree const &ptree )
         : _source( reinterpret_cast<DTK_Registry *>( source )->_registry )
         , _target( reinterpret_cast<DTK_Registry *>( target )->_registry )
+        , _batch_source_values( "batch_source_values", 0, 0 )
+        , _batch_target_values( "batch_target_values", 0, 0 )
     {
-        // FOR NOW JUST CREATE A NEAREST NEIGHBOR OPERATOR FOR DEMONSTRATION
-        // PURPOSES. THIS WILL BE REPLACED BY A PROPER FACTORY.
-
-        // Get coordinates from the source and target.
-        auto source_nodes = _source.getNodeList().coordinates;
-        auto target_nodes = _target.getNodeList().coordinates;
-
-        // For now things are layout left in the interface so copy to a
-        // matching layout that is compatible with the operator.
-        Kokkos::View<Coordinate **, map_device_type> source_nodes_copy(
-            "src_nodes_copy", source_nodes.extent( 0 ),
-            source_nodes.extent( 1 ) );
-        Kokkos::deep_copy( source_nodes_copy, source_nodes );
-        Kokkos::View<Coordinate **, map_device_type> target_nodes_copy(
-            "tgt_nodes_copy", target_nodes.extent( 0 ),
-            target_nodes.extent( 1 ) );
-        Kokkos::deep_copy( target_nodes_copy, target_nodes );
-
-        auto const which_map =
-            ptree.get<std::string>( "Map Type", "Undefined" );
-        if ( which_map == "Undefined" )
-            throw DataTransferKitException(
-                R"(Field "Map Type" is not defined in options string argument for map creation)" );
-        else if ( which_map == "Nearest Neighbor" || which_map == "NN" )
-            _map = std::unique_ptr<NearestNeighborOperator<map_device_type>>(
-                new NearestNeighborOperator<map_device_type>(
-                    comm, source_nodes_copy, target_nodes_copy ) );
-        else if ( which_map == "Moving Least Squares" || which_map == "MLS" )
+        // Only search and transfer between the nodes on the boundary of the
+        // meshes, so that the cost scales with the area of the interface.
+        _surface_only = ptree.get<bool>( "Surface Only", false );
+        if ( _surface_only )
         {
-            // NOTE if field "Order" is misspelled (for instance first letter
-            // not capitalized), the default value (linear polynomials) will be
-            // picked up without a warning or an error being raised.
-            auto const order = ptree.get<std::string>( "Order", "Linear" );
-            if ( order == "Linear" || order == "1" )
-                _map = std::unique_ptr<MovingLeastSquaresOperator<
-                    map_device_type, Wendland<0>,
-                    MultivariatePolynomialBasis<Linear, 3>>>(
-                    new MovingLeastSquaresOperator<
-                        map_device_type, Wendland<0>,
-                        MultivariatePolynomialBasis<Linear, 3>>(
-                        comm, source_nodes_copy, target_nodes_copy ) );
-            else if ( order == "Quadratic" || order == "2" )
-                _map = std::unique_ptr<MovingLeastSquaresOperator<
-                    map_device_type, Wendland<0>,
-                    MultivariatePolynomialBasis<Quadratic, 3>>>(
-                    new MovingLeastSquaresOperator<
-                        map_device_type, Wendland<0>,
-                        MultivariatePolynomialBasis<Quadratic, 3>>(
-                        comm, source_nodes_copy, target_nodes_copy ) );
-            else
-                throw DataTransferKitException(
-                    "Invalid order \"" + order +
-                    "\" for creating a moving least squares map" );
+            Kokkos::View<Coordinate **, Kokkos::LayoutLeft, map_device_type>
+                source_nodes;
+            Kokkos::View<Coordinate **, Kokkos::LayoutLeft, map_device_type>
+                target_nodes;
+            std::tie( _source_surface, _source_num_nodes, source_nodes ) =
+                extractSurface( _source );
+            std::tie( _target_surface, _target_num_nodes, target_nodes ) =
+                extractSurface( _target );
+            _source_index = std::make_shared<SourceIndex<map_device_type>>(
+                comm, source_nodes );
+            _map = createPointCloudOperator<map_device_type>(
+                ptree, *_source_index, target_nodes );
+            return;
         }
-        else
-            throw DataTransferKitException( "Invalid map type \"" + which_map +
-                                            "\"" );
+
+        // Get the target coordinates. The operators accept any layout so
+        // the coordinates are only copied if they do not live in the memory
+        // space of the map.
+        using map_memory_space = typename map_device_type::memory_space;
+        auto target_nodes = Kokkos::create_mirror_view_and_copy(
+            map_memory_space(), _target.getNodeList().coordinates );
+
+        // The search tree over the source nodes may be shared with other maps.
+        _source_index = sharedSourceIndex<map_device_type>(
+            comm, source, _source,
+            ptree.get<bool>( "Share Source Index", false ) );
+
+        _map = createPointCloudOperator<map_device_type>( ptree, *_source_index,
+                                                          target_nodes );
     }
 
     void apply( const std::string &source_field_name,
                 const std::string &target_field_name ) override
     {
-        // Create fields.
-        auto source_field = _source.getField( source_field_name );
-        auto target_field = _target.getField( target_field_name );
+        auto &pair = getFieldPair( source_field_name, target_field_name );
 
         // Pull the data from the source.
-        _source.pullField( source_field_name, source_field );
+        _source.pullField( source_field_name, pair.source_field );
 
-        // Copy to a compatible layout. Nearest neighbor operator needs a
-        // compatible layout and only 1 dimension
-        int num_src = source_field.dofs.extent( 0 );
-        Kokkos::View<double *, map_device_type> source_field_copy(
-            "source_field_copy", num_src );
-        Kokkos::deep_copy(
-            source_field_copy,
-            Kokkos::subview( source_field.dofs, Kokkos::ALL, 0 ) );
-        int num_tgt = target_field.dofs.extent( 0 );
-        Kokkos::View<double *, map_device_type> target_field_copy(
-            "target_field_copy", num_tgt );
+        // Move the field to the memory space of the map unless it can be used
+        // directly.
+        if ( pair.source_values.data() != pair.source_field.dofs.data() )
+            Kokkos::deep_copy( pair.source_values, pair.source_field.dofs );
 
-        // Apply the map.
-        _map->apply( source_field_copy, target_field_copy );
+        // Apply the map to all the components at once.
+        if ( _surface_only )
+        {
+            // The target values away from the surface are pushed back
+            // unchanged.
+            _target.pullField( target_field_name, pair.target_field );
+            if ( pair.target_values.data() != pair.target_field.dofs.data() )
+                Kokkos::deep_copy( pair.target_values,
+                                   pair.target_field.dofs );
+            gatherSurface( _source_surface, _source_num_nodes,
+                           pair.source_values, pair.surface_source_values );
+            _map->apply( pair.surface_source_values,
+                         pair.surface_target_values );
+            scatterSurface( _target_surface, _target_num_nodes,
+                            pair.surface_target_values, pair.target_values );
+        }
+        else
+            _map->apply( pair.source_values, pair.target_values );
 
-        // Copy the transferred field back to the original target layout.
-        Kokkos::deep_copy( Kokkos::subview( target_field.dofs, Kokkos::ALL, 0 ),
-                           target_field_copy );
+        // Copy the transferred field back to the target memory space.
+        if ( pair.target_values.data() != pair.target_field.dofs.data() )
+            Kokkos::deep_copy( pair.target_field.dofs, pair.target_values );
 
         // Push the data to the target.
-        _target.pushField( target_field_name, target_field );
+        _target.pushField( target_field_name, pair.target_field );
+    }
+
+    void apply( const std::vector<std::string> &source_field_names,
+                const std::vector<std::string> &target_field_names ) override
+    {
+        DTK_INSIST( source_field_names.size() == target_field_names.size() );
+        int const num_fields = source_field_names.size();
+        if ( num_fields == 0 )
+            return;
+
+        // Surface maps transfer the fields one at a time.
+        if ( _surface_only )
+        {
+            for ( int f = 0; f < num_fields; ++f )
+                apply( source_field_names[f], target_field_names[f] );
+            return;
+        }
+
+        // Pull all the fields and count the components.
+        _batch.resize( num_fields );
+        int num_components = 0;
+        for ( int f = 0; f < num_fields; ++f )
+        {
+            _batch[f] = &getFieldPair( source_field_names[f],
+                                       target_field_names[f] );
+            _source.pullField( source_field_names[f],
+                               _batch[f]->source_field );
+            num_components += _batch[f]->source_field.dofs.extent( 1 );
+        }
+
+        // Pack the fields next to each other, one component per column.
+        auto const source_values = batchValues(
+            _batch_source_values, batchSourceSize(), num_components );
+        auto const target_values = batchValues(
+            _batch_target_values, batchTargetSize(), num_components );
+        int column = 0;
+        for ( auto pair : _batch )
+        {
+            auto const columns = std::make_pair(
+                column, column + pair->source_field.dofs.extent_int( 1 ) );
+            Kokkos::deep_copy(
+                Kokkos::subview( source_values, Kokkos::ALL, columns ),
+                pair->source_field.dofs );
+            column = columns.second;
+        }
+
+        // Transfer all the fields in a single exchange.
+        _map->apply( source_values, target_values );
+
+        // Unpack and push the fields to the target.
+        column = 0;
+        for ( int f = 0; f < num_fields; ++f )
+        {
+            auto pair = _batch[f];
+            auto const columns = std::make_pair(
+                column, column + pair->target_field.dofs.extent_int( 1 ) );
+            Kokkos::deep_copy(
+                pair->target_field.dofs,
+                Kokkos::subview( target_values, Kokkos::ALL, columns ) );
+            column = columns.second;
+            _target.pushField( target_field_names[f], pair->target_field );
+        }
+    }
+
+    OperatorStatistics statistics() const override
+    {
+        return _map->statistics();
+    }
+
+    void apply( const std::string &source_field_name,
+                const std::vector<std::string> &target_field_names ) override
+    {
+        DTK_INSIST( target_field_names.size() == 1 );
+        apply( source_field_name, target_field_names.front() );
+    }
+
+    // Fields and staging buffers used to apply the map to a given pair of
+    // fields. They are kept between calls so that applying the map again
+    // does not allocate.
+    struct FieldPair
+    {
+        std::string source_name;
+        std::string target_name;
+        Field<double, Kokkos::LayoutLeft, SourceMemSpace> source_field;
+        Field<double, Kokkos::LayoutLeft, TargetMemSpace> target_field;
+        Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type>
+            source_values;
+        Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type>
+            target_values;
+        // Values at the surface nodes of surface maps.
+        Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type>
+            surface_source_values;
+        Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type>
+            surface_target_values;
+    };
+
+    // Local ids and coordinates of the nodes on the boundary registered by
+    // an application, and the number of nodes of its cell list on which the
+    // fields are defined.
+    template <class MemSpace>
+    static std::tuple<
+        Kokkos::View<int *, map_device_type>, size_t,
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, map_device_type>>
+    extractSurface( UserApplication<double, MemSpace> &application )
+    {
+        auto cell_list = application.getCellList();
+        application.getBoundary( cell_list );
+        size_t const num_nodes = cell_list.coordinates.extent( 0 );
+        auto const nodes = surfaceNodes( cell_list );
+        DTK_REQUIRE( nodes.empty() ||
+                     ( nodes.front() >= 0 &&
+                       static_cast<size_t>( nodes.back() ) < num_nodes ) );
+        int const n_nodes = nodes.size();
+        Kokkos::View<int *, map_device_type> surface( "surface_nodes",
+                                                      n_nodes );
+        Kokkos::deep_copy(
+            surface,
+            Kokkos::View<int const *, Kokkos::HostSpace,
+                         Kokkos::MemoryUnmanaged>( nodes.data(), n_nodes ) );
+
+        using map_memory_space = typename map_device_type::memory_space;
+        auto coordinates = Kokkos::create_mirror_view_and_copy(
+            map_memory_space(), cell_list.coordinates );
+        int const space_dim = coordinates.extent( 1 );
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, map_device_type>
+            surface_coordinates( Kokkos::ViewAllocateWithoutInitializing(
+                                     "surface_coordinates" ),
+                                 n_nodes, space_dim );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "gather_surface_coordinates" ),
+            Kokkos::RangePolicy<MapExecSpace>( 0, n_nodes ),
+            KOKKOS_LAMBDA( int i ) {
+                for ( int d = 0; d < space_dim; ++d )
+                    surface_coordinates( i, d ) =
+                        coordinates( surface( i ), d );
+            } );
+        Kokkos::fence();
+        return std::make_tuple( surface, num_nodes, surface_coordinates );
+    }
+
+    // surface_values(i, j) <-- values(nodes(i), j)
+    static void gatherSurface(
+        Kokkos::View<int *, map_device_type> nodes, size_t num_nodes,
+        Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type> values,
+        Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type>
+            surface_values )
+    {
+        // The field must be defined on the nodes of the cell list.
+        DTK_REQUIRE( values.extent( 0 ) == num_nodes );
+        DTK_REQUIRE( surface_values.extent( 0 ) == nodes.extent( 0 ) );
+        DTK_REQUIRE( surface_values.extent( 1 ) == values.extent( 1 ) );
+        int const n_components = values.extent( 1 );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "gather_surface_values" ),
+            Kokkos::RangePolicy<MapExecSpace>( 0, nodes.extent( 0 ) ),
+            KOKKOS_LAMBDA( int i ) {
+                for ( int j = 0; j < n_components; ++j )
+                    surface_values( i, j ) = values( nodes( i ), j );
+            } );
+        Kokkos::fence();
+    }
+
+    // values(nodes(i), j) <-- surface_values(i, j)
+    static void scatterSurface(
+        Kokkos::View<int *, map_device_type> nodes, size_t num_nodes,
+        Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type>
+            surface_values,
+        Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type> values )
+    {
+        DTK_REQUIRE( values.extent( 0 ) == num_nodes );
+        DTK_REQUIRE( surface_values.extent( 0 ) == nodes.extent( 0 ) );
+        DTK_REQUIRE( surface_values.extent( 1 ) == values.extent( 1 ) );
+        int const n_components = values.extent( 1 );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "scatter_surface_values" ),
+            Kokkos::RangePolicy<MapExecSpace>( 0, nodes.extent( 0 ) ),
+            KOKKOS_LAMBDA( int i ) {
+                for ( int j = 0; j < n_components; ++j )
+                    values( nodes( i ), j ) = surface_values( i, j );
+            } );
+        Kokkos::fence();
+    }
+
+    // The fields are LayoutLeft, just like the operator input, so they are
+    // aliased when they already live in the memory space of the map.
+    template <class View>
+    static Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type>
+    stagingView( View dofs, std::true_type )
+    {
+        return dofs;
+    }
+
+    template <class View>
+    static Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type>
+    stagingView( View dofs, std::false_type )
+    {
+        return Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type>(
+            Kokkos::ViewAllocateWithoutInitializing( dofs.label() + "_copy" ),
+            dofs.extent( 0 ), dofs.extent( 1 ) );
+    }
+
+    // All the fields of a batch have the same number of dofs.
+    size_t batchSourceSize() const
+    {
+        size_t const size = _batch.front()->source_field.dofs.extent( 0 );
+        for ( auto pair : _batch )
+            DTK_INSIST( pair->source_field.dofs.extent( 0 ) == size );
+        return size;
+    }
+
+    size_t batchTargetSize() const
+    {
+        size_t const size = _batch.front()->target_field.dofs.extent( 0 );
+        for ( auto pair : _batch )
+            DTK_INSIST( pair->target_field.dofs.extent( 0 ) == size );
+        return size;
+    }
+
+    // Columns of a batch buffer, which only grows.
+    static Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type>
+    batchValues(
+        Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type> &buffer,
+        size_t size, int num_components )
+    {
+        if ( buffer.extent( 0 ) != size ||
+             buffer.extent_int( 1 ) < num_components )
+            buffer = Kokkos::View<double **, Kokkos::LayoutLeft,
+                                  map_device_type>(
+                Kokkos::ViewAllocateWithoutInitializing( buffer.label() ),
+                size, num_components );
+        return Kokkos::subview( buffer, Kokkos::ALL,
+                                std::make_pair( 0, num_components ) );
+    }
+
+    // Find the cached pair of fields. The fields are only created again when
+    // the application reports a different size.
+    FieldPair &getFieldPair( const std::string &source_field_name,
+                             const std::string &target_field_name )
+    {
+        unsigned source_dim;
+        size_t source_num_dofs;
+        _source.getFieldSize( source_field_name, source_dim, source_num_dofs );
+        unsigned target_dim;
+        size_t target_num_dofs;
+        _target.getFieldSize( target_field_name, target_dim, target_num_dofs );
+        DTK_INSIST( source_dim == target_dim );
+
+        // There are only a handful of fields so a linear search will do. The
+        // pairs are stored in a deque so that adding one does not move the
+        // others.
+        auto pair = std::find_if(
+            _field_pairs.begin(), _field_pairs.end(),
+            [&]( FieldPair const &p ) {
+                return p.source_name == source_field_name &&
+                       p.target_name == target_field_name;
+            } );
+        if ( pair == _field_pairs.end() )
+        {
+            _field_pairs.emplace_back();
+            pair = _field_pairs.end() - 1;
+            pair->source_name = source_field_name;
+            pair->target_name = target_field_name;
+        }
+        else if ( pair->source_field.dofs.extent( 0 ) == source_num_dofs &&
+                  pair->source_field.dofs.extent( 1 ) == source_dim &&
+                  pair->target_field.dofs.extent( 0 ) == target_num_dofs &&
+                  pair->target_field.dofs.extent( 1 ) == target_dim )
+        {
+            return *pair;
+        }
+
+        using map_memory_space = typename map_device_type::memory_space;
+        pair->source_field = _source.getField( source_field_name );
+        pair->target_field = _target.getField( target_field_name );
+        pair->source_values = stagingView(
+            pair->source_field.dofs,
+            std::is_same<SourceMemSpace, map_memory_space>() );
+        pair->target_values = stagingView(
+            pair->target_field.dofs,
+            std::is_same<TargetMemSpace, map_memory_space>() );
+        if ( _surface_only )
+        {
+            pair->surface_source_values =
+                Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type>(
+                    "surface_source_values", _source_surface.extent( 0 ),
+                    source_dim );
+            pair->surface_target_values =
+                Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type>(
+                    "surface_target_values", _target_surface.extent( 0 ),
+                    target_dim );
+        }
+        return *pair;
     }
 
     UserApplication<double, SourceMemSpace> _source;
     UserApplication<double, TargetMemSpace> _target;
+    std::shared_ptr<SourceIndex<map_device_type> const> _source_index;
     std::unique_ptr<PointCloudOperator<map_device_type>> _map;
+    bool _surface_only = false;
+    Kokkos::View<int *, map_device_type> _source_surface;
+    Kokkos::View<int *, map_device_type> _target_surface;
+    // Number of nodes of the cell lists of surface maps.
+    size_t _source_num_nodes = 0;
+    size_t _target_num_nodes = 0;
+    std::deque<FieldPair> _field_pairs;
+    std::vector<FieldPair *> _batch;
+    Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type>
+        _batch_source_values;
+    Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type>
+        _batch_target_values;
+};
+
+//---------------------------------------------------------------------------//
+// Maps from one source to several targets. The source field is pulled once
+// and the source values needed by any of the targets are exchanged in a
+// single round before each target computes its own values.
+template <class MapExecSpace, class SourceMemSpace, class TargetMemSpace>
+struct DTK_MapGroupImpl : public DTK_Map
+{
+    using map_device_type = typename MapExecSpace::device_type;
+    using map_memory_space = typename map_device_type::memory_space;
+
+    DTK_MapGroupImpl( MPI_Comm comm, DTK_UserApplicationHandle source,
+                      std::vector<DTK_UserApplicationHandle> const &targets,
+                      boost::property_tree::ptree const &ptree )
+        : _source( reinterpret_cast<DTK_Registry *>( source )->_registry )
+        , _target_fields( targets.size() )
+        , _staged_target_values( targets.size() )
+        , _target_values( targets.size() )
+    {
+        // The group exchanges raw values on behalf of its operators.
+        if ( parsePayloadCompressionOptions( ptree ).values !=
+             PayloadCompression::None )
+            throw DataTransferKitException(
+                "Values compression is not supported by maps with several "
+                "targets" );
+
+        // All the operators search the same tree.
+        _source_index = sharedSourceIndex<map_device_type>(
+            comm, source, _source,
+            ptree.get<bool>( "Share Source Index", false ) );
+        _source_staging = stagingBuffer<SourceMemSpace>(
+            "source_staging", _source_index->size() );
+
+        std::vector<
+            std::shared_ptr<PointCloudOperator<map_device_type> const>>
+            maps;
+        for ( auto target : targets )
+        {
+            _targets.emplace_back(
+                reinterpret_cast<DTK_Registry *>( target )->_registry );
+            auto target_nodes = Kokkos::create_mirror_view_and_copy(
+                map_memory_space(), _targets.back().getNodeList().coordinates );
+            maps.emplace_back( createPointCloudOperator<map_device_type>(
+                ptree, *_source_index, target_nodes ) );
+            _target_staging.push_back( stagingBuffer<TargetMemSpace>(
+                "target_staging", target_nodes.extent( 0 ) ) );
+        }
+        _group.reset(
+            new PointCloudOperatorGroup<map_device_type>( comm, maps ) );
+    }
+
+    int numTargets() const override { return _targets.size(); }
+
+    // Transfer the source field to the field of the same name on every
+    // target.
+    void apply( const std::string &source_field_name,
+                const std::string &target_field_name ) override
+    {
+        apply( source_field_name, std::vector<std::string>(
+                                      _targets.size(), target_field_name ) );
+    }
+
+    void apply( const std::vector<std::string> &source_field_names,
+                const std::vector<std::string> &target_field_names ) override
+    {
+        DTK_INSIST( source_field_names.size() == target_field_names.size() );
+        for ( unsigned int f = 0; f < source_field_names.size(); ++f )
+            apply( source_field_names[f], target_field_names[f] );
+    }
+
+    void apply( const std::string &source_field_name,
+                const std::vector<std::string> &target_field_names ) override
+    {
+        DTK_INSIST( target_field_names.size() == _targets.size() );
+        int const num_targets = _targets.size();
+
+        // Pull the source field once for all the targets.
+        auto &source_field =
+            cachedField( _source, _source_fields, source_field_name );
+        _source.pullField( source_field_name, source_field );
+        auto const source_values =
+            stagedValues( _source_staging, source_field.dofs );
+        if ( source_values.data() != source_field.dofs.data() )
+            Kokkos::deep_copy( source_values, source_field.dofs );
+
+        for ( int k = 0; k < num_targets; ++k )
+        {
+            auto &target_field = cachedField( _targets[k], _target_fields[k],
+                                              target_field_names[k] );
+            DTK_INSIST( target_field.dofs.extent( 1 ) ==
+                        source_field.dofs.extent( 1 ) );
+            _staged_target_values[k] =
+                stagedValues( _target_staging[k], target_field.dofs );
+            _target_values[k] = _staged_target_values[k];
+        }
+
+        // Exchange the source values once for all the targets.
+        _group->apply( source_values, _target_values );
+
+        // Copy the transferred fields back and push them to the targets.
+        for ( int k = 0; k < num_targets; ++k )
+        {
+            auto &target_field = _target_fields[k][target_field_names[k]];
+            if ( _staged_target_values[k].data() != target_field.dofs.data() )
+                Kokkos::deep_copy( target_field.dofs,
+                                   _staged_target_values[k] );
+            _targets[k].pushField( target_field_names[k], target_field );
+        }
+    }
+
+    OperatorStatistics statistics() const override
+    {
+        return _group->statistics();
+    }
+
+    // Buffer holding the values of the nodes of an application in the memory
+    // space of the map. It is sized for the nodes at construction and only
+    // grows to hold more components. Fields that already live in the memory
+    // space of the map are used directly and need no buffer.
+    template <class MemSpace>
+    static Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type>
+    stagingBuffer( std::string const &label, size_t num_nodes )
+    {
+        return Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type>(
+            Kokkos::ViewAllocateWithoutInitializing( label ),
+            std::is_same<MemSpace, map_memory_space>::value ? 0 : num_nodes,
+            std::is_same<MemSpace, map_memory_space>::value ? 0 : 1 );
+    }
+
+    // The field itself if it lives in the memory space of the map, the
+    // leading columns of its staging buffer otherwise.
+    template <class Dofs>
+    static Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type>
+    stagedValues(
+        Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type> &buffer,
+        Dofs const &dofs )
+    {
+        return stagedValues(
+            buffer, dofs,
+            std::is_same<typename Dofs::memory_space, map_memory_space>() );
+    }
+
+    template <class Dofs>
+    static Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type>
+    stagedValues(
+        Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type> &,
+        Dofs const &dofs, std::true_type )
+    {
+        return dofs;
+    }
+
+    template <class Dofs>
+    static Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type>
+    stagedValues(
+        Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type> &buffer,
+        Dofs const &dofs, std::false_type )
+    {
+        DTK_REQUIRE( dofs.extent( 0 ) == buffer.extent( 0 ) );
+        if ( buffer.extent( 1 ) < dofs.extent( 1 ) )
+            buffer = Kokkos::View<double **, Kokkos::LayoutLeft,
+                                  map_device_type>(
+                Kokkos::ViewAllocateWithoutInitializing( buffer.label() ),
+                buffer.extent( 0 ), dofs.extent( 1 ) );
+        return Kokkos::subview(
+            buffer, Kokkos::ALL,
+            std::make_pair( 0, static_cast<int>( dofs.extent( 1 ) ) ) );
+    }
+
+    // Find the cached field. It is only created again when the application
+    // reports a different size.
+    template <class Application, class FieldType>
+    static FieldType &cachedField( Application &application,
+                                   std::map<std::string, FieldType> &fields,
+                                   const std::string &field_name )
+    {
+        unsigned dim;
+        size_t num_dofs;
+        application.getFieldSize( field_name, dim, num_dofs );
+        auto &field = fields[field_name];
+        if ( field.dofs.extent( 0 ) != num_dofs ||
+             field.dofs.extent( 1 ) != dim )
+            field = application.getField( field_name );
+        return field;
+    }
+
+    using SourceField = Field<double, Kokkos::LayoutLeft, SourceMemSpace>;
+    using TargetField = Field<double, Kokkos::LayoutLeft, TargetMemSpace>;
+
+    UserApplication<double, SourceMemSpace> _source;
+    std::vector<UserApplication<double, TargetMemSpace>> _targets;
+    std::shared_ptr<SourceIndex<map_device_type> const> _source_index;
+    std::unique_ptr<PointCloudOperatorGroup<map_device_type>> _group;
+    std::map<std::string, SourceField> _source_fields;
+    std::vector<std::map<std::string, TargetField>> _target_fields;
+    Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type>
+        _source_staging;
+    std::vector<Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type>>
+        _target_staging;
+    // Target values of the current transfer, in the staging buffers or in
+    // the target fields.
+    std::vector<Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type>>
+        _staged_target_values;
+    std::vector<
+        Kokkos::View<double **, Kokkos::LayoutStride, map_device_type>>
+        _target_values;
 };
 
 //---------------------------------------------------------------------------//
@@ -233,35 +884,38 @@ bool validMapSpaces( DTK_ExecutionSpace map_space, DTK_MemorySpace source_space,
 }
 
 //---------------------------------------------------------------------------//
-// Create a map.
-DTK_Map *createMap( DTK_ExecutionSpace map_space, MPI_Comm comm,
-                    DTK_UserApplicationHandle source,
-                    DTK_UserApplicationHandle target, const char *options )
+// Parse the options string of a map.
+boost::property_tree::ptree parseMapOptions( const char *options )
 {
-    // Parse options.
     std::stringstream ss;
     ss.str( options );
     boost::property_tree::ptree ptree;
     // read_json calls seq_index_node which is not compatible with cuda 10 (see
     // https://stackoverflow.com/questions/55143135/error-cannot-call-member-function-impl-of-impl-pointer-in-boost)
-    // So we disable reading json file for now
-    //  try
-    //  {
-    //      boost::property_tree::read_json( ss, ptree );
-    //  }
-    //  catch ( boost::property_tree::json_parser_error )
-    //  {
-    //      throw DataTransferKitException(
-    //          "Error while parsing JSON format in options string argument "
-    //          "for map creation" );
-    //  }
-
-    // Get the user source and target memory spaces.
-    DTK_MemorySpace src_space =
-        reinterpret_cast<DataTransferKit::DTK_Registry *>( source )->_space;
-    DTK_MemorySpace tgt_space =
-        reinterpret_cast<DataTransferKit::DTK_Registry *>( target )->_space;
+    // So we only read the options with other compilers.
+#if !defined( __CUDACC_VER_MAJOR__ ) || __CUDACC_VER_MAJOR__ > 10
+    try
+    {
+        boost::property_tree::read_json( ss, ptree );
+    }
+    catch ( boost::property_tree::json_parser_error const & )
+    {
+        throw DataTransferKitException(
+            "Error while parsing JSON format in options string argument "
+            "for map creation" );
+    }
+#endif
+    return ptree;
+}
 
+//---------------------------------------------------------------------------//
+// Create a map of the given type in the requested execution space for user
+// applications in the given memory spaces.
+template <template <class, class, class> class MapType, class... Args>
+DTK_Map *createMapInSpaces( DTK_ExecutionSpace map_space,
+                            DTK_MemorySpace src_space,
+                            DTK_MemorySpace tgt_space, Args const &... args )
+{
     // Check up front that we have been asked for execution and memory spaces
     // that are available in the kokkos build. This lets use a little cleaner
     // macro logic below because we know we will get a valid map space
@@ -279,14 +933,12 @@ DTK_Map *createMap( DTK_ExecutionSpace map_space, MPI_Comm comm,
             switch ( tgt_space )
             {
             case DTK_HOST_SPACE:
-                map = new DTK_MapImpl<Serial, HostSpace, HostSpace>(
-                    comm, source, target, ptree );
+                map = new MapType<Serial, HostSpace, HostSpace>( args... );
                 break;
 
             case DTK_CUDAUVM_SPACE:
 #if defined( KOKKOS_ENABLE_CUDA )
-                map = new DTK_MapImpl<Serial, HostSpace, CudaUVMSpace>(
-                    comm, source, target, ptree );
+                map = new MapType<Serial, HostSpace, CudaUVMSpace>( args... );
 #endif
                 break;
             }
@@ -297,13 +949,12 @@ DTK_Map *createMap( DTK_ExecutionSpace map_space, MPI_Comm comm,
             switch ( tgt_space )
             {
             case DTK_HOST_SPACE:
-                map = new DTK_MapImpl<Serial, CudaUVMSpace, HostSpace>(
-                    comm, source, target, ptree );
+                map = new MapType<Serial, CudaUVMSpace, HostSpace>( args... );
                 break;
 
             case DTK_CUDAUVM_SPACE:
-                map = new DTK_MapImpl<Serial, CudaUVMSpace, CudaUVMSpace>(
-                    comm, source, target, ptree );
+                map = new MapType<Serial, CudaUVMSpace, CudaUVMSpace>(
+                    args... );
                 break;
             }
 #endif
@@ -320,14 +971,12 @@ DTK_Map *createMap( DTK_ExecutionSpace map_space, MPI_Comm comm,
             switch ( tgt_space )
             {
             case DTK_HOST_SPACE:
-                map = new DTK_MapImpl<OpenMP, HostSpace, HostSpace>(
-                    comm, source, target, ptree );
+                map = new MapType<OpenMP, HostSpace, HostSpace>( args... );
                 break;
 
             case DTK_CUDAUVM_SPACE:
 #if defined( KOKKOS_ENABLE_CUDA )
-                map = new DTK_MapImpl<OpenMP, HostSpace, CudaUVMSpace>(
-                    comm, source, target, ptree );
+                map = new MapType<OpenMP, HostSpace, CudaUVMSpace>( args... );
 #endif
                 break;
             }
@@ -338,13 +987,12 @@ DTK_Map *createMap( DTK_ExecutionSpace map_space, MPI_Comm comm,
             switch ( tgt_space )
             {
             case DTK_HOST_SPACE:
-                map = new DTK_MapImpl<OpenMP, CudaUVMSpace, HostSpace>(
-                    comm, source, target, ptree );
+                map = new MapType<OpenMP, CudaUVMSpace, HostSpace>( args... );
                 break;
 
             case DTK_CUDAUVM_SPACE:
-                map = new DTK_MapImpl<OpenMP, CudaUVMSpace, CudaUVMSpace>(
-                    comm, source, target, ptree );
+                map = new MapType<OpenMP, CudaUVMSpace, CudaUVMSpace>(
+                    args... );
                 break;
             }
 #endif
@@ -362,13 +1010,11 @@ DTK_Map *createMap( DTK_ExecutionSpace map_space, MPI_Comm comm,
             switch ( tgt_space )
             {
             case DTK_HOST_SPACE:
-                map = new DTK_MapImpl<Cuda, HostSpace, HostSpace>(
-                    comm, source, target, ptree );
+                map = new MapType<Cuda, HostSpace, HostSpace>( args... );
                 break;
 
             case DTK_CUDAUVM_SPACE:
-                map = new DTK_MapImpl<Cuda, HostSpace, CudaUVMSpace>(
-                    comm, source, target, ptree );
+                map = new MapType<Cuda, HostSpace, CudaUVMSpace>( args... );
                 break;
             }
 #endif
@@ -379,13 +1025,11 @@ DTK_Map *createMap( DTK_ExecutionSpace map_space, MPI_Comm comm,
             {
             case DTK_HOST_SPACE:
 #if defined( KOKKOS_ENABLE_SERIAL ) || defined( KOKKOS_ENABLE_OPENMP )
-                map = new DTK_MapImpl<Cuda, CudaUVMSpace, HostSpace>(
-                    comm, source, target, ptree );
+                map = new MapType<Cuda, CudaUVMSpace, HostSpace>( args... );
 #endif
                 break;
             case DTK_CUDAUVM_SPACE:
-                map = new DTK_MapImpl<Cuda, CudaUVMSpace, CudaUVMSpace>(
-                    comm, source, target, ptree );
+                map = new MapType<Cuda, CudaUVMSpace, CudaUVMSpace>( args... );
                 break;
             }
             break;
@@ -397,6 +1041,50 @@ DTK_Map *createMap( DTK_ExecutionSpace map_space, MPI_Comm comm,
     return map;
 }
 
+//---------------------------------------------------------------------------//
+// Create a map.
+DTK_Map *createMap( DTK_ExecutionSpace map_space, MPI_Comm comm,
+                    DTK_UserApplicationHandle source,
+                    DTK_UserApplicationHandle target, const char *options )
+{
+    auto const ptree = parseMapOptions( options );
+
+    // Get the user source and target memory spaces.
+    DTK_MemorySpace src_space =
+        reinterpret_cast<DataTransferKit::DTK_Registry *>( source )->_space;
+    DTK_MemorySpace tgt_space =
+        reinterpret_cast<DataTransferKit::DTK_Registry *>( target )->_space;
+
+    return createMapInSpaces<DTK_MapImpl>( map_space, src_space, tgt_space,
+                                           comm, source, target, ptree );
+}
+
+//---------------------------------------------------------------------------//
+// Create a group of maps from one source to several targets.
+DTK_Map *createMapGroup( DTK_ExecutionSpace map_space, MPI_Comm comm,
+                         DTK_UserApplicationHandle source,
+                         std::vector<DTK_UserApplicationHandle> const &targets,
+                         const char *options )
+{
+    auto const ptree = parseMapOptions( options );
+
+    // Get the user source and target memory spaces. All the targets must
+    // live in the same memory space.
+    DTK_INSIST( !targets.empty() );
+    DTK_MemorySpace src_space =
+        reinterpret_cast<DataTransferKit::DTK_Registry *>( source )->_space;
+    DTK_MemorySpace tgt_space =
+        reinterpret_cast<DataTransferKit::DTK_Registry *>( targets.front() )
+            ->_space;
+    for ( auto target : targets )
+        DTK_INSIST(
+            reinterpret_cast<DataTransferKit::DTK_Registry *>( target )
+                ->_space == tgt_space );
+
+    return createMapInSpaces<DTK_MapGroupImpl>(
+        map_space, src_space, tgt_space, comm, source, targets, ptree );
+}
+
 //---------------------------------------------------------------------------//
 
 } // namespace DataTransferKit
@@ -0,0 +1,106 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+/*!
+ * \file
+ * \brief Nodes on the boundary of a cell list.
+ */
+#ifndef DTK_SURFACE_NODES_HPP
+#define DTK_SURFACE_NODES_HPP
+
+#include <DTK_CellList.hpp>
+#include <DTK_CellTypes.h>
+#include <DTK_ConfigDefs.hpp>
+#include <DTK_DBC.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <Shards_BasicTopologies.hpp>
+#include <Shards_CellTopology.hpp>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace DataTransferKit
+{
+//---------------------------------------------------------------------------//
+// Canonical topology of the cells, which numbers the nodes of their faces.
+inline shards::CellTopology cellTopology( DTK_CellTopology topology )
+{
+    static std::array<shards::CellTopology, DTK_N_TOPO> const topologies = {
+        {shards::getCellTopologyData<shards::Triangle<3>>(),
+         shards::getCellTopologyData<shards::Triangle<6>>(),
+         shards::getCellTopologyData<shards::Quadrilateral<4>>(),
+         shards::getCellTopologyData<shards::Quadrilateral<9>>(),
+         shards::getCellTopologyData<shards::Tetrahedron<4>>(),
+         shards::getCellTopologyData<shards::Tetrahedron<10>>(),
+         shards::getCellTopologyData<shards::Tetrahedron<11>>(),
+         shards::getCellTopologyData<shards::Hexahedron<8>>(),
+         shards::getCellTopologyData<shards::Hexahedron<20>>(),
+         shards::getCellTopologyData<shards::Hexahedron<27>>(),
+         shards::getCellTopologyData<shards::Pyramid<5>>(),
+         shards::getCellTopologyData<shards::Pyramid<13>>(),
+         shards::getCellTopologyData<shards::Wedge<6>>(),
+         shards::getCellTopologyData<shards::Wedge<15>>(),
+         shards::getCellTopologyData<shards::Wedge<18>>()}};
+    DTK_REQUIRE( topology < DTK_N_TOPO );
+    return topologies[topology];
+}
+
+//---------------------------------------------------------------------------//
+// Local ids of the nodes on the boundary faces of a cell list, sorted and
+// without duplicates. The faces of 2D cells are their edges.
+template <class... ViewProperties>
+std::vector<int> surfaceNodes( CellList<ViewProperties...> const &cell_list )
+{
+    auto cells = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                      cell_list.cells );
+    auto cell_topologies = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), cell_list.cell_topologies );
+    auto boundary_cells = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), cell_list.boundary_cells );
+    auto cell_faces = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), cell_list.cell_faces_on_boundary );
+
+    // Position of the first node of every cell in the connectivity list.
+    int const n_cells = cell_topologies.extent( 0 );
+    std::vector<int> cell_offsets( n_cells + 1, 0 );
+    for ( int c = 0; c < n_cells; ++c )
+    {
+        auto const topology = cellTopology( cell_topologies( c ) );
+        cell_offsets[c + 1] = cell_offsets[c] + topology.getNodeCount();
+    }
+    DTK_INSIST( cell_offsets.back() == static_cast<int>( cells.extent( 0 ) ) );
+
+    std::vector<int> nodes;
+    for ( unsigned int f = 0; f < boundary_cells.extent( 0 ); ++f )
+    {
+        int const c = boundary_cells( f );
+        DTK_REQUIRE( c >= 0 && c < n_cells );
+        auto const topology = cellTopology( cell_topologies( c ) );
+        unsigned int const side_dim = topology.getDimension() - 1;
+        unsigned int const face = cell_faces( f );
+        DTK_INSIST( face < topology.getSubcellCount( side_dim ) );
+        for ( unsigned int k = 0; k < topology.getNodeCount( side_dim, face );
+              ++k )
+            nodes.push_back(
+                cells( cell_offsets[c] +
+                       topology.getNodeMap( side_dim, face, k ) ) );
+    }
+    std::sort( nodes.begin(), nodes.end() );
+    nodes.erase( std::unique( nodes.begin(), nodes.end() ), nodes.end() );
+    return nodes;
+}
+
+//---------------------------------------------------------------------------//
+} // namespace DataTransferKit
+
+#endif // DTK_SURFACE_NODES_HPP
@@ -0,0 +1,304 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+/*!
+ * \file   tstMapAllocations.cpp
+ * \brief  Allocations made when applying a map through the C API.
+ */
+//---------------------------------------------------------------------------//
+
+#include <DTK_C_API.h>
+#include <DTK_ParallelTraits.hpp>
+#include <DTK_Profiling.hpp>
+
+#include <Teuchos_UnitTestHarness.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <string>
+
+//---------------------------------------------------------------------------//
+// User implementation
+template <class Space>
+struct TestUserData
+{
+    Kokkos::View<double * [3], Space> coords;
+    Kokkos::View<double *, Space> field;
+
+    TestUserData( const int size )
+        : coords( "coords", size )
+        , field( "field", size )
+    {
+    }
+};
+
+template <class Space>
+void nodeListSize( void *user_data, unsigned *space_dim,
+                   size_t *local_num_nodes )
+{
+    auto data = static_cast<TestUserData<Space> *>( user_data );
+    *space_dim = data->coords.extent( 1 );
+    *local_num_nodes = data->coords.extent( 0 );
+}
+
+template <class Space>
+void nodeListData( void *user_data, Coordinate *coords )
+{
+    auto data = static_cast<TestUserData<Space> *>( user_data );
+    int const num_nodes = data->coords.extent( 0 );
+    for ( int n = 0; n < num_nodes; ++n )
+        for ( unsigned d = 0; d < data->coords.extent( 1 ); ++d )
+            coords[num_nodes * d + n] = data->coords( n, d );
+}
+
+template <class Space>
+void fieldSize( void *user_data, const char *, unsigned *field_dimension,
+                size_t *local_num_dofs )
+{
+    auto data = static_cast<TestUserData<Space> *>( user_data );
+    *field_dimension = 1;
+    *local_num_dofs = data->field.extent( 0 );
+}
+
+template <class Space>
+void pullField( void *user_data, const char *, double *field_dofs )
+{
+    auto data = static_cast<TestUserData<Space> *>( user_data );
+    for ( unsigned i = 0; i < data->field.extent( 0 ); ++i )
+        field_dofs[i] = data->field( i );
+}
+
+template <class Space>
+void pushField( void *user_data, const char *, const double *field_dofs )
+{
+    auto data = static_cast<TestUserData<Space> *>( user_data );
+    for ( unsigned i = 0; i < data->field.extent( 0 ); ++i )
+        data->field( i ) = field_dofs[i];
+}
+
+//---------------------------------------------------------------------------//
+// Test execution space enumeration selector.
+template <class Space>
+struct SpaceSelector;
+
+#if defined( KOKKOS_ENABLE_SERIAL )
+template <>
+struct SpaceSelector<DataTransferKit::Serial>
+{
+    static constexpr DTK_ExecutionSpace value() { return DTK_SERIAL; }
+};
+#endif
+
+#if defined( KOKKOS_ENABLE_OPENMP )
+template <>
+struct SpaceSelector<DataTransferKit::OpenMP>
+{
+    static constexpr DTK_ExecutionSpace value() { return DTK_OPENMP; }
+};
+#endif
+
+#if defined( KOKKOS_ENABLE_SERIAL ) || defined( KOKKOS_ENABLE_OPENMP )
+template <>
+struct SpaceSelector<DataTransferKit::HostSpace>
+{
+    static constexpr DTK_MemorySpace value() { return DTK_HOST_SPACE; }
+};
+#endif
+
+#if defined( KOKKOS_ENABLE_CUDA )
+template <>
+struct SpaceSelector<DataTransferKit::Cuda>
+{
+    static constexpr DTK_ExecutionSpace value() { return DTK_CUDA; }
+};
+
+template <>
+struct SpaceSelector<DataTransferKit::CudaUVMSpace>
+{
+    static constexpr DTK_MemorySpace value() { return DTK_CUDAUVM_SPACE; }
+};
+#endif
+
+//---------------------------------------------------------------------------//
+// Number of Kokkos allocations made by f. The allocations are seen through the
+// memory hooks of the profiler.
+template <typename Functor>
+long long countAllocations( Functor const &f )
+{
+    namespace Profiling = DataTransferKit::Profiling;
+    Profiling::reset();
+    Profiling::enable();
+    f();
+    Profiling::disable();
+    return Profiling::allocationCount();
+}
+
+//---------------------------------------------------------------------------//
+// Run the test. The fields are staged in the memory space of the map when the
+// applications live in a different one.
+template <class MapSpace, class SourceSpace, class TargetSpace>
+void test( bool &success, Teuchos::FancyOStream &out )
+{
+    // Initialize DTK. The test harness initializes kokkos already.
+    DTK_initialize();
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+
+    // The targets of a rank are the sources of another rank.
+    int const num_points = 100;
+    int const inverse_rank = comm_size - comm_rank - 1;
+    TestUserData<SourceSpace> src_data( num_points );
+    TestUserData<TargetSpace> tgt_data( num_points );
+    for ( int p = 0; p < num_points; ++p )
+    {
+        for ( int d = 0; d < 3; ++d )
+        {
+            src_data.coords( p, d ) = p + comm_rank * num_points;
+            tgt_data.coords( p, d ) = p + inverse_rank * num_points;
+        }
+        src_data.field( p ) = p + comm_rank * num_points;
+    }
+
+    auto src_handle =
+        DTK_createUserApplication( SpaceSelector<SourceSpace>::value() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( src_handle, DTK_NODE_LIST_SIZE_FUNCTION,
+                         ( void ( * )() ) & nodeListSize<SourceSpace>,
+                         &src_data );
+    DTK_setUserFunction( src_handle, DTK_NODE_LIST_DATA_FUNCTION,
+                         ( void ( * )() ) & nodeListData<SourceSpace>,
+                         &src_data );
+    DTK_setUserFunction( src_handle, DTK_FIELD_SIZE_FUNCTION,
+                         ( void ( * )() ) & fieldSize<SourceSpace>,
+                         &src_data );
+    DTK_setUserFunction( src_handle, DTK_PULL_FIELD_DATA_FUNCTION,
+                         ( void ( * )() ) & pullField<SourceSpace>,
+                         &src_data );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+
+    auto tgt_handle =
+        DTK_createUserApplication( SpaceSelector<TargetSpace>::value() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( tgt_handle, DTK_NODE_LIST_SIZE_FUNCTION,
+                         ( void ( * )() ) & nodeListSize<TargetSpace>,
+                         &tgt_data );
+    DTK_setUserFunction( tgt_handle, DTK_NODE_LIST_DATA_FUNCTION,
+                         ( void ( * )() ) & nodeListData<TargetSpace>,
+                         &tgt_data );
+    DTK_setUserFunction( tgt_handle, DTK_FIELD_SIZE_FUNCTION,
+                         ( void ( * )() ) & fieldSize<TargetSpace>,
+                         &tgt_data );
+    DTK_setUserFunction( tgt_handle, DTK_PUSH_FIELD_DATA_FUNCTION,
+                         ( void ( * )() ) & pushField<TargetSpace>,
+                         &tgt_data );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+
+    for ( std::string const options : {
+              R"({ "Map Type": "Nearest Neighbor" })",
+              R"({ "Map Type": "Moving Least Squares" })",
+          } )
+    {
+        auto map_handle =
+            DTK_createMap( SpaceSelector<MapSpace>::value(), comm, src_handle,
+                           tgt_handle, options.c_str() );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+
+        // The first application allocates the staging buffers. It is
+        // profiled so that the memory hooks are in place afterwards.
+        countAllocations(
+            [&]() { DTK_applyMap( map_handle, "dummy", "dummy" ); } );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        TEST_ASSERT( DataTransferKit::Profiling::tracksMemory() );
+
+        // Applying the map again to the same fields reuses them.
+        for ( int p = 0; p < num_points; ++p )
+            tgt_data.field( p ) = 0.;
+        TEST_EQUALITY( countAllocations( [&]() {
+                           DTK_applyMap( map_handle, "dummy", "dummy" );
+                       } ),
+                       0 );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DataTransferKit::Profiling::reset();
+
+        double const shift_from_zero = 3.14;
+        for ( int p = 0; p < num_points; ++p )
+            TEST_FLOATING_EQUALITY( tgt_data.field( p ) + shift_from_zero,
+                                    p + inverse_rank * num_points +
+                                        shift_from_zero,
+                                    1e-14 );
+
+        DTK_destroyMap( map_handle );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+    }
+
+    DTK_destroyUserApplication( src_handle );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_destroyUserApplication( tgt_handle );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+
+    DTK_finalize();
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+}
+
+//---------------------------------------------------------------------------//
+// TESTS
+//---------------------------------------------------------------------------//
+// The map options cannot be read when compiling with cuda 10, see
+// parseMapOptions().
+#if !defined( __CUDACC_VER_MAJOR__ ) || __CUDACC_VER_MAJOR__ > 10
+
+#if defined( KOKKOS_ENABLE_SERIAL )
+TEUCHOS_UNIT_TEST( MapAllocations, Serial )
+{
+    test<DataTransferKit::Serial, DataTransferKit::HostSpace,
+         DataTransferKit::HostSpace>( success, out );
+}
+#endif
+
+//---------------------------------------------------------------------------//
+#if defined( KOKKOS_ENABLE_OPENMP )
+TEUCHOS_UNIT_TEST( MapAllocations, OpenMP )
+{
+    test<DataTransferKit::OpenMP, DataTransferKit::HostSpace,
+         DataTransferKit::HostSpace>( success, out );
+}
+#endif
+
+//---------------------------------------------------------------------------//
+#if defined( KOKKOS_ENABLE_CUDA )
+TEUCHOS_UNIT_TEST( MapAllocations, Cuda )
+{
+    test<DataTransferKit::Cuda, DataTransferKit::CudaUVMSpace,
+         DataTransferKit::CudaUVMSpace>( success, out );
+}
+#endif
+
+//---------------------------------------------------------------------------//
+#if defined( KOKKOS_ENABLE_SERIAL ) && defined( KOKKOS_ENABLE_CUDA )
+TEUCHOS_UNIT_TEST( MapAllocations, SerialAndCuda )
+{
+    test<DataTransferKit::Serial, DataTransferKit::CudaUVMSpace,
+         DataTransferKit::HostSpace>( success, out );
+
+    test<DataTransferKit::Serial, DataTransferKit::HostSpace,
+         DataTransferKit::CudaUVMSpace>( success, out );
+}
+#endif
+
+#endif
+
+//---------------------------------------------------------------------------//
+// end tstMapAllocations.cpp
+//---------------------------------------------------------------------------//
@@ -86,6 +86,142 @@ void pushField( void *user_data, const char *, const double *field_dofs )
         data->field( i ) = field_dofs[i];
 }
 
+//---------------------------------------------------------------------------//
+// Mesh for the surface maps: a strip of n hexahedra of unit size along the X
+// axis starting at origin. Only the top faces, at z = 1, are registered as
+// the boundary, so that the nodes at z = 0 are away from the surface.
+template <class Space>
+struct SurfaceUserData
+{
+    int num_cells;
+    Kokkos::View<double * [3], Space> coords;
+    Kokkos::View<double *, Space> field;
+
+    SurfaceUserData( int n, double origin )
+        : num_cells( n )
+        , coords( "coords", 4 * ( n + 1 ) )
+        , field( "field", 4 * ( n + 1 ) )
+    {
+        for ( int k = 0; k < 2; ++k )
+            for ( int j = 0; j < 2; ++j )
+                for ( int i = 0; i <= n; ++i )
+                {
+                    int const node = this->node( i, j, k );
+                    coords( node, 0 ) = origin + i;
+                    coords( node, 1 ) = j;
+                    coords( node, 2 ) = k;
+                }
+    }
+
+    int node( int i, int j, int k ) const
+    {
+        return i + ( num_cells + 1 ) * ( j + 2 * k );
+    }
+};
+
+template <class Space>
+void cellListSize( void *user_data, unsigned *space_dim,
+                   size_t *local_num_nodes, size_t *local_num_cells,
+                   size_t *total_cell_nodes )
+{
+    auto data = static_cast<SurfaceUserData<Space> *>( user_data );
+    *space_dim = 3;
+    *local_num_nodes = data->coords.extent( 0 );
+    *local_num_cells = data->num_cells;
+    *total_cell_nodes = 8 * data->num_cells;
+}
+
+template <class Space>
+void cellListData( void *user_data, Coordinate *coordinates,
+                   LocalOrdinal *cells, DTK_CellTopology *cell_topologies )
+{
+    auto data = static_cast<SurfaceUserData<Space> *>( user_data );
+    int const num_nodes = data->coords.extent( 0 );
+    for ( int n = 0; n < num_nodes; ++n )
+        for ( int d = 0; d < 3; ++d )
+            coordinates[num_nodes * d + n] = data->coords( n, d );
+    // Nodes of the hexahedra in the canonical order.
+    for ( int c = 0; c < data->num_cells; ++c )
+    {
+        int const corners[8][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0},
+                                   {0, 1, 0}, {0, 0, 1}, {1, 0, 1},
+                                   {1, 1, 1}, {0, 1, 1}};
+        for ( int v = 0; v < 8; ++v )
+            cells[8 * c + v] = data->node( c + corners[v][0], corners[v][1],
+                                           corners[v][2] );
+        cell_topologies[c] = DTK_HEX_8;
+    }
+}
+
+template <class Space>
+void boundarySize( void *user_data, size_t *local_num_faces )
+{
+    auto data = static_cast<SurfaceUserData<Space> *>( user_data );
+    *local_num_faces = data->num_cells;
+}
+
+template <class Space>
+void boundaryData( void *user_data, LocalOrdinal *boundary_cells,
+                   unsigned *cell_faces_on_boundary )
+{
+    auto data = static_cast<SurfaceUserData<Space> *>( user_data );
+    for ( int c = 0; c < data->num_cells; ++c )
+    {
+        boundary_cells[c] = c;
+        // Face 5 of a hexahedron is made of its nodes at z = 1.
+        cell_faces_on_boundary[c] = 5;
+    }
+}
+
+template <class Space>
+void surfaceFieldSize( void *user_data, const char *,
+                       unsigned *field_dimension, size_t *local_num_dofs )
+{
+    auto data = static_cast<SurfaceUserData<Space> *>( user_data );
+    *field_dimension = 1;
+    *local_num_dofs = data->field.extent( 0 );
+}
+
+template <class Space>
+void surfacePullField( void *user_data, const char *, double *field_dofs )
+{
+    auto data = static_cast<SurfaceUserData<Space> *>( user_data );
+    for ( unsigned i = 0; i < data->field.extent( 0 ); ++i )
+        field_dofs[i] = data->field( i );
+}
+
+template <class Space>
+void surfacePushField( void *user_data, const char *,
+                       const double *field_dofs )
+{
+    auto data = static_cast<SurfaceUserData<Space> *>( user_data );
+    for ( unsigned i = 0; i < data->field.extent( 0 ); ++i )
+        data->field( i ) = field_dofs[i];
+}
+
+template <class Space>
+DTK_UserApplicationHandle
+createSurfaceApplication( DTK_MemorySpace space,
+                          SurfaceUserData<Space> *data )
+{
+    auto handle = DTK_createUserApplication( space );
+    DTK_setUserFunction( handle, DTK_CELL_LIST_SIZE_FUNCTION,
+                         ( void ( * )() ) & cellListSize<Space>, data );
+    DTK_setUserFunction( handle, DTK_CELL_LIST_DATA_FUNCTION,
+                         ( void ( * )() ) & cellListData<Space>, data );
+    DTK_setUserFunction( handle, DTK_BOUNDARY_SIZE_FUNCTION,
+                         ( void ( * )() ) & boundarySize<Space>, data );
+    DTK_setUserFunction( handle, DTK_BOUNDARY_DATA_FUNCTION,
+                         ( void ( * )() ) & boundaryData<Space>, data );
+    DTK_setUserFunction( handle, DTK_FIELD_SIZE_FUNCTION,
+                         ( void ( * )() ) & surfaceFieldSize<Space>, data );
+    DTK_setUserFunction( handle, DTK_PULL_FIELD_DATA_FUNCTION,
+                         ( void ( * )() ) & surfacePullField<Space>, data );
+    DTK_setUserFunction( handle, DTK_PUSH_FIELD_DATA_FUNCTION,
+                         ( void ( * )() ) & surfacePushField<Space>, data );
+    return handle;
+}
+
 //---------------------------------------------------------------------------//
 // Test execution space enumeration selector.
 template <class Space>
@@ -129,6 +265,71 @@ struct SpaceSelector<DataTransferKit::CudaUVMSpace>
 };
 #endif
 
+//---------------------------------------------------------------------------//
+// Transfer between the top faces of two strips of hexahedra. The target
+// strip of a rank lies over the source strip of another rank so that the
+// nearest neighbor map reproduces the source field on the target surface,
+// while the target values away from the surface are left unchanged.
+template <class MapSpace, class SourceSpace, class TargetSpace>
+void testSurfaceOnly( MPI_Comm comm, bool &success,
+                      Teuchos::FancyOStream &out )
+{
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+    int const inverse_rank = comm_size - comm_rank - 1;
+
+    int const n = 10;
+    SurfaceUserData<SourceSpace> src_data( n, n * comm_rank );
+    SurfaceUserData<TargetSpace> tgt_data( n, n * inverse_rank );
+    auto const f = []( double x, double y, double z ) {
+        return 1. + x + 10. * y + 100. * z;
+    };
+    int const num_nodes = 4 * ( n + 1 );
+    for ( int p = 0; p < num_nodes; ++p )
+    {
+        src_data.field( p ) = f( src_data.coords( p, 0 ),
+                                 src_data.coords( p, 1 ),
+                                 src_data.coords( p, 2 ) );
+        tgt_data.field( p ) = -1.;
+    }
+
+    auto src_handle = createSurfaceApplication(
+        SpaceSelector<SourceSpace>::value(), &src_data );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    auto tgt_handle = createSurfaceApplication(
+        SpaceSelector<TargetSpace>::value(), &tgt_data );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+
+    auto map_handle = DTK_createMap(
+        SpaceSelector<MapSpace>::value(), comm, src_handle, tgt_handle,
+        R"({ "Map Type": "Nearest Neighbor", "Surface Only": true })" );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+
+    DTK_applyMap( map_handle, "surface", "surface" );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+
+    for ( int p = 0; p < num_nodes; ++p )
+    {
+        double const z = tgt_data.coords( p, 2 );
+        if ( z == 1. )
+            TEST_FLOATING_EQUALITY(
+                tgt_data.field( p ),
+                f( tgt_data.coords( p, 0 ), tgt_data.coords( p, 1 ), z ),
+                1e-14 );
+        else
+            TEST_EQUALITY( tgt_data.field( p ), -1. );
+    }
+
+    DTK_destroyMap( map_handle );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_destroyUserApplication( src_handle );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_destroyUserApplication( tgt_handle );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+}
+
 //---------------------------------------------------------------------------//
 // Run the test.
 template <class MapSpace, class SourceSpace, class TargetSpace>
@@ -142,6 +343,12 @@ void test( bool &success, Teuchos::FancyOStream &out )
     DTK_MapHandle bad_handle = nullptr;
     DTK_applyMap( bad_handle, "bad", "bad" );
     TEST_EQUALITY( errno, DTK_INVALID_HANDLE );
+    const char *bad_fields[] = {"bad"};
+    DTK_applyMapBatch( bad_handle, 1, bad_fields, bad_fields );
+    TEST_EQUALITY( errno, DTK_INVALID_HANDLE );
+    DTK_MapStatistics bad_statistics;
+    DTK_getMapStatistics( bad_handle, &bad_statistics );
+    TEST_EQUALITY( errno, DTK_INVALID_HANDLE );
     DTK_destroyMap( bad_handle );
     TEST_EQUALITY( errno, DTK_INVALID_HANDLE );
 
@@ -280,6 +487,11 @@ void test( bool &success, Teuchos::FancyOStream &out )
         DTK_applyMap( map_handle, "dummy", "dummy" );
         TEST_EQUALITY( errno, DTK_SUCCESS );
 
+        DTK_MapStatistics statistics;
+        DTK_getMapStatistics( map_handle, &statistics );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        TEST_EQUALITY( statistics.num_targets, num_point );
+
         double const relative_tolerance = 1e-14;
         // NOTE adding the same value to both lhs and rhs to resolve floating
         // point comparison issues with zero using Teuchos assertion macro
@@ -292,14 +504,55 @@ void test( bool &success, Teuchos::FancyOStream &out )
                                     relative_tolerance );
         }
 
+        // Transfer the same field twice in a single batch.
+        for ( int p = 0; p < num_point; ++p )
+            tgt_data->field( p ) = 0.0;
+        const char *fields[] = {"dummy", "dummy"};
+        DTK_applyMapBatch( map_handle, 2, fields, fields );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        for ( int p = 0; p < num_point; ++p )
+        {
+            TEST_FLOATING_EQUALITY( tgt_data->field( p ) + shift_from_zero,
+                                    1.0 * p + inverse_rank * num_point +
+                                        shift_from_zero,
+                                    relative_tolerance );
+        }
+
         DTK_destroyMap( map_handle );
         TEST_EQUALITY( errno, DTK_SUCCESS );
+
+        // Same transfer with a group of maps sharing the source exchange.
+        DTK_UserApplicationHandle tgt_handles[] = {tgt_handle, tgt_handle};
+        auto group_handle = DTK_createMapGroup(
+            SpaceSelector<MapSpace>::value(), comm, src_handle, 2,
+            tgt_handles, options.c_str() );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        for ( int p = 0; p < num_point; ++p )
+            tgt_data->field( p ) = 0.0;
+        DTK_applyMapGroup( group_handle, "dummy", fields );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_MapStatistics group_statistics;
+        DTK_getMapStatistics( group_handle, &group_statistics );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        TEST_EQUALITY( group_statistics.num_targets, 2 * num_point );
+        for ( int p = 0; p < num_point; ++p )
+        {
+            TEST_FLOATING_EQUALITY( tgt_data->field( p ) + shift_from_zero,
+                                    1.0 * p + inverse_rank * num_point +
+                                        shift_from_zero,
+                                    relative_tolerance );
+        }
+        DTK_destroyMap( group_handle );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
     }
 
     DTK_destroyUserApplication( src_handle );
     TEST_EQUALITY( errno, DTK_SUCCESS );
     DTK_destroyUserApplication( tgt_handle );
     TEST_EQUALITY( errno, DTK_SUCCESS );
+
+    testSurfaceOnly<MapSpace, SourceSpace, TargetSpace>( comm, success, out );
+
     DTK_finalize();
     TEST_EQUALITY( errno, DTK_SUCCESS );
 }
@@ -0,0 +1,348 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+/*!
+ * \file
+ * \brief Micro-benchmarks of the kernels of the moving least squares operator.
+ *
+ * Every kernel is timed on a batch of stencils of the same size, built from
+ * random source points around the target, which is at the origin. The first
+ * argument of a benchmark is the number of stencils and the second one the
+ * number of source points per stencil. The "matrices/s" counter is the number
+ * of stencils processed per second and bytes_per_second is the minimum
+ * memory traffic of the kernel, i.e. every input read and every output
+ * written once.
+ */
+
+#include <DTK_CompactlySupportedRadialBasisFunctions.hpp>
+#include <DTK_ConfigDefs.hpp>
+#include <DTK_DBC.hpp>
+#include <DTK_DetailsMovingLeastSquaresOperatorImpl.hpp>
+#include <DTK_DetailsSVDImpl.hpp>
+#include <DTK_MultivariatePolynomialBasis.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+using DataTransferKit::Coordinate;
+
+template <typename DeviceType>
+using Impl = DataTransferKit::Details::MovingLeastSquaresOperatorImpl<
+    DeviceType>;
+
+int const batch_counts[] = {1 << 10, 1 << 14, 1 << 17};
+
+// Stencils and the intermediate results of the kernels, each kernel is timed
+// on the output of the previous ones.
+template <typename DeviceType>
+struct Problem
+{
+    Kokkos::View<int *, DeviceType> offset;
+    Kokkos::View<Coordinate **, DeviceType> points;
+    Kokkos::View<double *, DeviceType> radius;
+    Kokkos::View<double *, DeviceType> phi;
+    Kokkos::View<double *, DeviceType> p;
+    Kokkos::View<double *, DeviceType> moments;
+    Kokkos::View<double *, DeviceType> inv_moments;
+    Kokkos::View<double *, DeviceType> coeffs;
+};
+
+template <typename DeviceType, typename PolynomialBasis>
+Problem<DeviceType> makeProblem( int n_stencils, int stencil_size, int dim )
+{
+    int const n_points = n_stencils * stencil_size;
+    Problem<DeviceType> problem;
+    problem.offset =
+        Kokkos::View<int *, DeviceType>( "offset", n_stencils + 1 );
+    problem.points =
+        Kokkos::View<Coordinate **, DeviceType>( "points", n_points, 3 );
+    auto offset_host = Kokkos::create_mirror_view( problem.offset );
+    auto points_host = Kokkos::create_mirror_view( problem.points );
+    for ( int i = 0; i <= n_stencils; ++i )
+        offset_host( i ) = i * stencil_size;
+    std::mt19937 generator( 0 );
+    std::uniform_real_distribution<Coordinate> distribution( -1., 1. );
+    for ( int j = 0; j < n_points; ++j )
+        for ( int d = 0; d < 3; ++d )
+            points_host( j, d ) = d < dim ? distribution( generator ) : 0.;
+    Kokkos::deep_copy( problem.offset, offset_host );
+    Kokkos::deep_copy( problem.points, points_host );
+
+    problem.radius =
+        Impl<DeviceType>::computeRadius( problem.points, problem.offset );
+    problem.phi = Impl<DeviceType>::computeWeights(
+        problem.points, problem.radius, DataTransferKit::Wendland<0>() );
+    problem.p = Impl<DeviceType>::computeVandermonde( problem.points,
+                                                      PolynomialBasis() );
+    problem.moments = Impl<DeviceType>::computeMoments(
+        problem.offset, problem.p, problem.phi );
+    problem.inv_moments = std::get<0>( Impl<DeviceType>::invertMoments(
+        problem.moments, PolynomialBasis::size ) );
+    problem.coeffs = Impl<DeviceType>::computePolynomialCoefficients(
+        problem.offset, problem.inv_moments, problem.p, problem.phi,
+        PolynomialBasis::size );
+    Kokkos::fence();
+    return problem;
+}
+
+void setCounters( benchmark::State &state, long long bytes_per_batch )
+{
+    state.counters["matrices/s"] =
+        benchmark::Counter( static_cast<double>( state.iterations() ) *
+                                state.range( 0 ),
+                            benchmark::Counter::kIsRate );
+    state.SetBytesProcessed( state.iterations() * bytes_per_batch );
+}
+
+template <typename DeviceType, typename PolynomialBasis, int DIM>
+void benchVandermonde( benchmark::State &state )
+{
+    int const n = state.range( 0 ) * state.range( 1 );
+    auto const problem = makeProblem<DeviceType, PolynomialBasis>(
+        state.range( 0 ), state.range( 1 ), DIM );
+    for ( auto _ : state )
+    {
+        auto p = Impl<DeviceType>::computeVandermonde( problem.points,
+                                                       PolynomialBasis() );
+        Kokkos::fence();
+        benchmark::DoNotOptimize( p.data() );
+    }
+    setCounters( state, sizeof( double ) * n * ( 3 + PolynomialBasis::size ) );
+}
+
+template <typename DeviceType, typename RBF>
+void benchWeights( benchmark::State &state )
+{
+    int const n = state.range( 0 ) * state.range( 1 );
+    auto const problem =
+        makeProblem<DeviceType,
+                    DataTransferKit::MultivariatePolynomialBasis<
+                        DataTransferKit::Constant, 3>>( state.range( 0 ),
+                                                        state.range( 1 ), 3 );
+    for ( auto _ : state )
+    {
+        auto phi = Impl<DeviceType>::computeWeights(
+            problem.points, problem.radius, RBF() );
+        benchmark::DoNotOptimize( phi.data() );
+    }
+    setCounters( state, sizeof( double ) * n * ( 3 + 1 + 1 ) );
+}
+
+template <typename DeviceType, typename PolynomialBasis, int DIM>
+void benchMoments( benchmark::State &state )
+{
+    int const n_stencils = state.range( 0 );
+    int const n = n_stencils * state.range( 1 );
+    int const size = PolynomialBasis::size;
+    auto const problem = makeProblem<DeviceType, PolynomialBasis>(
+        n_stencils, state.range( 1 ), DIM );
+    for ( auto _ : state )
+    {
+        auto a = Impl<DeviceType>::computeMoments( problem.offset, problem.p,
+                                                   problem.phi );
+        benchmark::DoNotOptimize( a.data() );
+    }
+    setCounters( state, sizeof( double ) * ( n * ( size + 1 ) +
+                                             n_stencils * size * size ) +
+                            sizeof( int ) * ( n_stencils + 1 ) );
+}
+
+template <typename DeviceType, typename PolynomialBasis, int DIM>
+void benchInvertMoments( benchmark::State &state )
+{
+    int const n_stencils = state.range( 0 );
+    int const size = PolynomialBasis::size;
+    auto const problem = makeProblem<DeviceType, PolynomialBasis>(
+        n_stencils, state.range( 1 ), DIM );
+    for ( auto _ : state )
+    {
+        auto t = Impl<DeviceType>::invertMoments( problem.moments, size );
+        Kokkos::fence();
+        benchmark::DoNotOptimize( std::get<0>( t ).data() );
+    }
+    setCounters( state, sizeof( double ) * n_stencils * size * size * 2 );
+}
+
+// Same as above without the allocation of the pseudo-inverses and of the
+// workspace, to time the decomposition alone.
+template <typename DeviceType, typename PolynomialBasis, int DIM>
+void benchSVD( benchmark::State &state )
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+    int const n_stencils = state.range( 0 );
+    int const size = PolynomialBasis::size;
+    auto const problem = makeProblem<DeviceType, PolynomialBasis>(
+        n_stencils, state.range( 1 ), DIM );
+    Kokkos::View<double *, DeviceType> inv_a( "inv_a",
+                                              problem.moments.extent( 0 ) );
+    Kokkos::View<double **, DeviceType> aux( "aux", size,
+                                             3 * n_stencils * size );
+    DataTransferKit::Details::SVDFunctor<DeviceType> svd(
+        size, problem.moments, inv_a, aux );
+    for ( auto _ : state )
+    {
+        size_t num_underdetermined = 0;
+        Kokkos::parallel_reduce(
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_stencils ), svd,
+            num_underdetermined );
+        benchmark::DoNotOptimize( num_underdetermined );
+    }
+    setCounters( state, sizeof( double ) * n_stencils * size * size * 2 );
+}
+
+template <typename DeviceType, typename PolynomialBasis, int DIM>
+void benchPolynomialCoefficients( benchmark::State &state )
+{
+    int const n_stencils = state.range( 0 );
+    int const n = n_stencils * state.range( 1 );
+    int const size = PolynomialBasis::size;
+    auto const problem = makeProblem<DeviceType, PolynomialBasis>(
+        n_stencils, state.range( 1 ), DIM );
+    for ( auto _ : state )
+    {
+        auto coeffs = Impl<DeviceType>::computePolynomialCoefficients(
+            problem.offset, problem.inv_moments, problem.p, problem.phi,
+            size );
+        Kokkos::fence();
+        benchmark::DoNotOptimize( coeffs.data() );
+    }
+    // Only the first row of the pseudo-inverses is read.
+    setCounters( state, sizeof( double ) *
+                                ( n * ( size + 2 ) + n_stencils * size ) +
+                            sizeof( int ) * ( n_stencils + 1 ) );
+}
+
+template <typename DeviceType>
+void benchTargetValues( benchmark::State &state )
+{
+    int const n_stencils = state.range( 0 );
+    int const n = n_stencils * state.range( 1 );
+    auto const problem =
+        makeProblem<DeviceType,
+                    DataTransferKit::MultivariatePolynomialBasis<
+                        DataTransferKit::Linear, 3>>( n_stencils,
+                                                      state.range( 1 ), 3 );
+    Kokkos::View<double *, DeviceType> source_values( "source_values", n );
+    Kokkos::deep_copy( source_values, 1. );
+    Kokkos::View<double *, DeviceType> target_values( "target_values",
+                                                      n_stencils );
+    for ( auto _ : state )
+    {
+        Impl<DeviceType>::computeTargetValues(
+            problem.offset, problem.coeffs, source_values, target_values );
+        benchmark::DoNotOptimize( target_values.data() );
+    }
+    setCounters( state, sizeof( double ) * ( 2 * n + n_stencils ) +
+                            sizeof( int ) * ( n_stencils + 1 ) );
+}
+
+// Run a benchmark over the batch counts and the given stencil sizes.
+void registerBenchmark( std::string const &name,
+                        void ( *function )( benchmark::State & ),
+                        std::vector<int> const &stencil_sizes )
+{
+    auto registered = benchmark::RegisterBenchmark( name.c_str(), function );
+    for ( int n_stencils : batch_counts )
+        for ( int stencil_size : stencil_sizes )
+            registered->Args( {n_stencils, stencil_size} );
+    registered->Unit( benchmark::kMicrosecond )->UseRealTime();
+}
+
+// The stencils have as many points as the polynomial basis, which is the
+// size used by the operator, and a few times more.
+template <typename DeviceType, typename Basis, int DIM>
+void registerBasis( std::string const &space, std::string const &basis )
+{
+    using PolynomialBasis =
+        DataTransferKit::MultivariatePolynomialBasis<Basis, DIM>;
+    int const size = PolynomialBasis::size;
+    std::vector<int> const stencil_sizes = {size, 2 * size, 4 * size};
+    std::string const suffix = "<" + space + "," + basis + ">";
+    registerBenchmark( "Vandermonde" + suffix,
+                       benchVandermonde<DeviceType, PolynomialBasis, DIM>,
+                       stencil_sizes );
+    registerBenchmark( "Moments" + suffix,
+                       benchMoments<DeviceType, PolynomialBasis, DIM>,
+                       stencil_sizes );
+    registerBenchmark( "InvertMoments" + suffix,
+                       benchInvertMoments<DeviceType, PolynomialBasis, DIM>,
+                       stencil_sizes );
+    registerBenchmark( "SVD" + suffix,
+                       benchSVD<DeviceType, PolynomialBasis, DIM>,
+                       stencil_sizes );
+    registerBenchmark(
+        "PolynomialCoefficients" + suffix,
+        benchPolynomialCoefficients<DeviceType, PolynomialBasis, DIM>,
+        stencil_sizes );
+}
+
+template <typename DeviceType>
+void registerBenchmarks( std::string const &space )
+{
+    using DataTransferKit::Buhmann;
+    using DataTransferKit::Constant;
+    using DataTransferKit::Linear;
+    using DataTransferKit::Quadratic;
+    using DataTransferKit::Wendland;
+    using DataTransferKit::Wu;
+
+    registerBasis<DeviceType, Constant, 2>( space, "Constant2D" );
+    registerBasis<DeviceType, Linear, 2>( space, "Linear2D" );
+    registerBasis<DeviceType, Quadratic, 2>( space, "Quadratic2D" );
+    registerBasis<DeviceType, Constant, 3>( space, "Constant3D" );
+    registerBasis<DeviceType, Linear, 3>( space, "Linear3D" );
+    registerBasis<DeviceType, Quadratic, 3>( space, "Quadratic3D" );
+
+    std::vector<int> const stencil_sizes = {4, 10, 40};
+    std::string const prefix = "Weights<" + space + ",";
+    registerBenchmark( prefix + "Wendland<0>>",
+                       benchWeights<DeviceType, Wendland<0>>, stencil_sizes );
+    registerBenchmark( prefix + "Wendland<2>>",
+                       benchWeights<DeviceType, Wendland<2>>, stencil_sizes );
+    registerBenchmark( prefix + "Wu<2>>", benchWeights<DeviceType, Wu<2>>,
+                       stencil_sizes );
+    registerBenchmark( prefix + "Buhmann<3>>",
+                       benchWeights<DeviceType, Buhmann<3>>, stencil_sizes );
+    registerBenchmark( "TargetValues<" + space + ">",
+                       benchTargetValues<DeviceType>, stencil_sizes );
+}
+} // namespace
+
+int main( int argc, char *argv[] )
+{
+    Kokkos::initialize( argc, argv );
+    benchmark::Initialize( &argc, argv );
+    if ( benchmark::ReportUnrecognizedArguments( argc, argv ) )
+    {
+        Kokkos::finalize();
+        return 1;
+    }
+
+#ifdef KOKKOS_ENABLE_SERIAL
+    registerBenchmarks<Kokkos::Device<Kokkos::Serial, Kokkos::HostSpace>>(
+        "Serial" );
+#endif
+#ifdef KOKKOS_ENABLE_OPENMP
+    registerBenchmarks<Kokkos::Device<Kokkos::OpenMP, Kokkos::HostSpace>>(
+        "OpenMP" );
+#endif
+
+    benchmark::RunSpecifiedBenchmarks();
+    Kokkos::finalize();
+    return 0;
+}
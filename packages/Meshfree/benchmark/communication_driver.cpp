@@ -0,0 +1,393 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+/*!
+ * \file
+ * \brief Time the communication of the point cloud operators on synthetic
+ * request patterns.
+ *
+ * Every rank requests the same number of entries (rank, index) of the values
+ * owned by the ranks, following one of the patterns:
+ *  - halo: a fraction of the requests goes to the previous and the next rank,
+ *    the others are local;
+ *  - all-to-all: the owner of every request is chosen at random;
+ *  - hot spot: half of the requests go to rank 0, the others to a random
+ *    rank;
+ *  - one-to-many: all the requests go to rank 0.
+ *
+ * For values with one column and with several columns, the driver times
+ * pullSourceValues(), which sends the requests to the owners,
+ * pushTargetValues(), which sends the values back, and the whole fetch() of
+ * NearestNeighborOperatorImpl, followed by the setup and fetch() of the
+ * persistent CommunicationPlan used by the operators. The latency is the time
+ * of a call, averaged over the ranks and on the slowest rank. The bandwidth
+ * is the number of bytes sent to other ranks by all the ranks divided by the
+ * time of the slowest rank and by the number of ranks, counting 12 bytes per
+ * request for the pull (two indices and a rank), 8 bytes per value and 4 per
+ * index for the push, 4 bytes per request for the setup of the plan and 8
+ * bytes per value for its fetch().
+ *
+ * The latencies are appended to a CSV file read by
+ * scripts/performance_plot.py, labeled by default with the number of ranks.
+ */
+
+#include <DTK_DetailsCommunicationPlan.hpp>
+#include <DTK_DetailsNearestNeighborOperatorImpl.hpp>
+#include <DTK_Version.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <Teuchos_GlobalMPISession.hpp>
+
+#include <mpi.h>
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <getopt.h>
+
+using DeviceType = Kokkos::View<DataTransferKit::Coordinate **>::device_type;
+using ExecutionSpace = DeviceType::execution_space;
+using Impl = DataTransferKit::Details::NearestNeighborOperatorImpl<DeviceType>;
+using Plan = DataTransferKit::Details::CommunicationPlan<DeviceType>;
+
+enum class Pattern
+{
+    Halo,
+    AllToAll,
+    HotSpot,
+    OneToMany
+};
+
+int const n_operations = 5;
+char const *operation_names[n_operations] = {
+    "pullSourceValues", "pushTargetValues", "fetch", "plan setup",
+    "plan fetch"};
+
+//---------------------------------------------------------------------------//
+// Owning ranks and indices of the entries requested by this rank.
+std::pair<Kokkos::View<int *, DeviceType>, Kokkos::View<int *, DeviceType>>
+makeRequests( MPI_Comm comm, Pattern pattern, int n_requests, int n_values,
+              double halo_fraction, unsigned int seed )
+{
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+
+    Kokkos::View<int *, DeviceType> ranks( "ranks", n_requests );
+    Kokkos::View<int *, DeviceType> indices( "indices", n_requests );
+    auto ranks_host = Kokkos::create_mirror_view( ranks );
+    auto indices_host = Kokkos::create_mirror_view( indices );
+    std::mt19937 generator( seed + comm_rank );
+    std::uniform_real_distribution<double> uniform( 0., 1. );
+    std::uniform_int_distribution<int> random_rank( 0, comm_size - 1 );
+    std::uniform_int_distribution<int> random_index( 0, n_values - 1 );
+    for ( int i = 0; i < n_requests; ++i )
+    {
+        double const u = uniform( generator );
+        switch ( pattern )
+        {
+        case Pattern::Halo:
+            if ( u < 0.5 * halo_fraction )
+                ranks_host( i ) = ( comm_rank + comm_size - 1 ) % comm_size;
+            else if ( u < halo_fraction )
+                ranks_host( i ) = ( comm_rank + 1 ) % comm_size;
+            else
+                ranks_host( i ) = comm_rank;
+            break;
+        case Pattern::AllToAll:
+            ranks_host( i ) = random_rank( generator );
+            break;
+        case Pattern::HotSpot:
+            ranks_host( i ) = u < 0.5 ? 0 : random_rank( generator );
+            break;
+        case Pattern::OneToMany:
+            ranks_host( i ) = 0;
+            break;
+        }
+        indices_host( i ) = random_index( generator );
+    }
+    Kokkos::deep_copy( ranks, ranks_host );
+    Kokkos::deep_copy( indices, indices_host );
+    return std::make_pair( ranks, indices );
+}
+
+//---------------------------------------------------------------------------//
+// Time of a call on this rank, in seconds.
+template <typename Function>
+double localElapsed( MPI_Comm comm, Function const &function )
+{
+    MPI_Barrier( comm );
+    double const start = MPI_Wtime();
+    function();
+    Kokkos::fence();
+    return MPI_Wtime() - start;
+}
+
+//---------------------------------------------------------------------------//
+// View of n rows with n_columns columns if it has rank 2.
+template <typename View>
+View makeView( std::string const &label, int n, int n_columns )
+{
+    return View::rank == 1 ? View( label, n ) : View( label, n, n_columns );
+}
+
+//---------------------------------------------------------------------------//
+// Average time of each operation on this rank, in seconds.
+template <typename View>
+std::array<double, n_operations>
+timeOperations( MPI_Comm comm, int repetitions,
+                Kokkos::View<int *, DeviceType> ranks,
+                Kokkos::View<int *, DeviceType> indices, View values )
+{
+    int const n_requests = ranks.extent( 0 );
+    int const n_columns = values.extent( 1 );
+    std::array<double, n_operations> times;
+    times.fill( 0. );
+
+    // pullSourceValues() replaces the indices and the ranks by the ones of
+    // the requests received, which pushTargetValues() sends back.
+    Kokkos::View<int *, DeviceType> buffer_indices;
+    Kokkos::View<int *, DeviceType> buffer_ranks;
+    View buffer_values;
+    for ( int r = 0; r < repetitions; ++r )
+    {
+        buffer_indices = Kokkos::View<int *, DeviceType>( "buffer_indices",
+                                                          n_requests );
+        Kokkos::deep_copy( buffer_indices, indices );
+        buffer_ranks =
+            Kokkos::View<int *, DeviceType>( "buffer_ranks", n_requests );
+        Kokkos::deep_copy( buffer_ranks, ranks );
+        buffer_values = makeView<View>( "buffer_values", 0, n_columns );
+        times[0] += localElapsed( comm, [&]() {
+            Impl::pullSourceValues( comm, values, buffer_indices, buffer_ranks,
+                                    buffer_values );
+        } );
+    }
+
+    auto target_values = makeView<View>( "target_values", n_requests,
+                                         n_columns );
+    for ( int r = 0; r < repetitions; ++r )
+        times[1] += localElapsed( comm, [&]() {
+            Impl::pushTargetValues( comm, buffer_indices, buffer_ranks,
+                                    buffer_values, target_values );
+        } );
+
+    for ( int r = 0; r < repetitions; ++r )
+        times[2] += localElapsed(
+            comm, [&]() { Impl::fetch( comm, ranks, indices, values ); } );
+
+    Plan plan;
+    for ( int r = 0; r < repetitions; ++r )
+        times[3] += localElapsed(
+            comm, [&]() { plan = Plan( comm, ranks, indices ); } );
+
+    for ( int r = 0; r < repetitions; ++r )
+        times[4] += localElapsed(
+            comm, [&]() { plan.fetch( values, target_values ); } );
+
+    for ( auto &t : times )
+        t /= repetitions;
+    return times;
+}
+
+//---------------------------------------------------------------------------//
+int main( int argc, char *argv[] )
+{
+    Teuchos::GlobalMPISession mpi_session( &argc, &argv );
+    Kokkos::initialize( argc, argv );
+
+    // Parse command line parameters
+    int n_requests = 1 << 18;
+    int n_values = 1 << 18;
+    int n_columns = 3;
+    double halo_fraction = 0.1;
+    unsigned int seed = 0;
+    int repetitions = 10;
+    std::string output = "communication.csv";
+    std::string label;
+    int opt;
+    while ( ( opt = getopt( argc, argv, "n:v:c:f:s:r:o:l:h" ) ) != -1 )
+    {
+        switch ( opt )
+        {
+        case 'n':
+            n_requests = std::atoi( optarg );
+            break;
+        case 'v':
+            n_values = std::atoi( optarg );
+            break;
+        case 'c':
+            n_columns = std::atoi( optarg );
+            break;
+        case 'f':
+            halo_fraction = std::atof( optarg );
+            break;
+        case 's':
+            seed = std::atoi( optarg );
+            break;
+        case 'r':
+            repetitions = std::atoi( optarg );
+            break;
+        case 'o':
+            output = optarg;
+            break;
+        case 'l':
+            label = optarg;
+            break;
+        case 'h':
+        default:
+            std::printf(
+                "Usage: %s [-n <requests>] [-v <values>] [-c <columns>] "
+                "[-f <fraction>] [-s <seed>] [-r <repetitions>] "
+                "[-o <file>] [-l <label>] [-h]\n"
+                "  -n  entries requested by each rank\n"
+                "  -v  values owned by each rank\n"
+                "  -c  columns of the values with several columns\n"
+                "  -f  fraction of the halo requests sent to other ranks\n"
+                "  -s  seed of the requests\n"
+                "  -r  repetitions of each measure\n"
+                "  -o  CSV file the latencies are appended to\n"
+                "  -l  label of the run, defaults to the ranks\n",
+                argv[0] );
+            Kokkos::finalize();
+            return opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+    if ( n_requests < 1 || n_values < 1 || n_columns < 1 ||
+         halo_fraction < 0. || halo_fraction > 1. || repetitions < 1 )
+    {
+        if ( comm_rank == 0 )
+            std::fprintf( stderr, "Invalid parameters, see -h\n" );
+        Kokkos::finalize();
+        return EXIT_FAILURE;
+    }
+    if ( label.empty() )
+        label = std::to_string( comm_size );
+
+    int status = EXIT_SUCCESS;
+    {
+        Kokkos::View<double *, DeviceType> values_1( "values", n_values );
+        Kokkos::deep_copy( values_1, 1. );
+        Kokkos::View<double **, DeviceType> values_2( "values", n_values,
+                                                      n_columns );
+        Kokkos::deep_copy( values_2, 1. );
+
+        std::array<std::pair<Pattern, std::string>, 4> const patterns = {
+            {{Pattern::Halo, "halo"},
+             {Pattern::AllToAll, "all-to-all"},
+             {Pattern::HotSpot, "hot spot"},
+             {Pattern::OneToMany, "one-to-many"}}};
+        std::vector<std::string> titles;
+        std::vector<std::array<double, 3>> results;
+        for ( auto const &pattern : patterns )
+        {
+            Kokkos::View<int *, DeviceType> ranks;
+            Kokkos::View<int *, DeviceType> indices;
+            std::tie( ranks, indices ) =
+                makeRequests( comm, pattern.first, n_requests, n_values,
+                              halo_fraction, seed );
+
+            // Requests sent to other ranks by all the ranks.
+            auto ranks_host = Kokkos::create_mirror_view( ranks );
+            Kokkos::deep_copy( ranks_host, ranks );
+            double local_remote = 0.;
+            for ( int i = 0; i < n_requests; ++i )
+                if ( ranks_host( i ) != comm_rank )
+                    local_remote += 1.;
+            double remote = 0.;
+            MPI_Allreduce( &local_remote, &remote, 1, MPI_DOUBLE, MPI_SUM,
+                           comm );
+
+            // The rank-1 values have a single column.
+            for ( int columns : {1, n_columns} )
+            {
+                auto const local_times =
+                    columns == 1
+                        ? timeOperations( comm, repetitions, ranks, indices,
+                                          values_1 )
+                        : timeOperations( comm, repetitions, ranks, indices,
+                                          values_2 );
+                std::array<double, n_operations> const bytes = {
+                    {12., 8. * columns + 4., 8. * columns + 16., 4.,
+                     8. * columns}};
+                for ( int op = 0; op < n_operations; ++op )
+                {
+                    double sum = 0.;
+                    double max = 0.;
+                    MPI_Allreduce( &local_times[op], &sum, 1, MPI_DOUBLE,
+                                   MPI_SUM, comm );
+                    MPI_Allreduce( &local_times[op], &max, 1, MPI_DOUBLE,
+                                   MPI_MAX, comm );
+                    titles.push_back( pattern.second + ", " +
+                                      ( columns == 1 ? "rank-1" : "rank-2" ) +
+                                      " values, " + operation_names[op] );
+                    results.push_back(
+                        {{1e6 * sum / comm_size, 1e6 * max,
+                          max > 0. ? bytes[op] * remote / max / comm_size /
+                                         1e6
+                                   : 0.}} );
+                }
+            }
+        }
+
+        if ( comm_rank == 0 )
+        {
+            std::printf( "%-52s %12s %12s %14s\n", "", "average [us]",
+                         "max [us]", "[MB/s per rank]" );
+            for ( unsigned int b = 0; b < titles.size(); ++b )
+                std::printf( "%-52s %12.0f %12.0f %14.1f\n",
+                             titles[b].c_str(), results[b][0], results[b][1],
+                             results[b][2] );
+
+            // The header lists the benchmarks and the timings of every row,
+            // each run then appends the commit hash, its label and one row
+            // per benchmark.
+            bool const new_file = !std::ifstream( output ).good();
+            std::ofstream file( output, std::ios::app );
+            if ( !file )
+            {
+                std::fprintf( stderr, "Cannot open %s\n", output.c_str() );
+                status = EXIT_FAILURE;
+            }
+            else
+            {
+                if ( new_file )
+                {
+                    file << titles.size() << '\n';
+                    for ( auto const &title : titles )
+                        file << title << '\n';
+                    file << "average max\n";
+                }
+                file << DataTransferKit::gitCommitHash() << '\n';
+                file << label << '\n';
+                for ( auto const &r : results )
+                    file << r[0] << ',' << r[1] << '\n';
+            }
+        }
+    }
+
+    Kokkos::finalize();
+    return status;
+}
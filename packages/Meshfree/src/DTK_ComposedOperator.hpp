@@ -0,0 +1,391 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_COMPOSED_OPERATOR_HPP
+#define DTK_COMPOSED_OPERATOR_HPP
+
+#include <DTK_ConfigDefs.hpp>
+#include <DTK_CrsMatrix.hpp>
+#include <DTK_DBC.hpp>
+#include <DTK_DetailsCommunicationPlan.hpp>
+#include <DTK_DetailsMovingLeastSquaresOperatorImpl.hpp>
+#include <DTK_PointCloudOperator.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace DataTransferKit
+{
+
+/**
+ * Product of two operators chained through an intermediate point cloud: the
+ * target points of the first operator are the source points of the second
+ * one. The product of their matrices is computed once when the operator is
+ * built, so that apply() gathers the source values in a single exchange
+ * instead of transferring them twice.
+ */
+template <typename DeviceType>
+class ComposedOperator : public PointCloudOperator<DeviceType>
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+
+  public:
+    /**
+     * Operator equivalent to applying first and then second. The operators
+     * are only used during the construction. Collective over comm, which
+     * must be the communicator of both operators.
+     */
+    ComposedOperator( MPI_Comm comm,
+                      PointCloudOperator<DeviceType> const &first,
+                      PointCloudOperator<DeviceType> const &second );
+
+    void
+    apply( Kokkos::View<double const *, DeviceType> source_values,
+           Kokkos::View<double *, DeviceType> target_values ) const override
+    {
+        apply( Details::viewAsColumn( source_values ),
+               Details::viewAsColumn( target_values ) );
+    }
+
+    void apply( Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+                    source_values,
+                Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+                    target_values ) const override;
+
+    void applyTranspose(
+        Kokkos::View<double const *, DeviceType> target_values,
+        Kokkos::View<double *, DeviceType> source_values ) const override
+    {
+        applyTranspose( Details::viewAsColumn( target_values ),
+                        Details::viewAsColumn( source_values ) );
+    }
+
+    void applyTranspose(
+        Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+            target_values,
+        Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+            source_values ) const override;
+
+    Kokkos::View<int const *, DeviceType> requestedRanks() const override
+    {
+        return _ranks;
+    }
+
+    Kokkos::View<int const *, DeviceType> requestedIndices() const override
+    {
+        return _indices;
+    }
+
+    void applyFetched(
+        Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+            fetched_values,
+        Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+            target_values ) const override;
+
+    CrsMatrix<DeviceType> crsMatrix() const override
+    {
+        return Details::makeCrsMatrix<DeviceType>( _comm, _size, _offset,
+                                                   _ranks, _indices, _coeffs );
+    }
+
+    OperatorStatistics statistics() const override
+    {
+        return Details::computeOperatorStatistics<DeviceType>(
+            _comm, _offset, _ranks, 0 );
+    }
+
+  private:
+    // Buffer receiving the source values needed on this rank.
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType>
+    fetchedValues( int n_components ) const
+    {
+        if ( _fetched_values.extent_int( 1 ) < n_components )
+            _fetched_values =
+                Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType>(
+                    Kokkos::ViewAllocateWithoutInitializing(
+                        "fetched_values" ),
+                    _indices.extent( 0 ), n_components );
+        return Kokkos::subview( _fetched_values, Kokkos::ALL,
+                                std::make_pair( 0, n_components ) );
+    }
+
+    MPI_Comm _comm;
+    int _size = 0;
+    Kokkos::View<int *, DeviceType> _offset;
+    Kokkos::View<int *, DeviceType> _ranks;
+    Kokkos::View<int *, DeviceType> _indices;
+    Kokkos::View<double *, DeviceType> _coeffs;
+    Details::CommunicationPlan<DeviceType> _plan;
+    mutable Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType>
+        _fetched_values;
+};
+
+namespace Details
+{
+// Owning rank and local index of a point given the global index of the first
+// point of every rank.
+inline std::pair<int, int>
+globalToLocal( std::vector<GlobalOrdinal> const &first, GlobalOrdinal id )
+{
+    int const rank =
+        std::upper_bound( first.begin(), first.end(), id ) - first.begin() - 1;
+    return std::make_pair( rank, static_cast<int>( id - first[rank] ) );
+}
+} // namespace Details
+
+template <typename DeviceType>
+ComposedOperator<DeviceType>::ComposedOperator(
+    MPI_Comm comm, PointCloudOperator<DeviceType> const &first,
+    PointCloudOperator<DeviceType> const &second )
+    : _comm( comm )
+    , _fetched_values( "fetched_values", 0, 0 )
+{
+    using MemorySpace = typename DeviceType::memory_space;
+
+    auto const a = first.crsMatrix();
+    auto const b = second.crsMatrix();
+    DTK_INSIST( a.numLocalRows() == b.num_local_columns );
+    _size = a.num_local_columns;
+
+    // Global index of the first source and intermediate point of every rank.
+    int comm_size;
+    MPI_Comm_size( _comm, &comm_size );
+    int const local_sizes[2] = {a.num_local_columns, b.num_local_columns};
+    std::vector<int> sizes( 2 * comm_size );
+    MPI_Allgather( local_sizes, 2, MPI_INT, sizes.data(), 2, MPI_INT, _comm );
+    std::vector<GlobalOrdinal> first_sources( comm_size, 0 );
+    std::vector<GlobalOrdinal> first_intermediates( comm_size, 0 );
+    for ( int r = 1; r < comm_size; ++r )
+    {
+        first_sources[r] = first_sources[r - 1] + sizes[2 * ( r - 1 )];
+        first_intermediates[r] =
+            first_intermediates[r - 1] + sizes[2 * ( r - 1 ) + 1];
+    }
+
+    auto b_offsets = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                          b.row_offsets );
+    auto b_columns = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                          b.column_ids );
+    auto b_values = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                         b.values );
+
+    // Rows of the first operator needed by the stencils of the second one.
+    std::vector<std::pair<int, int>> rows;
+    for ( unsigned int j = 0; j < b_columns.extent( 0 ); ++j )
+        rows.push_back(
+            Details::globalToLocal( first_intermediates, b_columns( j ) ) );
+    std::sort( rows.begin(), rows.end() );
+    rows.erase( std::unique( rows.begin(), rows.end() ), rows.end() );
+    int const n_rows = rows.size();
+
+    // Fetch the position and the length of these rows from their owners.
+    // Offsets and global ids are sent as double precision values, which
+    // represent them exactly below 2^53.
+    Kokkos::View<int *, Kokkos::HostSpace> ranks_host( "ranks", n_rows );
+    Kokkos::View<int *, Kokkos::HostSpace> indices_host( "indices", n_rows );
+    for ( int k = 0; k < n_rows; ++k )
+    {
+        ranks_host( k ) = rows[k].first;
+        indices_host( k ) = rows[k].second;
+    }
+    Details::CommunicationPlan<DeviceType> row_plan(
+        _comm, Kokkos::create_mirror_view_and_copy( MemorySpace(), ranks_host ),
+        Kokkos::create_mirror_view_and_copy( MemorySpace(), indices_host ) );
+    auto a_offsets = a.row_offsets;
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> row_extents(
+        Kokkos::ViewAllocateWithoutInitializing( "row_extents" ),
+        a.numLocalRows(), 2 );
+    Kokkos::parallel_for( DTK_MARK_REGION( "row_extents" ),
+                          Kokkos::RangePolicy<ExecutionSpace>(
+                              0, a.numLocalRows() ),
+                          KOKKOS_LAMBDA( int i ) {
+                              row_extents( i, 0 ) = a_offsets( i );
+                              row_extents( i, 1 ) =
+                                  a_offsets( i + 1 ) - a_offsets( i );
+                          } );
+    Kokkos::fence();
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> fetched_extents(
+        Kokkos::ViewAllocateWithoutInitializing( "fetched_extents" ), n_rows,
+        2 );
+    row_plan.fetch( row_extents, fetched_extents );
+    auto fetched_extents_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), fetched_extents );
+
+    // Fetch the entries of these rows.
+    std::vector<int> fetched_offsets( n_rows + 1, 0 );
+    for ( int k = 0; k < n_rows; ++k )
+        fetched_offsets[k + 1] =
+            fetched_offsets[k] +
+            static_cast<int>( fetched_extents_host( k, 1 ) );
+    int const n_entries = fetched_offsets.back();
+    Kokkos::View<int *, Kokkos::HostSpace> entry_ranks_host( "entry_ranks",
+                                                             n_entries );
+    Kokkos::View<int *, Kokkos::HostSpace> entry_indices_host(
+        "entry_indices", n_entries );
+    for ( int k = 0; k < n_rows; ++k )
+        for ( int l = fetched_offsets[k]; l < fetched_offsets[k + 1]; ++l )
+        {
+            entry_ranks_host( l ) = rows[k].first;
+            entry_indices_host( l ) = static_cast<int>(
+                fetched_extents_host( k, 0 ) + l - fetched_offsets[k] );
+        }
+    Details::CommunicationPlan<DeviceType> entry_plan(
+        _comm,
+        Kokkos::create_mirror_view_and_copy( MemorySpace(), entry_ranks_host ),
+        Kokkos::create_mirror_view_and_copy( MemorySpace(),
+                                             entry_indices_host ) );
+    auto a_columns = a.column_ids;
+    auto a_values = a.values;
+    int const a_entries = a_values.extent( 0 );
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> entries(
+        Kokkos::ViewAllocateWithoutInitializing( "entries" ), a_entries, 2 );
+    Kokkos::parallel_for( DTK_MARK_REGION( "row_entries" ),
+                          Kokkos::RangePolicy<ExecutionSpace>( 0, a_entries ),
+                          KOKKOS_LAMBDA( int j ) {
+                              entries( j, 0 ) = a_columns( j );
+                              entries( j, 1 ) = a_values( j );
+                          } );
+    Kokkos::fence();
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> fetched_entries(
+        Kokkos::ViewAllocateWithoutInitializing( "fetched_entries" ),
+        n_entries, 2 );
+    entry_plan.fetch( entries, fetched_entries );
+    auto fetched_entries_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), fetched_entries );
+
+    // Multiply the local rows of the second operator with the fetched rows of
+    // the first one. Each row of the product holds the union of the stencils
+    // of the intermediate points it depends on, sorted by source point.
+    int const n_targets = b.numLocalRows();
+    std::vector<int> offset( n_targets + 1, 0 );
+    std::vector<std::pair<int, int>> columns;
+    std::vector<double> coeffs;
+    std::map<GlobalOrdinal, double> row;
+    for ( int i = 0; i < n_targets; ++i )
+    {
+        row.clear();
+        for ( int j = b_offsets( i ); j < b_offsets( i + 1 ); ++j )
+        {
+            int const k =
+                std::lower_bound( rows.begin(), rows.end(),
+                                  Details::globalToLocal( first_intermediates,
+                                                          b_columns( j ) ) ) -
+                rows.begin();
+            for ( int l = fetched_offsets[k]; l < fetched_offsets[k + 1]; ++l )
+                row[static_cast<GlobalOrdinal>( fetched_entries_host(
+                    l, 0 ) )] += b_values( j ) * fetched_entries_host( l, 1 );
+        }
+        for ( auto const &entry : row )
+        {
+            columns.push_back(
+                Details::globalToLocal( first_sources, entry.first ) );
+            coeffs.push_back( entry.second );
+        }
+        offset[i + 1] = coeffs.size();
+    }
+
+    // Store the product like a moving least squares operator.
+    int const n_coeffs = coeffs.size();
+    Kokkos::View<int *, Kokkos::HostSpace> offset_host( "offset",
+                                                        n_targets + 1 );
+    std::copy( offset.begin(), offset.end(), offset_host.data() );
+    Kokkos::View<int *, Kokkos::HostSpace> source_ranks_host( "ranks",
+                                                              n_coeffs );
+    Kokkos::View<int *, Kokkos::HostSpace> source_indices_host( "indices",
+                                                                n_coeffs );
+    Kokkos::View<double *, Kokkos::HostSpace> coeffs_host( "coeffs",
+                                                           n_coeffs );
+    for ( int j = 0; j < n_coeffs; ++j )
+    {
+        source_ranks_host( j ) = columns[j].first;
+        source_indices_host( j ) = columns[j].second;
+        coeffs_host( j ) = coeffs[j];
+    }
+    _offset = Kokkos::create_mirror_view_and_copy( MemorySpace(), offset_host );
+    _ranks = Kokkos::create_mirror_view_and_copy( MemorySpace(),
+                                                  source_ranks_host );
+    _indices = Kokkos::create_mirror_view_and_copy( MemorySpace(),
+                                                    source_indices_host );
+    _coeffs = Kokkos::create_mirror_view_and_copy( MemorySpace(), coeffs_host );
+    _plan = Details::CommunicationPlan<DeviceType>( _comm, _ranks, _indices );
+}
+
+template <typename DeviceType>
+void ComposedOperator<DeviceType>::apply(
+    Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+        source_values,
+    Kokkos::View<double **, Kokkos::LayoutStride, DeviceType> target_values )
+    const
+{
+    // Precondition: check that the source and the target are properly sized
+    DTK_REQUIRE( source_values.extent_int( 0 ) == _size );
+    DTK_REQUIRE( target_values.extent( 0 ) == _offset.extent( 0 ) - 1 );
+    DTK_REQUIRE( source_values.extent( 1 ) == target_values.extent( 1 ) );
+
+    auto fetched_values = fetchedValues( source_values.extent( 1 ) );
+    _plan.fetch( source_values, fetched_values );
+    Details::MovingLeastSquaresOperatorImpl<DeviceType>::computeTargetValues(
+        _offset, _coeffs, fetched_values, target_values );
+}
+
+template <typename DeviceType>
+void ComposedOperator<DeviceType>::applyTranspose(
+    Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+        target_values,
+    Kokkos::View<double **, Kokkos::LayoutStride, DeviceType> source_values )
+    const
+{
+    // Precondition: check that the source and the target are properly sized
+    DTK_REQUIRE( source_values.extent_int( 0 ) == _size );
+    DTK_REQUIRE( target_values.extent( 0 ) == _offset.extent( 0 ) - 1 );
+    DTK_REQUIRE( source_values.extent( 1 ) == target_values.extent( 1 ) );
+
+    int const n_components = target_values.extent( 1 );
+    auto contributions = fetchedValues( n_components );
+    auto offset = _offset;
+    auto coeffs = _coeffs;
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "weight_contributions" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, target_values.extent( 0 ) ),
+        KOKKOS_LAMBDA( int i ) {
+            for ( int j = offset( i ); j < offset( i + 1 ); ++j )
+                for ( int c = 0; c < n_components; ++c )
+                    contributions( j, c ) = coeffs( j ) * target_values( i, c );
+        } );
+    Kokkos::fence();
+
+    Kokkos::deep_copy( source_values, 0. );
+    _plan.accumulate( contributions, source_values );
+}
+
+template <typename DeviceType>
+void ComposedOperator<DeviceType>::applyFetched(
+    Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+        fetched_values,
+    Kokkos::View<double **, Kokkos::LayoutStride, DeviceType> target_values )
+    const
+{
+    DTK_REQUIRE( fetched_values.extent( 0 ) == _indices.extent( 0 ) );
+    DTK_REQUIRE( target_values.extent( 0 ) == _offset.extent( 0 ) - 1 );
+
+    Details::MovingLeastSquaresOperatorImpl<DeviceType>::computeTargetValues(
+        _offset, _coeffs, fetched_values, target_values );
+}
+
+} // namespace DataTransferKit
+
+#endif
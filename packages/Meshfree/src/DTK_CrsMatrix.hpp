@@ -0,0 +1,137 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_CRS_MATRIX_HPP
+#define DTK_CRS_MATRIX_HPP
+
+#include <DTK_ConfigDefs.hpp>
+#include <DTK_DBC.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <limits>
+#include <vector>
+
+namespace DataTransferKit
+{
+
+/**
+ * Distributed sparse matrix in compressed row storage. Each rank holds the
+ * rows of its target points, i.e. the entries of row i are in
+ * [row_offsets(i), row_offsets(i+1)). Rows and columns are numbered globally
+ * by rank: the points of rank r come after the points of ranks 0 to r-1.
+ * Column c refers to the source point with local index c - first_column on
+ * the rank that owns it.
+ */
+template <typename DeviceType>
+struct CrsMatrix
+{
+    Kokkos::View<int *, DeviceType> row_offsets;
+    Kokkos::View<GlobalOrdinal *, DeviceType> column_ids;
+    Kokkos::View<double *, DeviceType> values;
+
+    // Global index of the first local row, i.e. target point.
+    GlobalOrdinal first_row = 0;
+    // Global index of the first local column, i.e. source point.
+    GlobalOrdinal first_column = 0;
+    // Number of source points owned by this rank.
+    int num_local_columns = 0;
+    GlobalOrdinal num_global_rows = 0;
+    GlobalOrdinal num_global_columns = 0;
+
+    int numLocalRows() const { return row_offsets.extent_int( 0 ) - 1; }
+};
+
+namespace Details
+{
+
+// Assemble the matrix of an operator whose entries in row i are
+// coeffs(j) * source value indices(j) on rank ranks(j), for j in
+// [offset(i), offset(i+1)). The offsets may be of any integer type but the
+// matrix uses int row offsets. Collective over comm.
+template <typename DeviceType, typename OffsetView>
+CrsMatrix<DeviceType>
+makeCrsMatrix( MPI_Comm comm, int num_local_columns, OffsetView offset,
+               Kokkos::View<int const *, DeviceType> ranks,
+               Kokkos::View<int const *, DeviceType> indices,
+               Kokkos::View<double const *, DeviceType> coeffs )
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+    DTK_REQUIRE( ranks.extent( 0 ) == indices.extent( 0 ) );
+    DTK_REQUIRE( coeffs.extent( 0 ) == indices.extent( 0 ) );
+    DTK_INSIST( indices.extent( 0 ) <=
+                static_cast<size_t>( std::numeric_limits<int>::max() ) );
+
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+
+    // Number the rows and the columns by rank.
+    GlobalOrdinal const local_sizes[2] = {
+        static_cast<GlobalOrdinal>( offset.extent( 0 ) - 1 ),
+        num_local_columns};
+    std::vector<GlobalOrdinal> sizes( 2 * comm_size );
+    MPI_Allgather( local_sizes, 2, MPI_LONG_LONG, sizes.data(), 2,
+                   MPI_LONG_LONG, comm );
+    Kokkos::View<GlobalOrdinal *, Kokkos::HostSpace> first_columns_host(
+        "first_columns", comm_size );
+    CrsMatrix<DeviceType> matrix;
+    for ( int r = 0; r < comm_size; ++r )
+    {
+        if ( r == comm_rank )
+        {
+            matrix.first_row = matrix.num_global_rows;
+            matrix.first_column = matrix.num_global_columns;
+        }
+        first_columns_host( r ) = matrix.num_global_columns;
+        matrix.num_global_rows += sizes[2 * r];
+        matrix.num_global_columns += sizes[2 * r + 1];
+    }
+    matrix.num_local_columns = num_local_columns;
+
+    auto first_columns = Kokkos::create_mirror_view_and_copy(
+        typename DeviceType::memory_space(), first_columns_host );
+    int const n_entries = indices.extent( 0 );
+    matrix.column_ids = Kokkos::View<GlobalOrdinal *, DeviceType>(
+        Kokkos::ViewAllocateWithoutInitializing( "column_ids" ), n_entries );
+    auto column_ids = matrix.column_ids;
+    Kokkos::parallel_for( DTK_MARK_REGION( "global_column_ids" ),
+                          Kokkos::RangePolicy<ExecutionSpace>( 0, n_entries ),
+                          KOKKOS_LAMBDA( int j ) {
+                              column_ids( j ) =
+                                  first_columns( ranks( j ) ) + indices( j );
+                          } );
+    Kokkos::fence();
+
+    int const n_row_offsets = offset.extent( 0 );
+    matrix.row_offsets = Kokkos::View<int *, DeviceType>(
+        Kokkos::ViewAllocateWithoutInitializing( "row_offsets" ),
+        n_row_offsets );
+    auto row_offsets = matrix.row_offsets;
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "row_offsets" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_row_offsets ),
+        KOKKOS_LAMBDA( int i ) { row_offsets( i ) = offset( i ); } );
+    Kokkos::fence();
+    matrix.values = Kokkos::View<double *, DeviceType>(
+        Kokkos::ViewAllocateWithoutInitializing( "values" ), n_entries );
+    Kokkos::deep_copy( matrix.values, coeffs );
+
+    return matrix;
+}
+
+} // namespace Details
+} // namespace DataTransferKit
+
+#endif
@@ -0,0 +1,102 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_CRS_MATRIX_TPETRA_HPP
+#define DTK_CRS_MATRIX_TPETRA_HPP
+
+#include <DTK_ConfigDefs.hpp>
+#include <DTK_CrsMatrix.hpp>
+
+#include <Teuchos_ArrayView.hpp>
+#include <Teuchos_Comm.hpp>
+#include <Teuchos_RCP.hpp>
+
+#include <MatrixMarket_Tpetra.hpp>
+#include <Tpetra_CrsMatrix.hpp>
+#include <Tpetra_Map.hpp>
+
+#include <algorithm>
+#include <string>
+
+namespace DataTransferKit
+{
+
+/**
+ * Copy an exported operator into a Tpetra matrix. The row map holds the
+ * target points of each rank and the domain map its source points, so the
+ * matrix applies to Tpetra vectors distributed like the source values.
+ * Collective over comm, which must be the communicator of the operator.
+ */
+template <typename Node>
+Teuchos::RCP<Tpetra::CrsMatrix<double, int, GlobalOrdinal, Node>>
+createTpetraCrsMatrix(
+    Teuchos::RCP<Teuchos::Comm<int> const> const &comm,
+    CrsMatrix<typename Node::device_type> const &matrix )
+{
+    using Map = Tpetra::Map<int, GlobalOrdinal, Node>;
+    using Matrix = Tpetra::CrsMatrix<double, int, GlobalOrdinal, Node>;
+
+    int const n_rows = matrix.numLocalRows();
+    auto row_map = Teuchos::rcp(
+        new Map( matrix.num_global_rows, n_rows, 0, comm ) );
+    auto domain_map = Teuchos::rcp( new Map(
+        matrix.num_global_columns, matrix.num_local_columns, 0, comm ) );
+
+    auto row_offsets = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), matrix.row_offsets );
+    auto column_ids = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), matrix.column_ids );
+    auto values = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                       matrix.values );
+
+    size_t max_entries = 0;
+    for ( int i = 0; i < n_rows; ++i )
+        max_entries = std::max(
+            max_entries,
+            static_cast<size_t>( row_offsets( i + 1 ) - row_offsets( i ) ) );
+
+    auto tpetra_matrix = Teuchos::rcp( new Matrix( row_map, max_entries ) );
+    for ( int i = 0; i < n_rows; ++i )
+    {
+        int const first = row_offsets( i );
+        int const n_entries = row_offsets( i + 1 ) - first;
+        tpetra_matrix->insertGlobalValues(
+            matrix.first_row + i,
+            Teuchos::ArrayView<GlobalOrdinal const>( column_ids.data() + first,
+                                                     n_entries ),
+            Teuchos::ArrayView<double const>( values.data() + first,
+                                              n_entries ) );
+    }
+    tpetra_matrix->fillComplete( domain_map, row_map );
+
+    return tpetra_matrix;
+}
+
+/**
+ * Write an exported operator to a file in the MatrixMarket coordinate
+ * format. Collective over comm; only the first rank writes.
+ */
+template <typename Node>
+void writeMatrixMarket( std::string const &filename,
+                        Teuchos::RCP<Teuchos::Comm<int> const> const &comm,
+                        CrsMatrix<typename Node::device_type> const &matrix )
+{
+    using Matrix = Tpetra::CrsMatrix<double, int, GlobalOrdinal, Node>;
+
+    Tpetra::MatrixMarket::Writer<Matrix>::writeSparseFile(
+        filename, createTpetraCrsMatrix<Node>( comm, matrix ),
+        "DataTransferKit operator",
+        "rows are target points, columns are source points" );
+}
+
+} // namespace DataTransferKit
+
+#endif
@@ -0,0 +1,601 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_DETAILS_COMMUNICATION_PLAN_HPP
+#define DTK_DETAILS_COMMUNICATION_PLAN_HPP
+
+#include <DTK_ConfigDefs.hpp>
+#include <DTK_DBC.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace DataTransferKit
+{
+namespace Details
+{
+
+/**
+ * Persistent plan to gather remote values. Entry k requested by this rank
+ * lives at index indices(k) on rank ranks(k). The request indices are
+ * exchanged once when the plan is built. Afterwards, fetch() only sends the
+ * values, using staging buffers that are only reallocated when more columns
+ * than ever before are sent. accumulate() sends values along the same
+ * routes in the opposite direction.
+ */
+template <typename DeviceType>
+class CommunicationPlan
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+
+  public:
+    CommunicationPlan() = default;
+
+    // Collective over comm.
+    CommunicationPlan( MPI_Comm comm,
+                       Kokkos::View<int const *, DeviceType> ranks,
+                       Kokkos::View<int const *, DeviceType> indices )
+        : _comm( comm )
+    {
+        DTK_REQUIRE( ranks.extent( 0 ) == indices.extent( 0 ) );
+        DTK_MARK_SCOPE( "build_communication_plan" );
+
+        int comm_size;
+        MPI_Comm_size( _comm, &comm_size );
+
+        auto ranks_host = Kokkos::create_mirror_view( ranks );
+        Kokkos::deep_copy( ranks_host, ranks );
+        auto indices_host = Kokkos::create_mirror_view( indices );
+        Kokkos::deep_copy( indices_host, indices );
+
+        // Group the requests by owning rank.
+        int const n_requests = ranks_host.extent( 0 );
+        std::vector<int> permute( n_requests );
+        std::iota( permute.begin(), permute.end(), 0 );
+        std::stable_sort( permute.begin(), permute.end(),
+                          [&ranks_host]( int a, int b ) {
+                              return ranks_host( a ) < ranks_host( b );
+                          } );
+        std::vector<int> request_counts( comm_size, 0 );
+        std::vector<int> request_indices( n_requests );
+        for ( int i = 0; i < n_requests; ++i )
+        {
+            ++request_counts[ranks_host( permute[i] )];
+            request_indices[i] = indices_host( permute[i] );
+        }
+
+        // Tell the owners which of their entries are needed.
+        std::vector<int> export_counts( comm_size );
+        MPI_Alltoall( request_counts.data(), 1, MPI_INT, export_counts.data(),
+                      1, MPI_INT, _comm );
+        std::vector<int> request_offsets( comm_size + 1, 0 );
+        std::partial_sum( request_counts.begin(), request_counts.end(),
+                          request_offsets.begin() + 1 );
+        std::vector<int> export_offsets( comm_size + 1, 0 );
+        std::partial_sum( export_counts.begin(), export_counts.end(),
+                          export_offsets.begin() + 1 );
+        std::vector<int> export_indices( export_offsets.back() );
+        MPI_Alltoallv( request_indices.data(), request_counts.data(),
+                       request_offsets.data(), MPI_INT, export_indices.data(),
+                       export_counts.data(), export_offsets.data(), MPI_INT,
+                       _comm );
+
+        // Only keep track of the ranks we actually talk to.
+        for ( int r = 0; r < comm_size; ++r )
+        {
+            if ( export_counts[r] > 0 )
+            {
+                _send_ranks.push_back( r );
+                _send_offsets.push_back( export_offsets[r] );
+            }
+            if ( request_counts[r] > 0 )
+            {
+                _recv_ranks.push_back( r );
+                _recv_offsets.push_back( request_offsets[r] );
+            }
+        }
+        _send_offsets.push_back( export_offsets.back() );
+        _recv_offsets.push_back( request_offsets.back() );
+        _requests.resize( _send_ranks.size() + _recv_ranks.size() );
+
+        _export_indices = Kokkos::View<int *, DeviceType>(
+            "export_indices", export_indices.size() );
+        Kokkos::deep_copy(
+            _export_indices,
+            Kokkos::View<int *, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>(
+                export_indices.data(), export_indices.size() ) );
+        _import_positions =
+            Kokkos::View<int *, DeviceType>( "import_positions", n_requests );
+        Kokkos::deep_copy(
+            _import_positions,
+            Kokkos::View<int *, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>(
+                permute.data(), permute.size() ) );
+    }
+
+    // Number of entries requested by this rank.
+    int size() const { return _import_positions.extent_int( 0 ); }
+
+    // Number of entries this rank sends to others (self included).
+    int exportSize() const { return _export_indices.extent_int( 0 ); }
+
+    // Number of entries this rank sends to other ranks, and number of these
+    // ranks.
+    int remoteExportSize() const
+    {
+        int comm_rank;
+        MPI_Comm_rank( _comm, &comm_rank );
+        int n = 0;
+        for ( unsigned int k = 0; k < _send_ranks.size(); ++k )
+            if ( _send_ranks[k] != comm_rank )
+                n += _send_offsets[k + 1] - _send_offsets[k];
+        return n;
+    }
+
+    int numSendNeighbors() const
+    {
+        int comm_rank;
+        MPI_Comm_rank( _comm, &comm_rank );
+        return _send_ranks.size() -
+               std::count( _send_ranks.begin(), _send_ranks.end(), comm_rank );
+    }
+
+    // Same as above for the entries this rank receives from other ranks.
+    int remoteImportSize() const
+    {
+        int comm_rank;
+        MPI_Comm_rank( _comm, &comm_rank );
+        int n = 0;
+        for ( unsigned int k = 0; k < _recv_ranks.size(); ++k )
+            if ( _recv_ranks[k] != comm_rank )
+                n += _recv_offsets[k + 1] - _recv_offsets[k];
+        return n;
+    }
+
+    int numRecvNeighbors() const
+    {
+        int comm_rank;
+        MPI_Comm_rank( _comm, &comm_rank );
+        return _recv_ranks.size() -
+               std::count( _recv_ranks.begin(), _recv_ranks.end(), comm_rank );
+    }
+
+    // Number of entries this rank sent in the last call to fetchChanged().
+    int changedExportSize() const { return _changed_export_size; }
+
+    // out(k, j) <-- values(indices(k), j) on rank ranks(k). Collective.
+    template <typename InputView, typename OutputView>
+    void fetch( InputView values, OutputView out ) const
+    {
+        static_assert( InputView::rank == OutputView::rank &&
+                           ( InputView::rank == 1 || InputView::rank == 2 ),
+                       "fetch() requires rank-1 or rank-2 view arguments" );
+        static_assert(
+            std::is_same<typename InputView::non_const_value_type,
+                         double>::value,
+            "fetch() only communicates double precision values" );
+        DTK_REQUIRE( out.extent_int( 0 ) == size() );
+        DTK_REQUIRE( out.extent( 1 ) == values.extent( 1 ) );
+
+        int const n_columns = values.extent( 1 );
+        reserve( n_columns );
+
+        auto export_indices = _export_indices;
+        auto export_buffer = _export_buffer;
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "pack_values" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, exportSize() ),
+            KOKKOS_LAMBDA( int i ) {
+                for ( int j = 0; j < n_columns; ++j )
+                    export_buffer( i * n_columns + j ) =
+                        values.access( export_indices( i ), j );
+            } );
+        Kokkos::fence();
+        auto const exports = std::make_pair( 0, exportSize() * n_columns );
+        Kokkos::deep_copy( Kokkos::subview( _export_buffer_host, exports ),
+                           Kokkos::subview( _export_buffer, exports ) );
+
+        exchange( n_columns, false );
+
+        auto const imports = std::make_pair( 0, size() * n_columns );
+        Kokkos::deep_copy( Kokkos::subview( _import_buffer, imports ),
+                           Kokkos::subview( _import_buffer_host, imports ) );
+        auto import_positions = _import_positions;
+        auto import_buffer = _import_buffer;
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "unpack_values" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, size() ),
+            KOKKOS_LAMBDA( int i ) {
+                for ( int j = 0; j < n_columns; ++j )
+                    out.access( import_positions( i ), j ) =
+                        import_buffer( i * n_columns + j );
+            } );
+        Kokkos::fence();
+    }
+
+    // out(indices(k), j) on rank ranks(k) += values(k, j), i.e. the reverse
+    // of fetch(). Several entries may add to the same value. Collective.
+    template <typename InputView, typename OutputView>
+    void accumulate( InputView values, OutputView out ) const
+    {
+        static_assert(
+            InputView::rank == OutputView::rank &&
+                ( InputView::rank == 1 || InputView::rank == 2 ),
+            "accumulate() requires rank-1 or rank-2 view arguments" );
+        static_assert(
+            std::is_same<typename InputView::non_const_value_type,
+                         double>::value,
+            "accumulate() only communicates double precision values" );
+        DTK_REQUIRE( values.extent_int( 0 ) == size() );
+        DTK_REQUIRE( out.extent( 1 ) == values.extent( 1 ) );
+
+        int const n_columns = values.extent( 1 );
+        reserve( n_columns );
+
+        auto import_positions = _import_positions;
+        auto import_buffer = _import_buffer;
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "pack_contributions" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, size() ),
+            KOKKOS_LAMBDA( int i ) {
+                for ( int j = 0; j < n_columns; ++j )
+                    import_buffer( i * n_columns + j ) =
+                        values.access( import_positions( i ), j );
+            } );
+        Kokkos::fence();
+        auto const imports = std::make_pair( 0, size() * n_columns );
+        Kokkos::deep_copy( Kokkos::subview( _import_buffer_host, imports ),
+                           Kokkos::subview( _import_buffer, imports ) );
+
+        exchange( n_columns, true );
+
+        auto const exports = std::make_pair( 0, exportSize() * n_columns );
+        Kokkos::deep_copy( Kokkos::subview( _export_buffer, exports ),
+                           Kokkos::subview( _export_buffer_host, exports ) );
+        auto export_indices = _export_indices;
+        auto export_buffer = _export_buffer;
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "unpack_contributions" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, exportSize() ),
+            KOKKOS_LAMBDA( int i ) {
+                for ( int j = 0; j < n_columns; ++j )
+                    Kokkos::atomic_add(
+                        &out.access( export_indices( i ), j ),
+                        export_buffer( i * n_columns + j ) );
+            } );
+        Kokkos::fence();
+    }
+
+    /**
+     * Same as fetch() but only send the values for which changed(index) is
+     * true on the owning rank, along with their position in the plan. The
+     * other entries of out are left untouched. Return the rows of out that
+     * were written, valid until the next call. The staging buffers are shared
+     * with fetch() and only allocated on the first call. Collective.
+     */
+    template <typename InputView, typename OutputView>
+    Kokkos::View<int *, DeviceType>
+    fetchChanged( InputView values,
+                  Kokkos::View<bool const *, DeviceType> changed,
+                  OutputView out ) const
+    {
+        static_assert( InputView::rank == 2 && OutputView::rank == 2,
+                       "fetchChanged() requires rank-2 view arguments" );
+        DTK_REQUIRE( out.extent_int( 0 ) == size() );
+        DTK_REQUIRE( out.extent( 1 ) == values.extent( 1 ) );
+        DTK_REQUIRE( changed.extent( 0 ) == values.extent( 0 ) );
+        DTK_MARK_SCOPE( "fetch_changed_values" );
+
+        int const n_columns = values.extent( 1 );
+        reserve( n_columns );
+        reserveChanged();
+
+        // Slot of the changed entries among the entries sent. The entries
+        // sent to the same rank remain contiguous.
+        int const n_exports = exportSize();
+        auto export_indices = _export_indices;
+        auto changed_slots = _changed_slots;
+        Kokkos::parallel_scan(
+            DTK_MARK_REGION( "select_changed" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_exports + 1 ),
+            KOKKOS_LAMBDA( int i, int &slot, bool final ) {
+                if ( final )
+                    changed_slots( i ) = slot;
+                if ( i < n_exports && changed( export_indices( i ) ) )
+                    ++slot;
+            } );
+        auto send_offsets = _send_offsets_device;
+        auto changed_send_offsets = _changed_send_offsets;
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "count_changed" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, send_offsets.extent( 0 ) ),
+            KOKKOS_LAMBDA( int k ) {
+                changed_send_offsets( k ) = changed_slots( send_offsets( k ) );
+            } );
+        Kokkos::fence();
+        Kokkos::deep_copy( _changed_send_offsets_host, _changed_send_offsets );
+        int const n_sends = _send_ranks.size();
+        _changed_export_size = _changed_send_offsets_host( n_sends );
+
+        // Pack the position of the changed entries among the entries sent to
+        // the same rank, and their values in the staging buffer of fetch().
+        auto export_positions = _export_positions;
+        auto changed_positions = _changed_positions;
+        auto export_buffer = _export_buffer;
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "pack_changed_values" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_exports ),
+            KOKKOS_LAMBDA( int i ) {
+                int const slot = changed_slots( i );
+                if ( changed_slots( i + 1 ) == slot )
+                    return;
+                changed_positions( slot ) = export_positions( i );
+                for ( int j = 0; j < n_columns; ++j )
+                    export_buffer( slot * n_columns + j ) =
+                        values.access( export_indices( i ), j );
+            } );
+        Kokkos::fence();
+        auto const changed_exports =
+            std::make_pair( 0, _changed_export_size );
+        Kokkos::deep_copy(
+            Kokkos::subview( _changed_positions_host, changed_exports ),
+            Kokkos::subview( _changed_positions, changed_exports ) );
+        auto const exports =
+            std::make_pair( 0, _changed_export_size * n_columns );
+        Kokkos::deep_copy( Kokkos::subview( _export_buffer_host, exports ),
+                           Kokkos::subview( _export_buffer, exports ) );
+
+        // Tell the receivers how many entries to expect.
+        int const tag = 4;
+        int const n_recvs = _recv_ranks.size();
+        for ( int k = 0; k < n_sends; ++k )
+            _changed_send_counts[k] = _changed_send_offsets_host( k + 1 ) -
+                                      _changed_send_offsets_host( k );
+        int n_requests = 0;
+        for ( int k = 0; k < n_recvs; ++k )
+            MPI_Irecv( &_changed_recv_counts[k], 1, MPI_INT, _recv_ranks[k],
+                       tag, _comm, &_requests[n_requests++] );
+        for ( int k = 0; k < n_sends; ++k )
+            MPI_Isend( &_changed_send_counts[k], 1, MPI_INT, _send_ranks[k],
+                       tag, _comm, &_requests[n_requests++] );
+        MPI_Waitall( n_requests, _requests.data(), MPI_STATUSES_IGNORE );
+
+        // The positions and the values travel in separate messages.
+        _changed_recv_offsets_host( 0 ) = 0;
+        for ( int k = 0; k < n_recvs; ++k )
+            _changed_recv_offsets_host( k + 1 ) =
+                _changed_recv_offsets_host( k ) + _changed_recv_counts[k];
+        int const n_received = _changed_recv_offsets_host( n_recvs );
+        n_requests = 0;
+        for ( int k = 0; k < n_recvs; ++k )
+        {
+            int const offset = _changed_recv_offsets_host( k );
+            int const count = _changed_recv_counts[k];
+            if ( count == 0 )
+                continue;
+            MPI_Irecv( _received_positions_host.data() + offset, count,
+                       MPI_INT, _recv_ranks[k], tag + 1, _comm,
+                       &_requests[n_requests++] );
+            MPI_Irecv( _import_buffer_host.data() + offset * n_columns,
+                       count * n_columns, MPI_DOUBLE, _recv_ranks[k],
+                       tag + 2, _comm, &_requests[n_requests++] );
+        }
+        for ( int k = 0; k < n_sends; ++k )
+        {
+            int const offset = _changed_send_offsets_host( k );
+            int const count = _changed_send_counts[k];
+            if ( count == 0 )
+                continue;
+            MPI_Isend( _changed_positions_host.data() + offset, count,
+                       MPI_INT, _send_ranks[k], tag + 1, _comm,
+                       &_requests[n_requests++] );
+            MPI_Isend( _export_buffer_host.data() + offset * n_columns,
+                       count * n_columns, MPI_DOUBLE, _send_ranks[k],
+                       tag + 2, _comm, &_requests[n_requests++] );
+        }
+        MPI_Waitall( n_requests, _requests.data(), MPI_STATUSES_IGNORE );
+
+        auto const received = std::make_pair( 0, n_received );
+        Kokkos::deep_copy( Kokkos::subview( _received_positions, received ),
+                           Kokkos::subview( _received_positions_host,
+                                            received ) );
+        auto const imports = std::make_pair( 0, n_received * n_columns );
+        Kokkos::deep_copy( Kokkos::subview( _import_buffer, imports ),
+                           Kokkos::subview( _import_buffer_host, imports ) );
+        Kokkos::deep_copy( _changed_recv_offsets, _changed_recv_offsets_host );
+
+        // The entries sent by a rank are in the order this rank receives
+        // them in fetch().
+        auto recv_offsets = _recv_offsets_device;
+        auto changed_recv_offsets = _changed_recv_offsets;
+        auto received_positions = _received_positions;
+        auto import_positions = _import_positions;
+        auto import_buffer = _import_buffer;
+        auto rows = _changed_rows;
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "unpack_changed_values" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_received ),
+            KOKKOS_LAMBDA( int i ) {
+                // Last rank whose entries start at or before i.
+                int first = 0;
+                int last = n_recvs - 1;
+                while ( first < last )
+                {
+                    int const middle = ( first + last + 1 ) / 2;
+                    if ( changed_recv_offsets( middle ) <= i )
+                        first = middle;
+                    else
+                        last = middle - 1;
+                }
+                int const position = import_positions(
+                    recv_offsets( first ) + received_positions( i ) );
+                rows( i ) = position;
+                for ( int j = 0; j < n_columns; ++j )
+                    out.access( position, j ) =
+                        import_buffer( i * n_columns + j );
+            } );
+        Kokkos::fence();
+        return Kokkos::subview( _changed_rows, received );
+    }
+
+  private:
+    // Grow the staging buffers if needed to hold a given number of columns.
+    void reserve( int n_columns ) const
+    {
+        if ( n_columns <= _n_columns )
+            return;
+        _n_columns = n_columns;
+        _export_buffer = Kokkos::View<double *, DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "export_buffer" ),
+            exportSize() * n_columns );
+        _export_buffer_host = Kokkos::create_mirror_view( _export_buffer );
+        _import_buffer = Kokkos::View<double *, DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "import_buffer" ),
+            size() * n_columns );
+        _import_buffer_host = Kokkos::create_mirror_view( _import_buffer );
+    }
+
+    // Allocate the buffers of fetchChanged() on its first call.
+    void reserveChanged() const
+    {
+        if ( _changed_slots.extent( 0 ) > 0 )
+            return;
+        int const n_sends = _send_ranks.size();
+        int const n_recvs = _recv_ranks.size();
+        std::vector<int> export_positions( exportSize() );
+        for ( int k = 0; k < n_sends; ++k )
+            for ( int i = _send_offsets[k]; i < _send_offsets[k + 1]; ++i )
+                export_positions[i] = i - _send_offsets[k];
+        _export_positions =
+            copyToDevice( "export_positions", export_positions );
+        _send_offsets_device = copyToDevice( "send_offsets", _send_offsets );
+        _recv_offsets_device = copyToDevice( "recv_offsets", _recv_offsets );
+        _changed_slots = Kokkos::View<int *, DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "changed_slots" ),
+            exportSize() + 1 );
+        _changed_send_offsets = Kokkos::View<int *, DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "changed_send_offsets" ),
+            n_sends + 1 );
+        _changed_send_offsets_host =
+            Kokkos::create_mirror_view( _changed_send_offsets );
+        _changed_positions = Kokkos::View<int *, DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "changed_positions" ),
+            exportSize() );
+        _changed_positions_host =
+            Kokkos::create_mirror_view( _changed_positions );
+        _changed_recv_offsets = Kokkos::View<int *, DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "changed_recv_offsets" ),
+            n_recvs + 1 );
+        _changed_recv_offsets_host =
+            Kokkos::create_mirror_view( _changed_recv_offsets );
+        _received_positions = Kokkos::View<int *, DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "received_positions" ),
+            size() );
+        _received_positions_host =
+            Kokkos::create_mirror_view( _received_positions );
+        _changed_rows = Kokkos::View<int *, DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "changed_rows" ),
+            size() );
+        _changed_send_counts.resize( n_sends );
+        _changed_recv_counts.resize( n_recvs );
+        _requests.resize( 2 * ( n_sends + n_recvs ) );
+    }
+
+    static Kokkos::View<int *, DeviceType>
+    copyToDevice( std::string const &label, std::vector<int> const &v )
+    {
+        Kokkos::View<int *, DeviceType> view(
+            Kokkos::ViewAllocateWithoutInitializing( label ), v.size() );
+        Kokkos::deep_copy(
+            view, Kokkos::View<int const *, Kokkos::HostSpace,
+                               Kokkos::MemoryUnmanaged>( v.data(), v.size() ) );
+        return view;
+    }
+
+    // Post all receives and sends of the staged host buffers and wait. The
+    // export buffer is sent to the owners of the requested values, or
+    // received from them in reverse.
+    void exchange( int n_columns, bool reverse ) const
+    {
+        DTK_MARK_SCOPE( "exchange_values" );
+        int const tag = 3;
+        auto const &send_ranks = reverse ? _recv_ranks : _send_ranks;
+        auto const &send_offsets = reverse ? _recv_offsets : _send_offsets;
+        auto const &recv_ranks = reverse ? _send_ranks : _recv_ranks;
+        auto const &recv_offsets = reverse ? _send_offsets : _recv_offsets;
+        double *send_buffer = reverse ? _import_buffer_host.data()
+                                      : _export_buffer_host.data();
+        double *recv_buffer = reverse ? _export_buffer_host.data()
+                                      : _import_buffer_host.data();
+        int n_requests = 0;
+        for ( unsigned int k = 0; k < recv_ranks.size(); ++k )
+            MPI_Irecv( recv_buffer + recv_offsets[k] * n_columns,
+                       ( recv_offsets[k + 1] - recv_offsets[k] ) * n_columns,
+                       MPI_DOUBLE, recv_ranks[k], tag, _comm,
+                       &_requests[n_requests++] );
+        for ( unsigned int k = 0; k < send_ranks.size(); ++k )
+            MPI_Isend( send_buffer + send_offsets[k] * n_columns,
+                       ( send_offsets[k + 1] - send_offsets[k] ) * n_columns,
+                       MPI_DOUBLE, send_ranks[k], tag, _comm,
+                       &_requests[n_requests++] );
+        MPI_Waitall( n_requests, _requests.data(), MPI_STATUSES_IGNORE );
+    }
+
+    MPI_Comm _comm = MPI_COMM_NULL;
+    // Sender side, grouped by destination rank.
+    Kokkos::View<int *, DeviceType> _export_indices;
+    std::vector<int> _send_ranks;
+    std::vector<int> _send_offsets;
+    // Receiver side, grouped by source rank.
+    Kokkos::View<int *, DeviceType> _import_positions;
+    std::vector<int> _recv_ranks;
+    std::vector<int> _recv_offsets;
+    // Staging buffers.
+    mutable int _n_columns = -1;
+    mutable Kokkos::View<double *, DeviceType> _export_buffer;
+    mutable typename Kokkos::View<double *, DeviceType>::HostMirror
+        _export_buffer_host;
+    mutable Kokkos::View<double *, DeviceType> _import_buffer;
+    mutable typename Kokkos::View<double *, DeviceType>::HostMirror
+        _import_buffer_host;
+    mutable std::vector<MPI_Request> _requests;
+    // Buffers of fetchChanged(). The positions of the changed entries among
+    // the entries exchanged with a rank are sent apart from the values.
+    using IntHostMirror = typename Kokkos::View<int *, DeviceType>::HostMirror;
+    mutable Kokkos::View<int *, DeviceType> _export_positions;
+    mutable Kokkos::View<int *, DeviceType> _send_offsets_device;
+    mutable Kokkos::View<int *, DeviceType> _recv_offsets_device;
+    mutable Kokkos::View<int *, DeviceType> _changed_slots;
+    mutable Kokkos::View<int *, DeviceType> _changed_send_offsets;
+    mutable IntHostMirror _changed_send_offsets_host;
+    mutable Kokkos::View<int *, DeviceType> _changed_positions;
+    mutable IntHostMirror _changed_positions_host;
+    mutable Kokkos::View<int *, DeviceType> _changed_recv_offsets;
+    mutable IntHostMirror _changed_recv_offsets_host;
+    mutable Kokkos::View<int *, DeviceType> _received_positions;
+    mutable IntHostMirror _received_positions_host;
+    mutable Kokkos::View<int *, DeviceType> _changed_rows;
+    mutable std::vector<int> _changed_send_counts;
+    mutable std::vector<int> _changed_recv_counts;
+    mutable int _changed_export_size = 0;
+};
+
+} // namespace Details
+} // namespace DataTransferKit
+
+#endif
@@ -21,13 +21,17 @@ namespace DataTransferKit
 {
 namespace Details
 {
-template <typename DeviceType>
+// OffsetType is the type of the stencil offsets. It must be able to hold the
+// number of stencil entries times the square of the size of the polynomial
+// basis.
+template <typename DeviceType, typename OffsetType = int>
 struct MovingLeastSquaresOperatorImpl
 {
     using ExecutionSpace = typename DeviceType::execution_space;
 
     static Kokkos::View<ArborX::Nearest<ArborX::Point> *, DeviceType>
-    makeKNNQueries( typename Kokkos::View<Coordinate **, DeviceType>::const_type
+    makeKNNQueries( Kokkos::View<Coordinate const **, Kokkos::LayoutStride,
+                                 DeviceType>
                         target_points,
                     unsigned int n_neighbors )
     {
@@ -47,33 +51,78 @@ struct MovingLeastSquaresOperatorImpl
         return queries;
     }
 
+    // Convert the offsets returned by the search to OffsetType. No copy is
+    // made when OffsetType is int.
+    static void convertOffset( Kokkos::View<int *, DeviceType> offset,
+                               Kokkos::View<int *, DeviceType> &out )
+    {
+        out = offset;
+    }
+
+    template <typename T>
+    static void convertOffset( Kokkos::View<int *, DeviceType> offset,
+                               Kokkos::View<T *, DeviceType> &out )
+    {
+        auto const n = offset.extent( 0 );
+        out = Kokkos::View<T *, DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( offset.label() ), n );
+        auto converted = out;
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "convert_offset" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n ),
+            KOKKOS_LAMBDA( int i ) { converted( i ) = offset( i ); } );
+        Kokkos::fence();
+    }
+
     static Kokkos::View<double *, DeviceType> computeTargetValues(
-        Kokkos::View<int const *, DeviceType> offset,
+        Kokkos::View<OffsetType const *, DeviceType> offset,
         Kokkos::View<double const *, DeviceType> polynomial_coeffs,
         Kokkos::View<double const *, DeviceType> source_values )
     {
-        auto const n_target_points = offset.extent_int( 0 ) - 1;
         Kokkos::View<double *, DeviceType> target_values(
-            std::string( "target_" ) + source_values.label(), n_target_points );
+            std::string( "target_" ) + source_values.label(),
+            offset.extent_int( 0 ) - 1 );
+        computeTargetValues( offset, polynomial_coeffs, source_values,
+                             target_values );
+        return target_values;
+    }
+
+    // Same as above but write into a preallocated view. The values may have
+    // several components, one per column.
+    template <typename SourceValues, typename TargetValues>
+    static void computeTargetValues(
+        Kokkos::View<OffsetType const *, DeviceType> offset,
+        Kokkos::View<double const *, DeviceType> polynomial_coeffs,
+        SourceValues source_values, TargetValues target_values )
+    {
+        static_assert( SourceValues::rank == TargetValues::rank,
+                       "source and target values must have the same rank" );
+        auto const n_target_points = offset.extent_int( 0 ) - 1;
+        int const n_components = target_values.extent( 1 );
+        DTK_REQUIRE( target_values.extent_int( 0 ) == n_target_points );
+        DTK_REQUIRE( source_values.extent_int( 1 ) == n_components );
 
         Kokkos::parallel_for(
             DTK_MARK_REGION( "compute_values" ),
             Kokkos::RangePolicy<ExecutionSpace>( 0, n_target_points ),
             KOKKOS_LAMBDA( const int i ) {
-                target_values( i ) = 0.;
-                for ( int j = offset( i ); j < offset( i + 1 ); ++j )
-                    target_values( i ) +=
-                        polynomial_coeffs( j ) * source_values( j );
+                for ( int c = 0; c < n_components; ++c )
+                {
+                    double value = 0.;
+                    for ( OffsetType j = offset( i ); j < offset( i + 1 ); ++j )
+                        value += polynomial_coeffs( j ) *
+                                 source_values.access( j, c );
+                    target_values.access( i, c ) = value;
+                }
             } );
         Kokkos::fence();
-
-        return target_values;
     }
 
     static Kokkos::View<Coordinate **, DeviceType> transformSourceCoordinates(
         Kokkos::View<Coordinate const **, DeviceType> source_points,
-        Kokkos::View<int const *, DeviceType> offset,
-        Kokkos::View<Coordinate const **, DeviceType> target_points )
+        Kokkos::View<OffsetType const *, DeviceType> offset,
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            target_points )
     {
         auto const n_source_points = source_points.extent( 0 );
         auto const n_target_points = target_points.extent( 0 );
@@ -90,7 +139,7 @@ struct MovingLeastSquaresOperatorImpl
             DTK_MARK_REGION( "transform" ),
             Kokkos::RangePolicy<ExecutionSpace>( 0, n_target_points ),
             KOKKOS_LAMBDA( const int i ) {
-                for ( int j = offset( i ); j < offset( i + 1 ); j++ )
+                for ( OffsetType j = offset( i ); j < offset( i + 1 ); j++ )
                     for ( int k = 0; k < spatial_dim; k++ )
                         new_source_points( j, k ) =
                             source_points( j, k ) - target_points( i, k );
@@ -101,7 +150,7 @@ struct MovingLeastSquaresOperatorImpl
 
     static Kokkos::View<double *, DeviceType>
     computeRadius( Kokkos::View<Coordinate const **, DeviceType> source_points,
-                   Kokkos::View<int const *, DeviceType> offset )
+                   Kokkos::View<OffsetType const *, DeviceType> offset )
     {
         unsigned int const n_target_points = offset.extent( 0 ) - 1;
         Kokkos::View<double *, DeviceType> radius( "radius",
@@ -118,7 +167,7 @@ struct MovingLeastSquaresOperatorImpl
                 // positive value.
                 double distance =
                     10. * KokkosExt::ArithmeticTraits::epsilon<double>::value;
-                for ( int j = offset( i ); j < offset( i + 1 ); ++j )
+                for ( OffsetType j = offset( i ); j < offset( i + 1 ); ++j )
                 {
                     double new_distance = ArborX::Details::distance(
                         ArborX::Point{{source_points( j, 0 ),
@@ -132,7 +181,7 @@ struct MovingLeastSquaresOperatorImpl
                 // If a point is exactly on the boundary of the compact domain,
                 // its weight will be zero so we need to make sure that no point
                 // is exactly on the boundary.
-                for ( int j = offset( i ); j < offset( i + 1 ); ++j )
+                for ( OffsetType j = offset( i ); j < offset( i + 1 ); ++j )
                     radius( j ) = 1.1 * distance;
             } );
 
@@ -148,7 +197,7 @@ struct MovingLeastSquaresOperatorImpl
                     Kokkos::View<double const *, DeviceType> radius,
                     RBF const & )
     {
-        auto const n_source_points = source_points.extent( 0 );
+        OffsetType const n_source_points = source_points.extent( 0 );
 
         DTK_REQUIRE( source_points.extent_int( 1 ) == 3 );
 
@@ -159,7 +208,7 @@ struct MovingLeastSquaresOperatorImpl
         Kokkos::parallel_for(
             DTK_MARK_REGION( "compute_weights" ),
             Kokkos::RangePolicy<ExecutionSpace>( 0, n_source_points ),
-            KOKKOS_LAMBDA( int i ) {
+            KOKKOS_LAMBDA( OffsetType i ) {
                 RadialBasisFunction<RBF> rbf( radius( i ) );
                 phi( i ) = rbf( ArborX::Details::distance(
                     ArborX::Point{{source_points( i, 0 ), source_points( i, 1 ),
@@ -175,14 +224,14 @@ struct MovingLeastSquaresOperatorImpl
     computeVandermonde( Kokkos::View<Coordinate const **, DeviceType> points,
                         PolynomialBasis const &polynomial_basis )
     {
-        auto const n_points = points.extent( 0 );
+        OffsetType const n_points = points.extent( 0 );
         auto constexpr size_polynomial_basis = PolynomialBasis::size;
         Kokkos::View<double *, DeviceType> p(
             "vandermonde", n_points * size_polynomial_basis );
         Kokkos::parallel_for(
             DTK_MARK_REGION( "compute_polynomial_basis" ),
             Kokkos::RangePolicy<ExecutionSpace>( 0, n_points ),
-            KOKKOS_LAMBDA( int i ) {
+            KOKKOS_LAMBDA( OffsetType i ) {
                 auto const tmp = polynomial_basis( ArborX::Point{
                     {points( i, 0 ), points( i, 1 ), points( i, 2 )}} );
                 for ( int j = 0; j < size_polynomial_basis; ++j )
@@ -192,24 +241,25 @@ struct MovingLeastSquaresOperatorImpl
     }
 
     static Kokkos::View<double *, DeviceType>
-    computeMoments( Kokkos::View<int const *, DeviceType> offset,
+    computeMoments( Kokkos::View<OffsetType const *, DeviceType> offset,
                     Kokkos::View<double const *, DeviceType> p,
                     Kokkos::View<double const *, DeviceType> phi )
     {
-        auto const n_target_points = offset.extent_int( 0 ) - 1;
-        auto const n_source_points = phi.extent_int( 0 );
+        OffsetType const n_target_points = offset.extent( 0 ) - 1;
+        OffsetType const n_source_points = phi.extent( 0 );
         DTK_REQUIRE( n_source_points == ArborX::lastElement( offset ) );
         if ( n_source_points == 0 )
             return Kokkos::View<double *, DeviceType>( "moments", 0 );
-        auto const size_polynomial_basis = p.extent_int( 0 ) / n_source_points;
-        auto const size_polynomial_basis_squared =
+        int const size_polynomial_basis = p.extent( 0 ) / n_source_points;
+        int const size_polynomial_basis_squared =
             size_polynomial_basis * size_polynomial_basis;
         Kokkos::View<double *, DeviceType> a(
             "moments", n_target_points * size_polynomial_basis_squared );
         Kokkos::parallel_for(
             DTK_MARK_REGION( "compute_moments" ),
             Kokkos::RangePolicy<ExecutionSpace>( 0, n_target_points ),
-            KOKKOS_LAMBDA( int i ) {
+            KOKKOS_LAMBDA( OffsetType i ) {
+                int const n_i = offset( i + 1 ) - offset( i );
                 auto p_i = Kokkos::subview(
                     p, Kokkos::make_pair( offset( i ) * size_polynomial_basis,
                                           offset( i + 1 ) *
@@ -224,8 +274,7 @@ struct MovingLeastSquaresOperatorImpl
                     for ( int k = 0; k < size_polynomial_basis; ++k )
                     {
                         double tmp = 0.;
-                        for ( int l = 0; l < offset( i + 1 ) - offset( i );
-                              ++l )
+                        for ( int l = 0; l < n_i; ++l )
                             // Compute value (j,k)
                             tmp += p_i( l * size_polynomial_basis + j ) *
                                    phi_i( l ) *
@@ -247,7 +296,7 @@ struct MovingLeastSquaresOperatorImpl
     {
         Kokkos::View<double *, DeviceType> inv_a( "inv_a", a.extent( 0 ) );
 
-        auto num_matrices =
+        OffsetType const num_matrices =
             a.extent( 0 ) / ( size_polynomial_basis * size_polynomial_basis );
 
         // We request auxiliary space for matrices E, U, and V (thus, 3) that
@@ -260,8 +309,8 @@ struct MovingLeastSquaresOperatorImpl
                                                  3 * num_matrices *
                                                      size_polynomial_basis );
 
-        SVDFunctor<DeviceType> svdFunctor( size_polynomial_basis, a, inv_a,
-                                           aux );
+        SVDFunctor<DeviceType, OffsetType> svdFunctor( size_polynomial_basis,
+                                                       a, inv_a, aux );
         size_t num_underdetermined = 0;
         Kokkos::parallel_reduce(
             DTK_MARK_REGION( "compute_svd_inverse" ),
@@ -272,7 +321,7 @@ struct MovingLeastSquaresOperatorImpl
     }
 
     static Kokkos::View<double *, DeviceType> computePolynomialCoefficients(
-        Kokkos::View<int const *, DeviceType> offset,
+        Kokkos::View<OffsetType const *, DeviceType> offset,
         Kokkos::View<double const *, DeviceType> inv_a,
         Kokkos::View<double const *, DeviceType> p,
         Kokkos::View<double const *, DeviceType> phi,
@@ -281,7 +330,8 @@ struct MovingLeastSquaresOperatorImpl
         auto const size_polynomial_basis_squared =
             size_polynomial_basis * size_polynomial_basis;
 
-        auto num_matrices = inv_a.extent( 0 ) / size_polynomial_basis_squared;
+        OffsetType const num_matrices =
+            inv_a.extent( 0 ) / size_polynomial_basis_squared;
 
         Kokkos::View<double *, DeviceType> coeffs( "polynomial_coeffs",
                                                    phi.extent( 0 ) );
@@ -289,7 +339,8 @@ struct MovingLeastSquaresOperatorImpl
         Kokkos::parallel_for(
             DTK_MARK_REGION( "compute_polynomial_coeffs" ),
             Kokkos::RangePolicy<ExecutionSpace>( 0, num_matrices ),
-            KOKKOS_LAMBDA( const int i ) {
+            KOKKOS_LAMBDA( const OffsetType i ) {
+                int const n_i = offset( i + 1 ) - offset( i );
                 auto p_i = Kokkos::subview(
                     p, Kokkos::make_pair( offset( i ) * size_polynomial_basis,
                                           offset( i + 1 ) *
@@ -304,7 +355,7 @@ struct MovingLeastSquaresOperatorImpl
                     coeffs, Kokkos::make_pair( offset( i ), offset( i + 1 ) ) );
 
                 // coeffs = [1 0 ... 0] * a_inv * p^T * phi
-                for ( int k = 0; k < offset( i + 1 ) - offset( i ); k++ )
+                for ( int k = 0; k < n_i; k++ )
                 {
                     coeffs_i( k ) = 0.;
                     for ( int j = 0; j < size_polynomial_basis; j++ )
@@ -14,6 +14,13 @@
 
 #include <ArborX.hpp>
 #include <DTK_DBC.hpp>
+#include <DTK_DetailsPayloadCodec.hpp>
+#include <DTK_PayloadCompression.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <type_traits>
+#include <vector>
 
 namespace DataTransferKit
 {
@@ -25,9 +32,24 @@ struct NearestNeighborOperatorImpl
 {
     using ExecutionSpace = typename DeviceType::execution_space;
 
+    // The payloads are encoded on the host. Compression is only offered in
+    // the memory spaces whose host mirrors alias the views, so that the
+    // payloads are not copied to the host and back on every exchange.
+    static bool
+    supportsCompression( PayloadCompressionOptions const &compression )
+    {
+        using HostMirrorSpace = typename Kokkos::View<
+            double *, DeviceType>::HostMirror::memory_space;
+        return std::is_same<HostMirrorSpace,
+                            typename DeviceType::memory_space>::value ||
+               ( compression.coordinates == PayloadCompression::None &&
+                 compression.values == PayloadCompression::None );
+    }
+
     static Kokkos::View<ArborX::Nearest<ArborX::Point> *, DeviceType>
     makeNearestNeighborQueries(
-        Kokkos::View<Coordinate const **, DeviceType> target_points )
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            target_points )
     {
         int const n_target_points = target_points.extent( 0 );
         Kokkos::View<ArborX::Nearest<ArborX::Point> *, DeviceType>
@@ -44,16 +66,17 @@ struct NearestNeighborOperatorImpl
         return nearest_queries;
     }
 
-    template <typename View>
+    template <typename View, typename BufferView>
     static void
     pullSourceValues( MPI_Comm comm, View source_values,
                       Kokkos::View<int *, DeviceType> &buffer_indices,
                       Kokkos::View<int *, DeviceType> &buffer_ranks,
-                      typename View::non_const_type &buffer_values )
+                      BufferView &buffer_values )
     {
         static_assert(
             View::rank == 1 || View::rank == 2,
             "pullSourceValues() requires rank-1 or rank-2 view arguments" );
+        DTK_MARK_SCOPE( "pull_source_values" );
         int const n_exports = buffer_indices.extent( 0 );
         ArborX::Details::Distributor<DeviceType> distributor( comm );
         int const n_imports =
@@ -118,6 +141,7 @@ struct NearestNeighborOperatorImpl
         static_assert(
             View::rank == 1 || View::rank == 2,
             "pushTargetValues() requires rank-1 or rank-2 view arguments" );
+        DTK_MARK_SCOPE( "push_target_values" );
         ArborX::Details::Distributor<DeviceType> distributor( comm );
         int const n_imports =
             distributor.createFromSends( ExecutionSpace{}, buffer_ranks );
@@ -154,13 +178,158 @@ struct NearestNeighborOperatorImpl
         Kokkos::fence();
     }
 
+    // Same as above except that the values are encoded on the host before
+    // being sent. The exports are grouped by destination and ordered by target
+    // index, i.e. they follow the numbering of the points on the receiving
+    // rank. The host mirrors below alias the views, see supportsCompression().
+    template <typename View>
+    static void
+    pushTargetValues( MPI_Comm comm,
+                      Kokkos::View<int *, DeviceType> const &buffer_indices,
+                      Kokkos::View<int *, DeviceType> const &buffer_ranks,
+                      View const &buffer_values, View target_values,
+                      PayloadCompression compression, double tolerance,
+                      PayloadCompressionStatistics &statistics )
+    {
+        static_assert(
+            View::rank == 1 || View::rank == 2,
+            "pushTargetValues() requires rank-1 or rank-2 view arguments" );
+        if ( compression == PayloadCompression::None )
+        {
+            pushTargetValues( comm, buffer_indices, buffer_ranks,
+                              buffer_values, target_values );
+            return;
+        }
+        DTK_MARK_SCOPE( "push_compressed_target_values" );
+
+        int comm_rank;
+        MPI_Comm_rank( comm, &comm_rank );
+        int comm_size;
+        MPI_Comm_size( comm, &comm_size );
+
+        auto indices_host = Kokkos::create_mirror_view( buffer_indices );
+        Kokkos::deep_copy( indices_host, buffer_indices );
+        auto ranks_host = Kokkos::create_mirror_view( buffer_ranks );
+        Kokkos::deep_copy( ranks_host, buffer_ranks );
+        auto values_host = Kokkos::create_mirror_view( buffer_values );
+        Kokkos::deep_copy( values_host, buffer_values );
+
+        int const n_exports = ranks_host.extent( 0 );
+        int const n_cols = target_values.extent( 1 );
+
+        std::vector<int> permute( n_exports );
+        std::iota( permute.begin(), permute.end(), 0 );
+        std::sort( permute.begin(), permute.end(), [&]( int a, int b ) {
+            return ranks_host( a ) < ranks_host( b ) ||
+                   ( ranks_host( a ) == ranks_host( b ) &&
+                     indices_host( a ) < indices_host( b ) );
+        } );
+
+        std::vector<int> send_counts( comm_size, 0 );
+        for ( int i = 0; i < n_exports; ++i )
+            ++send_counts[ranks_host( i )];
+
+        std::vector<int> send_indices( n_exports );
+        std::vector<unsigned char> send_bytes;
+        std::vector<int> send_sizes( comm_size, 0 );
+        std::vector<double> rows;
+        for ( int r = 0, first = 0; r < comm_size; first += send_counts[r++] )
+        {
+            int const n = send_counts[r];
+            if ( n == 0 )
+                continue;
+            rows.resize( n * n_cols );
+            for ( int k = 0; k < n; ++k )
+            {
+                int const e = permute[first + k];
+                send_indices[first + k] = indices_host( e );
+                for ( int j = 0; j < n_cols; ++j )
+                    rows[k * n_cols + j] = values_host.access( e, j );
+            }
+            std::size_t const size_before = send_bytes.size();
+            PayloadCodec::encode( compression, tolerance, rows.data(), n,
+                                  n_cols, send_bytes );
+            send_sizes[r] = send_bytes.size() - size_before;
+            if ( r != comm_rank )
+            {
+                statistics.raw_bytes += n * n_cols * sizeof( double );
+                statistics.encoded_bytes += send_sizes[r];
+            }
+        }
+
+        std::vector<int> recv_counts( comm_size );
+        MPI_Alltoall( send_counts.data(), 1, MPI_INT, recv_counts.data(), 1,
+                      MPI_INT, comm );
+        std::vector<int> recv_sizes( comm_size );
+        MPI_Alltoall( send_sizes.data(), 1, MPI_INT, recv_sizes.data(), 1,
+                      MPI_INT, comm );
+
+        auto exclusive_scan = []( std::vector<int> const &v ) {
+            std::vector<int> offsets( v.size() + 1, 0 );
+            std::partial_sum( v.begin(), v.end(), offsets.begin() + 1 );
+            return offsets;
+        };
+        auto const send_count_offsets = exclusive_scan( send_counts );
+        auto const send_size_offsets = exclusive_scan( send_sizes );
+        auto const recv_count_offsets = exclusive_scan( recv_counts );
+        auto const recv_size_offsets = exclusive_scan( recv_sizes );
+
+        std::vector<int> recv_indices( recv_count_offsets.back() );
+        MPI_Alltoallv( send_indices.data(), send_counts.data(),
+                       send_count_offsets.data(), MPI_INT, recv_indices.data(),
+                       recv_counts.data(), recv_count_offsets.data(), MPI_INT,
+                       comm );
+        std::vector<unsigned char> recv_bytes( recv_size_offsets.back() );
+        MPI_Alltoallv( send_bytes.data(), send_sizes.data(),
+                       send_size_offsets.data(), MPI_UNSIGNED_CHAR,
+                       recv_bytes.data(), recv_sizes.data(),
+                       recv_size_offsets.data(), MPI_UNSIGNED_CHAR, comm );
+
+        auto target_values_host = Kokkos::create_mirror_view( target_values );
+        Kokkos::deep_copy( target_values_host, target_values );
+        for ( int r = 0; r < comm_size; ++r )
+        {
+            int const n = recv_counts[r];
+            if ( n == 0 )
+                continue;
+            rows.resize( n * n_cols );
+            std::size_t const consumed = PayloadCodec::decode(
+                recv_bytes.data() + recv_size_offsets[r], recv_sizes[r], n,
+                n_cols, rows.data() );
+            DTK_CHECK( consumed == static_cast<std::size_t>( recv_sizes[r] ) );
+            (void)consumed;
+            for ( int k = 0; k < n; ++k )
+                for ( int j = 0; j < n_cols; ++j )
+                    target_values_host.access(
+                        recv_indices[recv_count_offsets[r] + k], j ) =
+                        rows[k * n_cols + j];
+        }
+        Kokkos::deep_copy( target_values, target_values_host );
+    }
+
+    // The fetched values are returned in the default layout of the device
+    // regardless of the layout of the input.
     template <typename View>
-    static typename View::non_const_type
+    static Kokkos::View<typename View::non_const_data_type, DeviceType>
     fetch( MPI_Comm comm, Kokkos::View<int const *, DeviceType> ranks,
            Kokkos::View<int const *, DeviceType> indices, View values )
+    {
+        PayloadCompressionStatistics statistics;
+        return fetch( comm, ranks, indices, values, PayloadCompression::None,
+                      0., statistics );
+    }
+
+    template <typename View>
+    static Kokkos::View<typename View::non_const_data_type, DeviceType>
+    fetch( MPI_Comm comm, Kokkos::View<int const *, DeviceType> ranks,
+           Kokkos::View<int const *, DeviceType> indices, View values,
+           PayloadCompression compression, double tolerance,
+           PayloadCompressionStatistics &statistics )
     {
         static_assert( View::rank == 1 || View::rank == 2,
                        "fetch() requires rank-1 or rank-2 view arguments" );
+        using OutputView =
+            Kokkos::View<typename View::non_const_data_type, DeviceType>;
 
         DTK_REQUIRE( ranks.extent( 0 ) == indices.extent( 0 ) );
 
@@ -172,23 +341,21 @@ struct NearestNeighborOperatorImpl
             Kokkos::create_mirror( DeviceType(), indices );
         Kokkos::deep_copy( buffer_indices, indices );
 
-        auto buffer_values =
-            View::rank == 1
-                ? typename View::non_const_type( values.label(), 0 )
-                : typename View::non_const_type( values.label(), 0, 0 );
+        auto buffer_values = View::rank == 1
+                                 ? OutputView( values.label(), 0 )
+                                 : OutputView( values.label(), 0, 0 );
 
         pullSourceValues( comm, values, buffer_indices, buffer_ranks,
                           buffer_values );
 
         auto values_out =
             View::rank == 1
-                ? typename View::non_const_type( values.label(),
-                                                 ranks.extent( 0 ) )
-                : typename View::non_const_type(
-                      values.label(), ranks.extent( 0 ), values.extent( 1 ) );
+                ? OutputView( values.label(), ranks.extent( 0 ) )
+                : OutputView( values.label(), ranks.extent( 0 ),
+                              values.extent( 1 ) );
 
         pushTargetValues( comm, buffer_indices, buffer_ranks, buffer_values,
-                          values_out );
+                          values_out, compression, tolerance, statistics );
 
         DTK_ENSURE( ( values_out.extent( 0 ) == ranks.extent( 0 ) ) &&
                     ( values_out.extent( 1 ) == values.extent( 1 ) ) );
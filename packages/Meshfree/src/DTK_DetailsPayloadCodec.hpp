@@ -0,0 +1,237 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_DETAILS_PAYLOAD_CODEC_HPP
+#define DTK_DETAILS_PAYLOAD_CODEC_HPP
+
+#include <DTK_DBC.hpp>
+#include <DTK_PayloadCompression.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace DataTransferKit
+{
+namespace Details
+{
+
+/**
+ * Host-side encoder/decoder for the payloads exchanged by the point cloud
+ * operators. The payload is a row-major (n_rows, n_cols) array of doubles.
+ * Each column is encoded independently and is prefixed by a flag byte that
+ * records whether it was stored losslessly or as bounded single precision.
+ * The stream is self-delimiting given the number of rows and columns.
+ */
+struct PayloadCodec
+{
+    static void encode( PayloadCompression compression, double tolerance,
+                        double const *values, int n_rows, int n_cols,
+                        std::vector<unsigned char> &out )
+    {
+        DTK_REQUIRE( compression != PayloadCompression::None );
+        for ( int j = 0; j < n_cols; ++j )
+        {
+            double lo = std::numeric_limits<double>::max();
+            double hi = std::numeric_limits<double>::lowest();
+            bool finite = true;
+            for ( int i = 0; i < n_rows; ++i )
+            {
+                double const x = values[i * n_cols + j];
+                finite = finite && std::isfinite( x );
+                lo = std::min( lo, x );
+                hi = std::max( hi, x );
+            }
+            // Rounding the offset to single precision costs at most half an
+            // ulp of the extent, shifting by the origin a few ulps of the
+            // largest magnitude.
+            bool const use_float32 =
+                compression == PayloadCompression::BoundedFloat32 &&
+                n_rows > 0 && finite &&
+                hi - lo <= std::numeric_limits<float>::max() &&
+                std::ldexp( hi - lo, -24 ) +
+                        4 * std::numeric_limits<double>::epsilon() *
+                            std::max( std::abs( lo ), std::abs( hi ) ) <=
+                    tolerance;
+
+            out.push_back( use_float32 ? 1 : 0 );
+            if ( use_float32 )
+            {
+                unsigned char origin[sizeof( double )];
+                std::memcpy( origin, &lo, sizeof( double ) );
+                out.insert( out.end(), origin, origin + sizeof( double ) );
+                std::vector<std::uint32_t> words( n_rows );
+                for ( int i = 0; i < n_rows; ++i )
+                {
+                    float const f =
+                        static_cast<float>( values[i * n_cols + j] - lo );
+                    std::memcpy( &words[i], &f, sizeof( float ) );
+                }
+                encodeBytePlanes( words, out );
+            }
+            else
+            {
+                std::vector<std::uint64_t> words( n_rows );
+                for ( int i = 0; i < n_rows; ++i )
+                    std::memcpy( &words[i], &values[i * n_cols + j],
+                                 sizeof( double ) );
+                encodeBytePlanes( words, out );
+            }
+        }
+    }
+
+    // Return the number of bytes consumed.
+    static std::size_t decode( unsigned char const *in, std::size_t n_bytes,
+                               int n_rows, int n_cols, double *values )
+    {
+        std::size_t pos = 0;
+        for ( int j = 0; j < n_cols; ++j )
+        {
+            DTK_INSIST( pos < n_bytes );
+            unsigned char const flag = in[pos++];
+            DTK_INSIST( flag == 0 || flag == 1 );
+            if ( flag == 1 )
+            {
+                DTK_INSIST( pos + sizeof( double ) <= n_bytes );
+                double lo;
+                std::memcpy( &lo, in + pos, sizeof( double ) );
+                pos += sizeof( double );
+                std::vector<std::uint32_t> words( n_rows );
+                pos += decodeBytePlanes( in + pos, n_bytes - pos, words );
+                for ( int i = 0; i < n_rows; ++i )
+                {
+                    float f;
+                    std::memcpy( &f, &words[i], sizeof( float ) );
+                    values[i * n_cols + j] = lo + static_cast<double>( f );
+                }
+            }
+            else
+            {
+                std::vector<std::uint64_t> words( n_rows );
+                pos += decodeBytePlanes( in + pos, n_bytes - pos, words );
+                for ( int i = 0; i < n_rows; ++i )
+                    std::memcpy( &values[i * n_cols + j], &words[i],
+                                 sizeof( double ) );
+            }
+        }
+        return pos;
+    }
+
+  private:
+    // XOR each word with its predecessor and split the result into byte planes,
+    // most significant byte first. Sign, exponent, and leading mantissa bits of
+    // neighboring entries mostly agree so the leading planes are nearly all
+    // zeros.
+    template <typename UInt>
+    static void encodeBytePlanes( std::vector<UInt> const &words,
+                                  std::vector<unsigned char> &out )
+    {
+        int const n = words.size();
+        int const width = sizeof( UInt );
+        std::vector<unsigned char> planes( width * n );
+        UInt previous = 0;
+        for ( int i = 0; i < n; ++i )
+        {
+            UInt const delta = words[i] ^ previous;
+            previous = words[i];
+            for ( int b = 0; b < width; ++b )
+                planes[b * n + i] = static_cast<unsigned char>(
+                    ( delta >> ( 8 * ( width - 1 - b ) ) ) & 0xff );
+        }
+        encodeZeroRuns( planes, out );
+    }
+
+    template <typename UInt>
+    static std::size_t decodeBytePlanes( unsigned char const *in,
+                                         std::size_t n_bytes,
+                                         std::vector<UInt> &words )
+    {
+        int const n = words.size();
+        int const width = sizeof( UInt );
+        std::vector<unsigned char> planes( width * n );
+        std::size_t const consumed = decodeZeroRuns( in, n_bytes, planes );
+        UInt previous = 0;
+        for ( int i = 0; i < n; ++i )
+        {
+            UInt delta = 0;
+            for ( int b = 0; b < width; ++b )
+                delta = ( delta << 8 ) | planes[b * n + i];
+            previous ^= delta;
+            words[i] = previous;
+        }
+        return consumed;
+    }
+
+    // Control byte c < 128 is followed by c+1 literal bytes, c >= 128 stands for
+    // c-127 zeros.
+    static void encodeZeroRuns( std::vector<unsigned char> const &in,
+                                std::vector<unsigned char> &out )
+    {
+        std::size_t const n = in.size();
+        std::size_t i = 0;
+        while ( i < n )
+        {
+            std::size_t zeros = 0;
+            while ( i + zeros < n && in[i + zeros] == 0 && zeros < 128 )
+                ++zeros;
+            if ( zeros >= 2 || ( zeros == 1 && i + 1 == n ) )
+            {
+                out.push_back( static_cast<unsigned char>( 127 + zeros ) );
+                i += zeros;
+                continue;
+            }
+            std::size_t const first = i;
+            while ( i < n && i - first < 128 &&
+                    !( in[i] == 0 && i + 1 < n && in[i + 1] == 0 ) )
+                ++i;
+            out.push_back( static_cast<unsigned char>( i - first - 1 ) );
+            out.insert( out.end(), in.begin() + first, in.begin() + i );
+        }
+    }
+
+    static std::size_t decodeZeroRuns( unsigned char const *in,
+                                       std::size_t n_bytes,
+                                       std::vector<unsigned char> &out )
+    {
+        std::size_t const n = out.size();
+        std::size_t pos = 0;
+        std::size_t k = 0;
+        while ( k < n )
+        {
+            DTK_INSIST( pos < n_bytes );
+            unsigned int const c = in[pos++];
+            if ( c >= 128 )
+            {
+                std::size_t const zeros = c - 127;
+                DTK_INSIST( k + zeros <= n );
+                std::fill( out.begin() + k, out.begin() + k + zeros, 0 );
+                k += zeros;
+            }
+            else
+            {
+                std::size_t const length = c + 1;
+                DTK_INSIST( k + length <= n && pos + length <= n_bytes );
+                std::copy( in + pos, in + pos + length, out.begin() + k );
+                k += length;
+                pos += length;
+            }
+        }
+        return pos;
+    }
+};
+
+} // namespace Details
+} // namespace DataTransferKit
+
+#endif
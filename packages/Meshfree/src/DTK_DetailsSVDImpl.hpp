@@ -27,8 +27,9 @@ namespace Details
 // The original version of this functor was taken from Trilinos mini-tensor
 // package. It was adapted to work in a batched mode where matrices are given
 // in a flat 1D array. It also explicitly solves 2x2 singular-value
-// decomposition (svd) problems.
-template <typename DeviceType>
+// decomposition (svd) problems. IndexType numbers the matrices and must be
+// able to hold the size of the flat arrays.
+template <typename DeviceType, typename IndexType = int>
 struct SVDFunctor
 {
   public:
@@ -187,7 +188,8 @@ struct SVDFunctor
     }
 
     KOKKOS_INLINE_FUNCTION
-    void operator()( const int matrix_id, size_t &num_underdetermined ) const
+    void operator()( const IndexType matrix_id,
+                     size_t &num_underdetermined ) const
     {
         // TODO: This code (for getting A and pseudoA) can be updated later
         // to work with offsets so that we can solve for matrices of
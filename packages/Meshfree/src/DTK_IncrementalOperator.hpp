@@ -0,0 +1,262 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_INCREMENTAL_OPERATOR_HPP
+#define DTK_INCREMENTAL_OPERATOR_HPP
+
+#include <DTK_ConfigDefs.hpp>
+#include <DTK_CrsMatrix.hpp>
+#include <DTK_DBC.hpp>
+#include <DTK_DetailsCommunicationPlan.hpp>
+#include <DTK_PointCloudOperator.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <utility>
+
+namespace DataTransferKit
+{
+
+/**
+ * Transfer of a field that only changes in part of the domain between
+ * steps. The operator keeps the source values it gathered during the last
+ * transfer; afterwards only the source values that changed are sent, and
+ * only the target values whose stencil contains one of them are computed
+ * again. The target values passed to applyChanged() must therefore hold the
+ * result of the previous transfer.
+ */
+template <typename DeviceType>
+class IncrementalOperator
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+
+  public:
+    // Collective over comm, which must be the communicator of the operator.
+    IncrementalOperator( MPI_Comm comm,
+                         PointCloudOperator<DeviceType> const &op )
+        : _fetched_values( "fetched_values", 0, 0 )
+        , _source_snapshot( "source_snapshot", 0, 0 )
+        , _changed( "changed", 0 )
+    {
+        auto const matrix = op.crsMatrix();
+        _offset = matrix.row_offsets;
+        _coeffs = matrix.values;
+        _size = matrix.num_local_columns;
+        _plan = Details::CommunicationPlan<DeviceType>(
+            comm, op.requestedRanks(), op.requestedIndices() );
+        DTK_CHECK( _plan.size() == _coeffs.extent_int( 0 ) );
+
+        // Row that each entry of the stencils belongs to.
+        int const n_rows = matrix.numLocalRows();
+        _entry_rows = Kokkos::View<int *, DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "entry_rows" ),
+            _coeffs.extent( 0 ) );
+        auto offset = _offset;
+        auto entry_rows = _entry_rows;
+        Kokkos::parallel_for( DTK_MARK_REGION( "entry_rows" ),
+                              Kokkos::RangePolicy<ExecutionSpace>( 0, n_rows ),
+                              KOKKOS_LAMBDA( int i ) {
+                                  for ( int j = offset( i );
+                                        j < offset( i + 1 ); ++j )
+                                      entry_rows( j ) = i;
+                              } );
+        Kokkos::fence();
+        _updated_rows = Kokkos::View<int *, DeviceType>( "updated_rows",
+                                                         n_rows );
+    }
+
+    /**
+     * Transfer all the values and record them as the reference for the next
+     * incremental transfers. Collective.
+     */
+    void apply( Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+                    source_values,
+                Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+                    target_values ) const
+    {
+        DTK_REQUIRE( source_values.extent_int( 0 ) == _size );
+        DTK_REQUIRE( target_values.extent( 0 ) == _offset.extent( 0 ) - 1 );
+        DTK_REQUIRE( source_values.extent( 1 ) == target_values.extent( 1 ) );
+
+        // The buffers only change with the number of components.
+        int const n_components = source_values.extent( 1 );
+        if ( _fetched_values.extent_int( 0 ) != _plan.size() ||
+             _fetched_values.extent_int( 1 ) != n_components )
+        {
+            _fetched_values = Kokkos::View<double **, Kokkos::LayoutLeft,
+                                           DeviceType>(
+                Kokkos::ViewAllocateWithoutInitializing( "fetched_values" ),
+                _plan.size(), n_components );
+            _source_snapshot = Kokkos::View<double **, Kokkos::LayoutLeft,
+                                            DeviceType>(
+                Kokkos::ViewAllocateWithoutInitializing( "source_snapshot" ),
+                _size, n_components );
+        }
+        Kokkos::deep_copy( _source_snapshot, source_values );
+        _plan.fetch( source_values, _fetched_values );
+        _n_sent = _plan.exportSize();
+
+        Kokkos::deep_copy( _updated_rows, 1 );
+        computeUpdatedRows( target_values );
+    }
+
+    /**
+     * Send only the source values flagged in changed, which is indexed like
+     * the local source points, and update the target values that depend on
+     * them. Falls back to apply() when no transfer with the same number of
+     * components happened before. Collective.
+     */
+    void
+    applyChanged( Kokkos::View<double const **, Kokkos::LayoutStride,
+                               DeviceType>
+                      source_values,
+                  Kokkos::View<bool const *, DeviceType> changed,
+                  Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+                      target_values ) const
+    {
+        DTK_REQUIRE( source_values.extent_int( 0 ) == _size );
+        DTK_REQUIRE( changed.extent_int( 0 ) == _size );
+        DTK_REQUIRE( target_values.extent( 0 ) == _offset.extent( 0 ) - 1 );
+        DTK_REQUIRE( source_values.extent( 1 ) == target_values.extent( 1 ) );
+
+        if ( _fetched_values.extent( 1 ) != source_values.extent( 1 ) )
+        {
+            apply( source_values, target_values );
+            return;
+        }
+
+        int const n_components = source_values.extent( 1 );
+        auto snapshot = _source_snapshot;
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "update_snapshot" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, _size ),
+            KOKKOS_LAMBDA( int i ) {
+                if ( changed( i ) )
+                    for ( int j = 0; j < n_components; ++j )
+                        snapshot( i, j ) = source_values( i, j );
+            } );
+        Kokkos::fence();
+
+        auto updated_entries =
+            _plan.fetchChanged( source_values, changed, _fetched_values );
+        _n_sent = _plan.changedExportSize();
+
+        // Only recompute the rows that use one of the received values.
+        Kokkos::deep_copy( _updated_rows, 0 );
+        auto updated_rows = _updated_rows;
+        auto entry_rows = _entry_rows;
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "flag_updated_rows" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0,
+                                                 updated_entries.extent( 0 ) ),
+            KOKKOS_LAMBDA( int k ) {
+                updated_rows( entry_rows( updated_entries( k ) ) ) = 1;
+            } );
+        Kokkos::fence();
+        computeUpdatedRows( target_values );
+    }
+
+    /**
+     * Same as above where a source value changed if one of its components
+     * differs from the last value sent by more than tolerance. Smaller
+     * differences accumulate until they exceed it, so that the source values
+     * used for the targets never lag by more than the tolerance.
+     */
+    void
+    applyChanged( Kokkos::View<double const **, Kokkos::LayoutStride,
+                               DeviceType>
+                      source_values,
+                  double tolerance,
+                  Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+                      target_values ) const
+    {
+        DTK_REQUIRE( tolerance >= 0. );
+        if ( _source_snapshot.extent( 1 ) != source_values.extent( 1 ) )
+        {
+            apply( source_values, target_values );
+            return;
+        }
+
+        int const n_components = source_values.extent( 1 );
+        if ( _changed.extent_int( 0 ) != _size )
+            _changed = Kokkos::View<bool *, DeviceType>(
+                Kokkos::ViewAllocateWithoutInitializing( "changed" ), _size );
+        auto changed = _changed;
+        auto snapshot = _source_snapshot;
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "compare_snapshot" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, _size ),
+            KOKKOS_LAMBDA( int i ) {
+                bool c = false;
+                for ( int j = 0; j < n_components; ++j )
+                {
+                    double const delta =
+                        source_values( i, j ) - snapshot( i, j );
+                    c = c || delta > tolerance || -delta > tolerance;
+                }
+                changed( i ) = c;
+            } );
+        Kokkos::fence();
+        applyChanged( source_values, changed, target_values );
+    }
+
+    // Number of source values sent by this rank (self included) during the
+    // last transfer.
+    int lastSendSize() const { return _n_sent; }
+
+  private:
+    // Recompute the flagged target values from the gathered source values.
+    void computeUpdatedRows(
+        Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+            target_values ) const
+    {
+        int const n_components = target_values.extent( 1 );
+        auto offset = _offset;
+        auto coeffs = _coeffs;
+        auto fetched_values = _fetched_values;
+        auto updated_rows = _updated_rows;
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "compute_updated_values" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0,
+                                                 updated_rows.extent( 0 ) ),
+            KOKKOS_LAMBDA( int i ) {
+                if ( !updated_rows( i ) )
+                    return;
+                for ( int c = 0; c < n_components; ++c )
+                {
+                    double value = 0.;
+                    for ( int j = offset( i ); j < offset( i + 1 ); ++j )
+                        value += coeffs( j ) * fetched_values( j, c );
+                    target_values( i, c ) = value;
+                }
+            } );
+        Kokkos::fence();
+    }
+
+    int _size = 0;
+    Kokkos::View<int *, DeviceType> _offset;
+    Kokkos::View<double *, DeviceType> _coeffs;
+    Kokkos::View<int *, DeviceType> _entry_rows;
+    Details::CommunicationPlan<DeviceType> _plan;
+    mutable int _n_sent = 0;
+    mutable Kokkos::View<int *, DeviceType> _updated_rows;
+    mutable Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType>
+        _fetched_values;
+    mutable Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType>
+        _source_snapshot;
+    mutable Kokkos::View<bool *, DeviceType> _changed;
+};
+
+} // namespace DataTransferKit
+
+#endif
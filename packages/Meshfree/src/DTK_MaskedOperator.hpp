@@ -0,0 +1,238 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_MASKED_OPERATOR_HPP
+#define DTK_MASKED_OPERATOR_HPP
+
+#include <DTK_ConfigDefs.hpp>
+#include <DTK_CrsMatrix.hpp>
+#include <DTK_DBC.hpp>
+#include <DTK_DetailsCommunicationPlan.hpp>
+#include <DTK_PointCloudOperator.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace DataTransferKit
+{
+
+/**
+ * Transfer restricted to a subset of the target points, e.g. the points on a
+ * coupling interface of an operator built over all the target nodes. Only
+ * the source values in the stencils of the selected targets are sent and
+ * only the selected target values are computed. The communication plan of
+ * each subset is built the first time it is used and kept for the following
+ * transfers.
+ */
+template <typename DeviceType>
+class MaskedOperator
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+
+  public:
+    // Collective over comm, which must be the communicator of the operator.
+    MaskedOperator( MPI_Comm comm, PointCloudOperator<DeviceType> const &op )
+        : _comm( comm )
+        , _matrix( op.crsMatrix() )
+    {
+        _ranks = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                      op.requestedRanks() );
+        _indices = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), op.requestedIndices() );
+        _row_offsets = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), _matrix.row_offsets );
+        DTK_CHECK( _ranks.extent( 0 ) == _matrix.values.extent( 0 ) );
+    }
+
+    /**
+     * Compute target_values(target_indices(k), j) for every k. The other
+     * target values are left untouched. Collective; the subset may differ
+     * between ranks.
+     */
+    void apply( Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+                    source_values,
+                Kokkos::View<int const *, DeviceType> target_indices,
+                Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+                    target_values ) const
+    {
+        auto indices_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), target_indices );
+        std::vector<int> subset( indices_host.data(),
+                                 indices_host.data() +
+                                     indices_host.extent( 0 ) );
+        applySubset( source_values, subset, target_values );
+    }
+
+    // Same as above with the targets selected by a mask.
+    void
+    applyMasked( Kokkos::View<double const **, Kokkos::LayoutStride,
+                              DeviceType>
+                     source_values,
+                 Kokkos::View<bool const *, DeviceType> target_mask,
+                 Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+                     target_values ) const
+    {
+        DTK_REQUIRE( target_mask.extent_int( 0 ) == _matrix.numLocalRows() );
+
+        auto mask_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), target_mask );
+        std::vector<int> subset;
+        for ( unsigned int i = 0; i < mask_host.extent( 0 ); ++i )
+            if ( mask_host( i ) )
+                subset.push_back( i );
+        applySubset( source_values, subset, target_values );
+    }
+
+    // Number of subsets whose communication plan is kept.
+    int cacheSize() const { return _cache.size(); }
+
+    // Forget the communication plans of all the subsets.
+    void clearCache() const { _cache.clear(); }
+
+  private:
+    // Stencils of a subset of the targets and the plan to gather their
+    // source values.
+    struct Restriction
+    {
+        Kokkos::View<int *, DeviceType> rows;
+        Kokkos::View<int *, DeviceType> offset;
+        Kokkos::View<double *, DeviceType> coeffs;
+        Details::CommunicationPlan<DeviceType> plan;
+        Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> fetched_values;
+    };
+
+    void
+    applySubset( Kokkos::View<double const **, Kokkos::LayoutStride,
+                              DeviceType>
+                     source_values,
+                 std::vector<int> const &subset,
+                 Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+                     target_values ) const
+    {
+        DTK_REQUIRE( source_values.extent_int( 0 ) ==
+                     _matrix.num_local_columns );
+        DTK_REQUIRE( target_values.extent_int( 0 ) == _matrix.numLocalRows() );
+        DTK_REQUIRE( source_values.extent( 1 ) == target_values.extent( 1 ) );
+
+        // Building a plan is collective so all the ranks build one as soon as
+        // one of them sees a new subset.
+        auto it = _cache.find( subset );
+        int local_hit = ( it != _cache.end() ) ? 1 : 0;
+        int global_hit = 0;
+        MPI_Allreduce( &local_hit, &global_hit, 1, MPI_INT, MPI_MIN, _comm );
+        if ( !global_hit )
+        {
+            _cache[subset] = makeRestriction( subset );
+            it = _cache.find( subset );
+        }
+        Restriction &restriction = *it->second;
+
+        int const n_components = source_values.extent( 1 );
+        if ( restriction.fetched_values.extent_int( 1 ) < n_components )
+            restriction.fetched_values =
+                Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType>(
+                    Kokkos::ViewAllocateWithoutInitializing(
+                        "fetched_values" ),
+                    restriction.plan.size(), n_components );
+        auto fetched_values =
+            Kokkos::subview( restriction.fetched_values, Kokkos::ALL,
+                             std::make_pair( 0, n_components ) );
+        restriction.plan.fetch( source_values, fetched_values );
+
+        auto rows = restriction.rows;
+        auto offset = restriction.offset;
+        auto coeffs = restriction.coeffs;
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "compute_masked_values" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, rows.extent( 0 ) ),
+            KOKKOS_LAMBDA( int k ) {
+                for ( int c = 0; c < n_components; ++c )
+                {
+                    double value = 0.;
+                    for ( int j = offset( k ); j < offset( k + 1 ); ++j )
+                        value += coeffs( j ) * fetched_values( j, c );
+                    target_values( rows( k ), c ) = value;
+                }
+            } );
+        Kokkos::fence();
+    }
+
+    // Extract the stencils of the subset. Collective.
+    std::shared_ptr<Restriction>
+    makeRestriction( std::vector<int> const &subset ) const
+    {
+        int const n_rows = subset.size();
+        Kokkos::View<int *, Kokkos::HostSpace> offset( "offset", n_rows + 1 );
+        for ( int k = 0; k < n_rows; ++k )
+        {
+            DTK_REQUIRE( subset[k] >= 0 &&
+                         subset[k] < _matrix.numLocalRows() );
+            offset( k + 1 ) = offset( k ) + _row_offsets( subset[k] + 1 ) -
+                              _row_offsets( subset[k] );
+        }
+        int const n_entries = offset( n_rows );
+        Kokkos::View<int *, Kokkos::HostSpace> entries( "entries", n_entries );
+        Kokkos::View<int *, Kokkos::HostSpace> ranks( "ranks", n_entries );
+        Kokkos::View<int *, Kokkos::HostSpace> indices( "indices", n_entries );
+        for ( int k = 0; k < n_rows; ++k )
+            for ( int j = offset( k ); j < offset( k + 1 ); ++j )
+            {
+                int const e = _row_offsets( subset[k] ) + j - offset( k );
+                entries( j ) = e;
+                ranks( j ) = _ranks( e );
+                indices( j ) = _indices( e );
+            }
+
+        using MemorySpace = typename DeviceType::memory_space;
+        auto restriction = std::make_shared<Restriction>();
+        restriction->rows = Kokkos::View<int *, DeviceType>( "rows", n_rows );
+        Kokkos::deep_copy(
+            restriction->rows,
+            Kokkos::View<int const *, Kokkos::HostSpace,
+                         Kokkos::MemoryUnmanaged>( subset.data(), n_rows ) );
+        restriction->offset =
+            Kokkos::create_mirror_view_and_copy( MemorySpace(), offset );
+        auto entries_device =
+            Kokkos::create_mirror_view_and_copy( MemorySpace(), entries );
+        restriction->coeffs = Kokkos::View<double *, DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "coeffs" ), n_entries );
+        auto coeffs = restriction->coeffs;
+        auto values = _matrix.values;
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "restrict_coefficients" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_entries ),
+            KOKKOS_LAMBDA( int j ) {
+                coeffs( j ) = values( entries_device( j ) );
+            } );
+        Kokkos::fence();
+        restriction->plan = Details::CommunicationPlan<DeviceType>(
+            _comm, Kokkos::create_mirror_view_and_copy( MemorySpace(), ranks ),
+            Kokkos::create_mirror_view_and_copy( MemorySpace(), indices ) );
+        return restriction;
+    }
+
+    MPI_Comm _comm;
+    CrsMatrix<DeviceType> _matrix;
+    Kokkos::View<int *, Kokkos::HostSpace> _row_offsets;
+    Kokkos::View<int *, Kokkos::HostSpace> _ranks;
+    Kokkos::View<int *, Kokkos::HostSpace> _indices;
+    mutable std::map<std::vector<int>, std::shared_ptr<Restriction>> _cache;
+};
+
+} // namespace DataTransferKit
+
+#endif
@@ -13,8 +13,11 @@
 #define DTK_MOVING_LEAST_SQUARES_OPERATOR_DECL_HPP
 
 #include <DTK_CompactlySupportedRadialBasisFunctions.hpp>
+#include <DTK_DetailsCommunicationPlan.hpp>
 #include <DTK_MultivariatePolynomialBasis.hpp>
+#include <DTK_PayloadCompression.hpp>
 #include <DTK_PointCloudOperator.hpp>
+#include <DTK_SourceIndex.hpp>
 
 #include <mpi.h>
 
@@ -31,11 +34,18 @@ namespace DataTransferKit
  * The class is templated on the DeviceType, the radial basis function
  * (Wendland<0>, Wendland<2>, Wendland<4>, Wendland<6>, Wu<2>, Wu<4>,
  * Buhmann<2>, Buhmann<3>, or Buhmann<4>) and polynonial basis (<Constant, DIM>,
- * <Linear, DIM>, or <Quadratic, DIM>).
+ * <Linear, DIM>, or <Quadratic, DIM>). The offsets of the stencils and the
+ * indices of the intermediate arrays of the construction are of type
+ * OffsetType, use a 64-bit type when the number of stencil entries times the
+ * square of the basis size exceeds the range of int. The number of stencil
+ * entries on a rank must still fit in an int: the search returns int
+ * offsets, the stencil indices and ranks are int, and crsMatrix() has int row
+ * offsets.
  */
 template <typename DeviceType,
           typename CompactlySupportedRadialBasisFunction = Wendland<0>,
-          typename PolynomialBasis = MultivariatePolynomialBasis<Linear, 3>>
+          typename PolynomialBasis = MultivariatePolynomialBasis<Linear, 3>,
+          typename OffsetType = int>
 class MovingLeastSquaresOperator : public PointCloudOperator<DeviceType>
 {
     using ExecutionSpace = typename DeviceType::execution_space;
@@ -43,20 +53,108 @@ class MovingLeastSquaresOperator : public PointCloudOperator<DeviceType>
   public:
     MovingLeastSquaresOperator(
         MPI_Comm comm,
-        Kokkos::View<Coordinate const **, DeviceType> source_points,
-        Kokkos::View<Coordinate const **, DeviceType> target_points );
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            source_points,
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            target_points,
+        PayloadCompressionOptions const &compression =
+            PayloadCompressionOptions() );
+
+    /**
+     * Reuse the search tree of an index built over the source points, e.g.
+     * one shared with other operators mapping from the same source.
+     */
+    MovingLeastSquaresOperator(
+        SourceIndex<DeviceType> const &source_index,
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            target_points,
+        PayloadCompressionOptions const &compression =
+            PayloadCompressionOptions() );
 
     void
     apply( Kokkos::View<double const *, DeviceType> source_values,
            Kokkos::View<double *, DeviceType> target_values ) const override;
 
+    void apply( Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+                    source_values,
+                Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+                    target_values ) const override;
+
+    void applyTranspose(
+        Kokkos::View<double const *, DeviceType> target_values,
+        Kokkos::View<double *, DeviceType> source_values ) const override;
+
+    void applyTranspose(
+        Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+            target_values,
+        Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+            source_values ) const override;
+
+    Kokkos::View<int const *, DeviceType> requestedRanks() const override
+    {
+        return _ranks;
+    }
+
+    Kokkos::View<int const *, DeviceType> requestedIndices() const override
+    {
+        return _indices;
+    }
+
+    void applyFetched(
+        Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+            fetched_values,
+        Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+            target_values ) const override;
+
+    CrsMatrix<DeviceType> crsMatrix() const override;
+
+    OperatorStatistics statistics() const override;
+
+    /**
+     * Size of the source coordinates sent to other ranks during the
+     * construction of the operator, before and after encoding.
+     */
+    PayloadCompressionStatistics coordinatesCompressionStatistics() const
+    {
+        return _coordinates_statistics;
+    }
+
+    /**
+     * Cumulative size of the source values sent to other ranks by apply(),
+     * before and after encoding.
+     */
+    PayloadCompressionStatistics valuesCompressionStatistics() const
+    {
+        return _values_statistics;
+    }
+
   private:
+    // Buffer receiving the source values needed on this rank.
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType>
+    fetchedValues( int n_components ) const;
+
+    // Plan of the exchange of the source values, built the first time it is
+    // needed. Operators that are only applied through a
+    // PointCloudOperatorGroup, or that compress the values, never build it.
+    // Collective.
+    Details::CommunicationPlan<DeviceType> const &plan() const;
+
     MPI_Comm _comm;
     unsigned int const _n_source_points;
-    Kokkos::View<int *, DeviceType> _offset;
+    Kokkos::View<OffsetType *, DeviceType> _offset;
     Kokkos::View<int *, DeviceType> _ranks;
     Kokkos::View<int *, DeviceType> _indices;
     Kokkos::View<double *, DeviceType> _coeffs;
+    int _num_underdetermined = 0;
+    PayloadCompressionOptions const _compression;
+    PayloadCompressionStatistics _coordinates_statistics;
+    mutable PayloadCompressionStatistics _values_statistics;
+    mutable bool _has_plan = false;
+    mutable Details::CommunicationPlan<DeviceType> _plan;
+    // Source values gathered by apply(), only reallocated when a field with
+    // more components than before is transferred.
+    mutable Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType>
+        _fetched_values;
 };
 
 } // end namespace DataTransferKit
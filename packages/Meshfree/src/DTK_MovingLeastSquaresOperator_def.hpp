@@ -17,85 +17,107 @@
 #include <DTK_DetailsMovingLeastSquaresOperatorImpl.hpp>
 #include <DTK_DetailsNearestNeighborOperatorImpl.hpp> // fetch
 
+#include <cmath>
+
 namespace DataTransferKit
 {
 
 template <typename DeviceType, typename CompactlySupportedRadialBasisFunction,
-          typename PolynomialBasis>
+          typename PolynomialBasis, typename OffsetType>
 MovingLeastSquaresOperator<DeviceType, CompactlySupportedRadialBasisFunction,
-                           PolynomialBasis>::
+                           PolynomialBasis, OffsetType>::
     MovingLeastSquaresOperator(
         MPI_Comm comm,
-        Kokkos::View<Coordinate const **, DeviceType> source_points,
-        Kokkos::View<Coordinate const **, DeviceType> target_points )
-    : _comm( comm )
-    , _n_source_points( source_points.extent( 0 ) )
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            source_points,
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            target_points,
+        PayloadCompressionOptions const &compression )
+    : MovingLeastSquaresOperator(
+          SourceIndex<DeviceType>( comm, source_points ), target_points,
+          compression )
+{
+}
+
+template <typename DeviceType, typename CompactlySupportedRadialBasisFunction,
+          typename PolynomialBasis, typename OffsetType>
+MovingLeastSquaresOperator<DeviceType, CompactlySupportedRadialBasisFunction,
+                           PolynomialBasis, OffsetType>::
+    MovingLeastSquaresOperator(
+        SourceIndex<DeviceType> const &source_index,
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            target_points,
+        PayloadCompressionOptions const &compression )
+    : _comm( source_index.comm() )
+    , _n_source_points( source_index.size() )
     , _offset( "offset", 0 )
     , _ranks( "ranks", 0 )
     , _indices( "indices", 0 )
     , _coeffs( "polynomial_coefficients", 0 )
+    , _compression( compression )
 {
+    auto const source_points = source_index.points();
     DTK_REQUIRE( source_points.extent_int( 1 ) ==
                  target_points.extent_int( 1 ) );
     // FIXME for now let's assume 3D
     DTK_REQUIRE( source_points.extent_int( 1 ) == 3 );
-
-    // Build distributed search tree over the source points.
-    ArborX::DistributedSearchTree<DeviceType> search_tree( _comm,
-                                                           source_points );
-    DTK_CHECK( !search_tree.empty() );
+    DTK_REQUIRE( std::isfinite( compression.float32_tolerance ) &&
+                 compression.float32_tolerance >= 0. );
+    DTK_INSIST( Details::NearestNeighborOperatorImpl<
+                DeviceType>::supportsCompression( compression ) );
+    DTK_MARK_SCOPE( "moving_least_squares_setup" );
 
     // For each target point, query the n_neighbors points closest to the
     // target.
-    auto queries =
-        Details::MovingLeastSquaresOperatorImpl<DeviceType>::makeKNNQueries(
-            target_points, PolynomialBasis::size );
+    using Impl =
+        Details::MovingLeastSquaresOperatorImpl<DeviceType, OffsetType>;
+    auto queries = Impl::makeKNNQueries( target_points, PolynomialBasis::size );
 
-    // Perform the actual search.
-    search_tree.query( queries, _indices, _offset, _ranks );
+    // Perform the actual search. The search returns 32-bit offsets, they are
+    // converted once to OffsetType for the kernels below.
+    {
+        DTK_MARK_SCOPE( "distributed_search" );
+        Kokkos::View<int *, DeviceType> offset( "offset", 0 );
+        source_index.tree().query( queries, _indices, offset, _ranks );
+        Impl::convertOffset( offset, _offset );
+    }
 
     // Retrieve the coordinates of all source points that met the predicates.
     // NOTE: This is the last collective.
-    source_points = Details::NearestNeighborOperatorImpl<DeviceType>::fetch(
-        _comm, _ranks, _indices, source_points );
+    auto fetched_points =
+        Details::NearestNeighborOperatorImpl<DeviceType>::fetch(
+            _comm, _ranks, _indices, source_points, _compression.coordinates,
+            _compression.float32_tolerance, _coordinates_statistics );
 
     // Transform source points
-    source_points = Details::MovingLeastSquaresOperatorImpl<
-        DeviceType>::transformSourceCoordinates( source_points, _offset,
-                                                 target_points );
-    target_points = Kokkos::View<Coordinate **, DeviceType>( "empty", 0, 0 );
+    auto const relative_points = Impl::transformSourceCoordinates(
+        fetched_points, _offset, target_points );
+    fetched_points = Kokkos::View<Coordinate **, DeviceType>( "empty", 0, 0 );
 
     // Build P (vandermonde matrix)
     // P is a single 1D storage for multiple P_i matrices. Each matrix is of
     // size (#source_points_for_specific_target_point, basis_size)
-    auto p =
-        Details::MovingLeastSquaresOperatorImpl<DeviceType>::computeVandermonde(
-            source_points, PolynomialBasis() );
+    auto p = Impl::computeVandermonde( relative_points, PolynomialBasis() );
 
     // To build the radial basis function, we need to define the radius of the
     // radial basis function. Since we use kNN, we need to compute the radius.
     // We only need the coordinates of the source points because of the
     // transformation of the coordinates.
-    auto radius =
-        Details::MovingLeastSquaresOperatorImpl<DeviceType>::computeRadius(
-            source_points, _offset );
+    auto radius = Impl::computeRadius( relative_points, _offset );
 
     // Build phi (weight matrix)
-    auto phi =
-        Details::MovingLeastSquaresOperatorImpl<DeviceType>::computeWeights(
-            source_points, radius, CompactlySupportedRadialBasisFunction() );
+    auto phi = Impl::computeWeights( relative_points, radius,
+                                     CompactlySupportedRadialBasisFunction() );
 
     // Build A (moment matrix)
-    auto a =
-        Details::MovingLeastSquaresOperatorImpl<DeviceType>::computeMoments(
-            _offset, p, phi );
+    auto a = Impl::computeMoments( _offset, p, phi );
 
     // TODO: it is computationally unnecessary to compute the pseudo-inverse as
     // MxM (U*E^+*V) as it will later be just used to do MxV. We could instead
     // return the (U,E^+,V) and do the MxV multiplication. But for now, it's OK.
-    auto t = Details::MovingLeastSquaresOperatorImpl<DeviceType>::invertMoments(
-        a, PolynomialBasis::size );
+    auto t = Impl::invertMoments( a, PolynomialBasis::size );
     auto inv_a = std::get<0>( t );
+    _num_underdetermined = std::get<1>( t );
 
     // std::get<1>(t) returns the number of undetermined system. However, this
     // is not enough to know if we will lose order of accuracy. For example, if
@@ -106,15 +128,15 @@ MovingLeastSquaresOperator<DeviceType, CompactlySupportedRadialBasisFunction,
 
     // NOTE: This assumes that the polynomial basis evaluated at {0,0,0} is
     // going to be [1, 0, 0, ..., 0]^T.
-    _coeffs = Details::MovingLeastSquaresOperatorImpl<
-        DeviceType>::computePolynomialCoefficients( _offset, inv_a, p, phi,
-                                                    PolynomialBasis::size );
+    _coeffs = Impl::computePolynomialCoefficients( _offset, inv_a, p, phi,
+                                                   PolynomialBasis::size );
 }
 
 template <typename DeviceType, typename CompactlySupportedRadialBasisFunction,
-          typename PolynomialBasis>
-void MovingLeastSquaresOperator<
-    DeviceType, CompactlySupportedRadialBasisFunction, PolynomialBasis>::
+          typename PolynomialBasis, typename OffsetType>
+void MovingLeastSquaresOperator<DeviceType,
+                                CompactlySupportedRadialBasisFunction,
+                                PolynomialBasis, OffsetType>::
     apply( Kokkos::View<double const *, DeviceType> source_values,
            Kokkos::View<double *, DeviceType> target_values ) const
 {
@@ -122,17 +144,188 @@ void MovingLeastSquaresOperator<
     DTK_REQUIRE( source_values.extent( 0 ) == _n_source_points );
     DTK_REQUIRE( target_values.extent( 0 ) == _offset.extent( 0 ) - 1 );
 
+    if ( _compression.values == PayloadCompression::None )
+    {
+        auto fetched_values =
+            Kokkos::subview( fetchedValues( 1 ), Kokkos::ALL, 0 );
+        plan().fetch( source_values, fetched_values );
+        Details::MovingLeastSquaresOperatorImpl<DeviceType, OffsetType>::
+            computeTargetValues( _offset, _coeffs, fetched_values,
+                                 target_values );
+        return;
+    }
+
     // Retrieve values for all source points
     source_values = Details::NearestNeighborOperatorImpl<DeviceType>::fetch(
-        _comm, _ranks, _indices, source_values );
+        _comm, _ranks, _indices, source_values, _compression.values,
+        _compression.float32_tolerance, _values_statistics );
 
     // Apply A-1 (P^T phi)
-    auto new_target_values = Details::MovingLeastSquaresOperatorImpl<
-        DeviceType>::computeTargetValues( _offset, _coeffs, source_values );
+    auto new_target_values =
+        Details::MovingLeastSquaresOperatorImpl<DeviceType, OffsetType>::
+            computeTargetValues( _offset, _coeffs, source_values );
 
     Kokkos::deep_copy( target_values, new_target_values );
 }
 
+template <typename DeviceType, typename CompactlySupportedRadialBasisFunction,
+          typename PolynomialBasis, typename OffsetType>
+void MovingLeastSquaresOperator<DeviceType,
+                                CompactlySupportedRadialBasisFunction,
+                                PolynomialBasis, OffsetType>::
+    apply( Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+               source_values,
+           Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+               target_values ) const
+{
+    // Precondition: check that the source and the target are properly sized
+    DTK_REQUIRE( source_values.extent( 0 ) == _n_source_points );
+    DTK_REQUIRE( target_values.extent( 0 ) == _offset.extent( 0 ) - 1 );
+    DTK_REQUIRE( source_values.extent( 1 ) == target_values.extent( 1 ) );
+
+    if ( _compression.values == PayloadCompression::None )
+    {
+        auto fetched_values = fetchedValues( source_values.extent( 1 ) );
+        plan().fetch( source_values, fetched_values );
+        Details::MovingLeastSquaresOperatorImpl<DeviceType, OffsetType>::
+            computeTargetValues( _offset, _coeffs, fetched_values,
+                                 target_values );
+        return;
+    }
+
+    // Retrieve values for all source points
+    auto fetched_values =
+        Details::NearestNeighborOperatorImpl<DeviceType>::fetch(
+            _comm, _ranks, _indices, source_values, _compression.values,
+            _compression.float32_tolerance, _values_statistics );
+
+    Details::MovingLeastSquaresOperatorImpl<DeviceType, OffsetType>::
+        computeTargetValues( _offset, _coeffs, fetched_values, target_values );
+}
+
+template <typename DeviceType, typename CompactlySupportedRadialBasisFunction,
+          typename PolynomialBasis, typename OffsetType>
+void MovingLeastSquaresOperator<DeviceType,
+                                CompactlySupportedRadialBasisFunction,
+                                PolynomialBasis, OffsetType>::
+    applyTranspose( Kokkos::View<double const *, DeviceType> target_values,
+                    Kokkos::View<double *, DeviceType> source_values ) const
+{
+    applyTranspose( Details::viewAsColumn( target_values ),
+                    Details::viewAsColumn( source_values ) );
+}
+
+template <typename DeviceType, typename CompactlySupportedRadialBasisFunction,
+          typename PolynomialBasis, typename OffsetType>
+void MovingLeastSquaresOperator<DeviceType,
+                                CompactlySupportedRadialBasisFunction,
+                                PolynomialBasis, OffsetType>::
+    applyTranspose( Kokkos::View<double const **, Kokkos::LayoutStride,
+                                 DeviceType>
+                        target_values,
+                    Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+                        source_values ) const
+{
+    // Precondition: check that the source and the target are properly sized
+    DTK_REQUIRE( source_values.extent( 0 ) == _n_source_points );
+    DTK_REQUIRE( target_values.extent( 0 ) == _offset.extent( 0 ) - 1 );
+    DTK_REQUIRE( source_values.extent( 1 ) == target_values.extent( 1 ) );
+    // The contributions are sent along the routes of apply() in the opposite
+    // direction.
+    DTK_INSIST( _compression.values == PayloadCompression::None );
+
+    // Weight the target values by the coefficients of their stencil. The
+    // buffer that receives the source values in apply() holds exactly one
+    // entry per coefficient.
+    int const n_components = target_values.extent( 1 );
+    auto contributions = fetchedValues( n_components );
+    auto offset = _offset;
+    auto coeffs = _coeffs;
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "weight_contributions" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, target_values.extent( 0 ) ),
+        KOKKOS_LAMBDA( int i ) {
+            for ( OffsetType j = offset( i ); j < offset( i + 1 ); ++j )
+                for ( int c = 0; c < n_components; ++c )
+                    contributions( j, c ) = coeffs( j ) * target_values( i, c );
+        } );
+    Kokkos::fence();
+
+    // Sum the contributions into the source values of their owner.
+    Kokkos::deep_copy( source_values, 0. );
+    plan().accumulate( contributions, source_values );
+}
+
+template <typename DeviceType, typename CompactlySupportedRadialBasisFunction,
+          typename PolynomialBasis, typename OffsetType>
+void MovingLeastSquaresOperator<DeviceType,
+                                CompactlySupportedRadialBasisFunction,
+                                PolynomialBasis, OffsetType>::
+    applyFetched( Kokkos::View<double const **, Kokkos::LayoutStride,
+                               DeviceType>
+                      fetched_values,
+                  Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+                      target_values ) const
+{
+    DTK_REQUIRE( fetched_values.extent( 0 ) == _indices.extent( 0 ) );
+    DTK_REQUIRE( target_values.extent( 0 ) == _offset.extent( 0 ) - 1 );
+
+    Details::MovingLeastSquaresOperatorImpl<DeviceType, OffsetType>::
+        computeTargetValues( _offset, _coeffs, fetched_values, target_values );
+}
+
+template <typename DeviceType, typename CompactlySupportedRadialBasisFunction,
+          typename PolynomialBasis, typename OffsetType>
+CrsMatrix<DeviceType>
+MovingLeastSquaresOperator<DeviceType, CompactlySupportedRadialBasisFunction,
+                           PolynomialBasis, OffsetType>::crsMatrix() const
+{
+    return Details::makeCrsMatrix<DeviceType>( _comm, _n_source_points,
+                                               _offset, _ranks, _indices,
+                                               _coeffs );
+}
+
+template <typename DeviceType, typename CompactlySupportedRadialBasisFunction,
+          typename PolynomialBasis, typename OffsetType>
+OperatorStatistics
+MovingLeastSquaresOperator<DeviceType, CompactlySupportedRadialBasisFunction,
+                           PolynomialBasis, OffsetType>::statistics() const
+{
+    return Details::computeOperatorStatistics<DeviceType>(
+        _comm, _offset, _ranks, _num_underdetermined );
+}
+
+template <typename DeviceType, typename CompactlySupportedRadialBasisFunction,
+          typename PolynomialBasis, typename OffsetType>
+Details::CommunicationPlan<DeviceType> const &
+MovingLeastSquaresOperator<DeviceType, CompactlySupportedRadialBasisFunction,
+                           PolynomialBasis, OffsetType>::plan() const
+{
+    if ( !_has_plan )
+    {
+        _plan =
+            Details::CommunicationPlan<DeviceType>( _comm, _ranks, _indices );
+        _has_plan = true;
+    }
+    return _plan;
+}
+
+template <typename DeviceType, typename CompactlySupportedRadialBasisFunction,
+          typename PolynomialBasis, typename OffsetType>
+Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType>
+MovingLeastSquaresOperator<
+    DeviceType, CompactlySupportedRadialBasisFunction, PolynomialBasis,
+    OffsetType>::fetchedValues( int n_components ) const
+{
+    if ( _fetched_values.extent_int( 1 ) < n_components )
+        _fetched_values =
+            Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType>(
+                Kokkos::ViewAllocateWithoutInitializing( "fetched_values" ),
+                _indices.extent( 0 ), n_components );
+    return Kokkos::subview( _fetched_values, Kokkos::ALL,
+                            std::make_pair( 0, n_components ) );
+}
+
 } // end namespace DataTransferKit
 
 // Explicit instantiation macro
@@ -140,6 +333,9 @@ void MovingLeastSquaresOperator<
     template class MovingLeastSquaresOperator<typename NODE::device_type>;     \
     template class MovingLeastSquaresOperator<                                 \
         typename NODE::device_type, Wendland<0>,                               \
-        MultivariatePolynomialBasis<Quadratic, 3>>;
+        MultivariatePolynomialBasis<Quadratic, 3>>;                            \
+    template class MovingLeastSquaresOperator<                                 \
+        typename NODE::device_type, Wendland<0>,                               \
+        MultivariatePolynomialBasis<Quadratic, 3>, long long>;
 
 #endif
@@ -12,7 +12,10 @@
 #ifndef DTK_NEAREST_NEIGHBOR_OPERATOR_DECL_HPP
 #define DTK_NEAREST_NEIGHBOR_OPERATOR_DECL_HPP
 
+#include <DTK_DetailsCommunicationPlan.hpp>
+#include <DTK_PayloadCompression.hpp>
 #include <DTK_PointCloudOperator.hpp>
+#include <DTK_SourceIndex.hpp>
 
 #include <mpi.h>
 
@@ -31,18 +34,91 @@ class NearestNeighborOperator : public PointCloudOperator<DeviceType>
   public:
     NearestNeighborOperator(
         MPI_Comm comm,
-        Kokkos::View<Coordinate const **, DeviceType> source_points,
-        Kokkos::View<Coordinate const **, DeviceType> target_points );
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            source_points,
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            target_points,
+        PayloadCompressionOptions const &compression =
+            PayloadCompressionOptions() );
+
+    /**
+     * Reuse the search tree of an index built over the source points, e.g.
+     * one shared with other operators mapping from the same source.
+     */
+    NearestNeighborOperator(
+        SourceIndex<DeviceType> const &source_index,
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            target_points,
+        PayloadCompressionOptions const &compression =
+            PayloadCompressionOptions() );
 
     void
     apply( Kokkos::View<double const *, DeviceType> source_values,
            Kokkos::View<double *, DeviceType> target_values ) const override;
 
+    void apply( Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+                    source_values,
+                Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+                    target_values ) const override;
+
+    void applyTranspose(
+        Kokkos::View<double const *, DeviceType> target_values,
+        Kokkos::View<double *, DeviceType> source_values ) const override;
+
+    void applyTranspose(
+        Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+            target_values,
+        Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+            source_values ) const override;
+
+    Kokkos::View<int const *, DeviceType> requestedRanks() const override
+    {
+        return _ranks;
+    }
+
+    Kokkos::View<int const *, DeviceType> requestedIndices() const override
+    {
+        return _indices;
+    }
+
+    void applyFetched(
+        Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+            fetched_values,
+        Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+            target_values ) const override;
+
+    CrsMatrix<DeviceType> crsMatrix() const override;
+
+    OperatorStatistics statistics() const override;
+
+    /**
+     * Cumulative size of the source values sent to other ranks by apply(),
+     * before and after encoding.
+     */
+    PayloadCompressionStatistics valuesCompressionStatistics() const
+    {
+        return _values_statistics;
+    }
+
   private:
+    // Offsets of the stencils, which all hold a single entry.
+    Kokkos::View<int *, DeviceType> unitOffset() const;
+
+    // Plan of the exchange of the source values. The owner of every source
+    // value needed by this rank never changes, so the requests are exchanged
+    // the first time the plan is needed and the plan is kept. Operators that
+    // are only applied through a PointCloudOperatorGroup, or that compress
+    // the values, never build it. Collective.
+    Details::CommunicationPlan<DeviceType> const &plan() const;
+
     MPI_Comm _comm;
     Kokkos::View<int *, DeviceType> _indices;
     Kokkos::View<int *, DeviceType> _ranks;
     int const _size;
+    PayloadCompressionOptions const _compression;
+    mutable PayloadCompressionStatistics _values_statistics;
+    mutable bool _has_plan = false;
+    mutable Details::CommunicationPlan<DeviceType> _plan;
 };
 
 } // namespace DataTransferKit
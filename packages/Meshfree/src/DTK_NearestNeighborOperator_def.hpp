@@ -16,29 +16,41 @@
 #include <DTK_DBC.hpp>
 #include <DTK_DetailsNearestNeighborOperatorImpl.hpp>
 
+#include <cmath>
+
 namespace DataTransferKit
 {
 
 template <typename DeviceType>
 NearestNeighborOperator<DeviceType>::NearestNeighborOperator(
-    MPI_Comm comm, Kokkos::View<Coordinate const **, DeviceType> source_points,
-    Kokkos::View<Coordinate const **, DeviceType> target_points )
-    : _comm( comm )
+    MPI_Comm comm,
+    Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+        source_points,
+    Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+        target_points,
+    PayloadCompressionOptions const &compression )
+    : NearestNeighborOperator( SourceIndex<DeviceType>( comm, source_points ),
+                               target_points, compression )
+{
+}
+
+template <typename DeviceType>
+NearestNeighborOperator<DeviceType>::NearestNeighborOperator(
+    SourceIndex<DeviceType> const &source_index,
+    Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+        target_points,
+    PayloadCompressionOptions const &compression )
+    : _comm( source_index.comm() )
     , _indices( "indices", 0 )
     , _ranks( "ranks", 0 )
-    , _size( source_points.extent_int( 0 ) )
+    , _size( source_index.size() )
+    , _compression( compression )
 {
-    // NOTE: instead of checking the pre-condition that there is at least one
-    // source point passed to one of the rank, we let the tree handle the
-    // communication and just check that the tree is not empty.
-
-    // Build distributed search tree over the source points.
-    ArborX::DistributedSearchTree<DeviceType> search_tree( _comm,
-                                                           source_points );
-
-    // Tree must have at least one leaf, otherwise it makes little sense to
-    // perform the search for nearest neighbors.
-    DTK_CHECK( !search_tree.empty() );
+    DTK_REQUIRE( std::isfinite( compression.float32_tolerance ) &&
+                 compression.float32_tolerance >= 0. );
+    DTK_INSIST( Details::NearestNeighborOperatorImpl<
+                DeviceType>::supportsCompression( compression ) );
+    DTK_MARK_SCOPE( "nearest_neighbor_setup" );
 
     // Query nearest neighbor for all target points.
     auto nearest_queries = Details::NearestNeighborOperatorImpl<
@@ -48,7 +60,10 @@ NearestNeighborOperator<DeviceType>::NearestNeighborOperator(
     Kokkos::View<int *, DeviceType> indices( "indices", 0 );
     Kokkos::View<int *, DeviceType> offset( "offset", 0 );
     Kokkos::View<int *, DeviceType> ranks( "ranks", 0 );
-    search_tree.query( nearest_queries, indices, offset, ranks );
+    {
+        DTK_MARK_SCOPE( "distributed_search" );
+        source_index.tree().query( nearest_queries, indices, offset, ranks );
+    }
 
     // Check post-condition that we did find a nearest neighbor to all target
     // points.
@@ -71,12 +86,136 @@ void NearestNeighborOperator<DeviceType>::apply(
     DTK_REQUIRE( _indices.extent( 0 ) == target_values.extent( 0 ) );
     DTK_REQUIRE( _size == source_values.extent_int( 0 ) );
 
+    if ( _compression.values == PayloadCompression::None )
+    {
+        plan().fetch( source_values, target_values );
+        return;
+    }
+
+    auto values = Details::NearestNeighborOperatorImpl<DeviceType>::fetch(
+        _comm, _ranks, _indices, source_values, _compression.values,
+        _compression.float32_tolerance, _values_statistics );
+
+    Kokkos::deep_copy( target_values, values );
+}
+
+template <typename DeviceType>
+void NearestNeighborOperator<DeviceType>::apply(
+    Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+        source_values,
+    Kokkos::View<double **, Kokkos::LayoutStride, DeviceType> target_values )
+    const
+{
+    // Precondition: check that the source and target are properly sized
+    DTK_REQUIRE( _indices.extent( 0 ) == target_values.extent( 0 ) );
+    DTK_REQUIRE( _size == source_values.extent_int( 0 ) );
+    DTK_REQUIRE( source_values.extent( 1 ) == target_values.extent( 1 ) );
+
+    if ( _compression.values == PayloadCompression::None )
+    {
+        plan().fetch( source_values, target_values );
+        return;
+    }
+
     auto values = Details::NearestNeighborOperatorImpl<DeviceType>::fetch(
-        _comm, _ranks, _indices, source_values );
+        _comm, _ranks, _indices, source_values, _compression.values,
+        _compression.float32_tolerance, _values_statistics );
 
     Kokkos::deep_copy( target_values, values );
 }
 
+template <typename DeviceType>
+void NearestNeighborOperator<DeviceType>::applyFetched(
+    Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+        fetched_values,
+    Kokkos::View<double **, Kokkos::LayoutStride, DeviceType> target_values )
+    const
+{
+    DTK_REQUIRE( _indices.extent( 0 ) == fetched_values.extent( 0 ) );
+    DTK_REQUIRE( _indices.extent( 0 ) == target_values.extent( 0 ) );
+    DTK_REQUIRE( fetched_values.extent( 1 ) == target_values.extent( 1 ) );
+
+    Kokkos::deep_copy( target_values, fetched_values );
+}
+
+template <typename DeviceType>
+CrsMatrix<DeviceType> NearestNeighborOperator<DeviceType>::crsMatrix() const
+{
+    // Every row holds a single unit entry in the column of the nearest
+    // neighbor.
+    int const n_targets = _indices.extent( 0 );
+    Kokkos::View<double *, DeviceType> ones(
+        Kokkos::ViewAllocateWithoutInitializing( "ones" ), n_targets );
+    Kokkos::deep_copy( ones, 1. );
+
+    return Details::makeCrsMatrix<DeviceType>( _comm, _size, unitOffset(),
+                                               _ranks, _indices, ones );
+}
+
+template <typename DeviceType>
+OperatorStatistics NearestNeighborOperator<DeviceType>::statistics() const
+{
+    return Details::computeOperatorStatistics<DeviceType>(
+        _comm, unitOffset(), _ranks, 0 );
+}
+
+template <typename DeviceType>
+Details::CommunicationPlan<DeviceType> const &
+NearestNeighborOperator<DeviceType>::plan() const
+{
+    if ( !_has_plan )
+    {
+        _plan = Details::CommunicationPlan<DeviceType>( _comm, _ranks,
+                                                        _indices );
+        _has_plan = true;
+    }
+    return _plan;
+}
+
+template <typename DeviceType>
+Kokkos::View<int *, DeviceType>
+NearestNeighborOperator<DeviceType>::unitOffset() const
+{
+    int const n_targets = _indices.extent( 0 );
+    Kokkos::View<int *, DeviceType> offset(
+        Kokkos::ViewAllocateWithoutInitializing( "offset" ), n_targets + 1 );
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "iota" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_targets + 1 ),
+        KOKKOS_LAMBDA( int i ) { offset( i ) = i; } );
+    Kokkos::fence();
+    return offset;
+}
+
+template <typename DeviceType>
+void NearestNeighborOperator<DeviceType>::applyTranspose(
+    Kokkos::View<double const *, DeviceType> target_values,
+    Kokkos::View<double *, DeviceType> source_values ) const
+{
+    applyTranspose( Details::viewAsColumn( target_values ),
+                    Details::viewAsColumn( source_values ) );
+}
+
+template <typename DeviceType>
+void NearestNeighborOperator<DeviceType>::applyTranspose(
+    Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+        target_values,
+    Kokkos::View<double **, Kokkos::LayoutStride, DeviceType> source_values )
+    const
+{
+    // Precondition: check that the source and target are properly sized
+    DTK_REQUIRE( _indices.extent( 0 ) == target_values.extent( 0 ) );
+    DTK_REQUIRE( _size == source_values.extent_int( 0 ) );
+    DTK_REQUIRE( source_values.extent( 1 ) == target_values.extent( 1 ) );
+    // The contributions are sent along the routes of apply() in the opposite
+    // direction.
+    DTK_INSIST( _compression.values == PayloadCompression::None );
+
+    // Every target value goes to its nearest source point.
+    Kokkos::deep_copy( source_values, 0. );
+    plan().accumulate( target_values, source_values );
+}
+
 } // namespace DataTransferKit
 
 // Explicit instantiation macro
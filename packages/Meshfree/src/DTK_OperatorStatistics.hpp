@@ -0,0 +1,138 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_OPERATOR_STATISTICS_HPP
+#define DTK_OPERATOR_STATISTICS_HPP
+
+#include <DTK_ConfigDefs.hpp>
+#include <DTK_DBC.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <vector>
+
+namespace DataTransferKit
+{
+
+/**
+ * Cost of an operator on this rank. The communication volumes are those of
+ * a single component transferred by apply(), before any payload compression.
+ */
+struct OperatorStatistics
+{
+    // stencil_sizes[s] is the number of local target points whose value is
+    // computed from s source values.
+    std::vector<int> stencil_sizes;
+    // Stencil entries whose source value lives on this rank or on another
+    // one.
+    int local_entries = 0;
+    int remote_entries = 0;
+    // Bytes sent to and received from other ranks and number of these ranks.
+    long long bytes_sent = 0;
+    long long bytes_received = 0;
+    int send_neighbors = 0;
+    int recv_neighbors = 0;
+    // Number of local target points and maximum over average of this number
+    // across the ranks.
+    int num_targets = 0;
+    double target_imbalance = 1.;
+    // Rank-deficient moment matrices, only for moving least squares.
+    int num_underdetermined = 0;
+};
+
+namespace Details
+{
+// Maximum over average of the number of target points across the ranks of
+// comm. Collective.
+inline double targetImbalance( MPI_Comm comm, int num_targets )
+{
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+    int max_targets = 0;
+    long long total_targets = 0;
+    long long const local_targets = num_targets;
+    MPI_Allreduce( &num_targets, &max_targets, 1, MPI_INT, MPI_MAX, comm );
+    MPI_Allreduce( &local_targets, &total_targets, 1, MPI_LONG_LONG, MPI_SUM,
+                   comm );
+    return total_targets > 0
+               ? max_targets /
+                     ( static_cast<double>( total_targets ) / comm_size )
+               : 1.;
+}
+
+// Statistics of an operator given its stencils, whose entries are requested
+// from ranks. The offsets may be of any integer type. The operator does not
+// need a communication plan: the volume sent to every rank is obtained by
+// exchanging the number of requests. Collective over comm.
+template <typename DeviceType, typename OffsetView>
+OperatorStatistics
+computeOperatorStatistics( MPI_Comm comm, OffsetView offset,
+                           Kokkos::View<int const *, DeviceType> ranks,
+                           int num_underdetermined )
+{
+    DTK_REQUIRE( offset.extent( 0 ) > 0 );
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+    auto offset_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), offset );
+    auto ranks_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), ranks );
+
+    OperatorStatistics statistics;
+    statistics.num_targets = offset_host.extent( 0 ) - 1;
+    for ( int i = 0; i < statistics.num_targets; ++i )
+    {
+        unsigned int const size = offset_host( i + 1 ) - offset_host( i );
+        if ( size >= statistics.stencil_sizes.size() )
+            statistics.stencil_sizes.resize( size + 1, 0 );
+        ++statistics.stencil_sizes[size];
+    }
+
+    // Every request is answered with one value.
+    std::vector<int> requests( comm_size, 0 );
+    for ( unsigned int j = 0; j < ranks_host.extent( 0 ); ++j )
+        ++requests[ranks_host( j )];
+    std::vector<int> answers( comm_size, 0 );
+    MPI_Alltoall( requests.data(), 1, MPI_INT, answers.data(), 1, MPI_INT,
+                  comm );
+    for ( int r = 0; r < comm_size; ++r )
+    {
+        if ( r == comm_rank )
+        {
+            statistics.local_entries = requests[r];
+            continue;
+        }
+        statistics.remote_entries += requests[r];
+        statistics.bytes_received +=
+            static_cast<long long>( requests[r] ) * sizeof( double );
+        statistics.bytes_sent +=
+            static_cast<long long>( answers[r] ) * sizeof( double );
+        if ( requests[r] > 0 )
+            ++statistics.recv_neighbors;
+        if ( answers[r] > 0 )
+            ++statistics.send_neighbors;
+    }
+    statistics.num_underdetermined = num_underdetermined;
+
+    statistics.target_imbalance =
+        targetImbalance( comm, statistics.num_targets );
+
+    return statistics;
+}
+} // namespace Details
+
+} // namespace DataTransferKit
+
+#endif
@@ -0,0 +1,76 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_PAYLOAD_COMPRESSION_HPP
+#define DTK_PAYLOAD_COMPRESSION_HPP
+
+#include <cstddef>
+
+namespace DataTransferKit
+{
+
+/**
+ * Encoding applied to the floating point payloads exchanged between ranks by
+ * the point cloud operators.
+ *
+ * - None: values are sent as raw doubles.
+ * - Lossless: values are sorted by destination, XOR-ed with the previous
+ *   entry of the same component, split into byte planes and run-length encoded.
+ *   Decoding is bit-exact.
+ * - BoundedFloat32: each component is shifted by the lower corner of the
+ *   bounding box of the payload and stored as single precision. The absolute
+ *   error is at most 2^-24 times the extent of the box. Components for which
+ *   the bound exceeds the tolerance fall back to Lossless, so the error never
+ *   exceeds the tolerance.
+ */
+enum class PayloadCompression
+{
+    None,
+    Lossless,
+    BoundedFloat32
+};
+
+/**
+ * Per-operator selection of the payload encoding. Coordinates are only
+ * exchanged during the setup of the MovingLeastSquaresOperator, values are
+ * exchanged on every apply. The payloads are encoded on the host, so
+ * compression is only available for operators whose memory space is the host
+ * memory space. The operators throw on construction otherwise.
+ */
+struct PayloadCompressionOptions
+{
+    PayloadCompression coordinates = PayloadCompression::None;
+    PayloadCompression values = PayloadCompression::None;
+    // Maximum absolute error accepted by BoundedFloat32. Must be finite and
+    // non-negative, the operators check it on construction.
+    double float32_tolerance = 1e-6;
+};
+
+/**
+ * Bytes that left the rank before and after encoding. Only off-rank traffic is
+ * accounted for.
+ */
+struct PayloadCompressionStatistics
+{
+    std::size_t raw_bytes = 0;
+    std::size_t encoded_bytes = 0;
+
+    double ratio() const
+    {
+        return encoded_bytes > 0
+                   ? static_cast<double>( raw_bytes ) / encoded_bytes
+                   : 1.;
+    }
+};
+
+} // namespace DataTransferKit
+
+#endif
@@ -13,6 +13,8 @@
 #define DTK_POINT_CLOUD_OPERATOR_DECL_HPP
 
 #include <DTK_ConfigDefs.hpp>
+#include <DTK_CrsMatrix.hpp>
+#include <DTK_OperatorStatistics.hpp>
 
 #include <Kokkos_View.hpp>
 
@@ -34,8 +36,84 @@ class PointCloudOperator
     virtual void
     apply( Kokkos::View<double const *, DeviceType> source_values,
            Kokkos::View<double *, DeviceType> target_values ) const = 0;
+
+    /**
+     * Same as above for a field with several components. Each column holds
+     * one component and all of them are transferred in a single exchange.
+     * Views of any layout convert to LayoutStride so the user storage can be
+     * passed without being repacked.
+     */
+    virtual void apply(
+        Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+            source_values,
+        Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+            target_values ) const = 0;
+
+    /**
+     * Apply the transpose of the operator: every target value is weighted by
+     * the coefficients used to compute it and added to the source values it
+     * depends on. This accumulates quantities defined at the target points,
+     * e.g. tallies, back onto the source points. The source values are
+     * overwritten.
+     */
+    virtual void applyTranspose(
+        Kokkos::View<double const *, DeviceType> target_values,
+        Kokkos::View<double *, DeviceType> source_values ) const = 0;
+
+    virtual void applyTranspose(
+        Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+            target_values,
+        Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+            source_values ) const = 0;
+
+    /**
+     * Owning rank and local index on that rank of the source values needed to
+     * compute the target values on this rank.
+     */
+    virtual Kokkos::View<int const *, DeviceType> requestedRanks() const = 0;
+    virtual Kokkos::View<int const *, DeviceType> requestedIndices() const = 0;
+
+    /**
+     * Compute the target values given the requested source values, already
+     * gathered in the order of requestedRanks() and requestedIndices(). This
+     * lets operators that map from the same source share the exchange.
+     */
+    virtual void applyFetched(
+        Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+            fetched_values,
+        Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+            target_values ) const = 0;
+
+    /**
+     * Export the operator as a distributed sparse matrix whose rows are the
+     * target points and columns the source points, so that it can be applied
+     * or composed with other linear operators outside of DTK. The entries are
+     * stored in the order of requestedRanks() and requestedIndices().
+     * Collective.
+     */
+    virtual CrsMatrix<DeviceType> crsMatrix() const = 0;
+
+    /**
+     * Stencil sizes, communication volume and load balance of the operator.
+     * They are computed from the stencils when requested, applying the
+     * operator does not keep track of anything. Collective.
+     */
+    virtual OperatorStatistics statistics() const = 0;
 };
 
+namespace Details
+{
+// View a rank-1 view as a rank-2 view with a single column.
+template <typename T, typename DeviceType>
+Kokkos::View<T **, Kokkos::LayoutStride, DeviceType>
+viewAsColumn( Kokkos::View<T *, DeviceType> values )
+{
+    int const n = values.extent( 0 );
+    return Kokkos::View<T **, Kokkos::LayoutStride, DeviceType>(
+        values.data(), Kokkos::LayoutStride( n, values.stride( 0 ), 1, n ) );
+}
+} // namespace Details
+
 } // end namespace DataTransferKit
 
 #endif
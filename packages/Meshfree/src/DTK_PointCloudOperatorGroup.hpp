@@ -0,0 +1,226 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_POINT_CLOUD_OPERATOR_GROUP_HPP
+#define DTK_POINT_CLOUD_OPERATOR_GROUP_HPP
+
+#include <DTK_ConfigDefs.hpp>
+#include <DTK_DBC.hpp>
+#include <DTK_DetailsCommunicationPlan.hpp>
+#include <DTK_OperatorStatistics.hpp>
+#include <DTK_PointCloudOperator.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace DataTransferKit
+{
+
+/**
+ * Several operators mapping the same source values to different targets.
+ * The union of the source values needed by all the operators is exchanged in
+ * a single round, so that a value needed by several targets is only sent
+ * once, before each operator computes its own target values.
+ */
+template <typename DeviceType>
+class PointCloudOperatorGroup
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+
+  public:
+    // Collective over comm, which must be the communicator of the operators.
+    PointCloudOperatorGroup(
+        MPI_Comm comm,
+        std::vector<std::shared_ptr<PointCloudOperator<DeviceType> const>>
+            operators )
+        : _comm( comm )
+        , _operators( std::move( operators ) )
+        , _offsets( 1, 0 )
+        , _fetched_values( "fetched_values", 0, 0 )
+        , _gathered_values( "gathered_values", 0, 0 )
+    {
+        // Gather the requests of all the operators.
+        std::vector<std::pair<int, int>> requests;
+        int max_requests = 0;
+        for ( auto const &op : _operators )
+        {
+            auto ranks = Kokkos::create_mirror_view_and_copy(
+                Kokkos::HostSpace(), op->requestedRanks() );
+            auto indices = Kokkos::create_mirror_view_and_copy(
+                Kokkos::HostSpace(), op->requestedIndices() );
+            DTK_REQUIRE( ranks.extent( 0 ) == indices.extent( 0 ) );
+            int const n = ranks.extent( 0 );
+            for ( int i = 0; i < n; ++i )
+                requests.emplace_back( ranks( i ), indices( i ) );
+            _offsets.push_back( _offsets.back() + n );
+            max_requests = std::max( max_requests, n );
+        }
+
+        // Only request each source value once.
+        std::vector<std::pair<int, int>> unique_requests( requests );
+        std::sort( unique_requests.begin(), unique_requests.end() );
+        unique_requests.erase(
+            std::unique( unique_requests.begin(), unique_requests.end() ),
+            unique_requests.end() );
+        int const n_unique = unique_requests.size();
+
+        Kokkos::View<int *, Kokkos::HostSpace> ranks_host( "ranks", n_unique );
+        Kokkos::View<int *, Kokkos::HostSpace> indices_host( "indices",
+                                                             n_unique );
+        for ( int i = 0; i < n_unique; ++i )
+        {
+            ranks_host( i ) = unique_requests[i].first;
+            indices_host( i ) = unique_requests[i].second;
+        }
+        Kokkos::View<int *, Kokkos::HostSpace> positions_host(
+            "positions", requests.size() );
+        for ( unsigned int k = 0; k < requests.size(); ++k )
+            positions_host( k ) =
+                std::lower_bound( unique_requests.begin(),
+                                  unique_requests.end(), requests[k] ) -
+                unique_requests.begin();
+
+        using MemorySpace = typename DeviceType::memory_space;
+        auto ranks =
+            Kokkos::create_mirror_view_and_copy( MemorySpace(), ranks_host );
+        auto indices =
+            Kokkos::create_mirror_view_and_copy( MemorySpace(), indices_host );
+        _positions = Kokkos::create_mirror_view_and_copy( MemorySpace(),
+                                                          positions_host );
+        _plan = Details::CommunicationPlan<DeviceType>( comm, ranks, indices );
+        _max_requests = max_requests;
+    }
+
+    // Number of operators in the group.
+    int size() const { return _operators.size(); }
+
+    // Number of distinct source values received by this rank in apply().
+    int fetchSize() const { return _plan.size(); }
+
+    /**
+     * Statistics of the group. The stencils are those of all the operators
+     * and the communication is the single exchange of the distinct source
+     * values done by apply(). Collective.
+     */
+    OperatorStatistics statistics() const
+    {
+        OperatorStatistics statistics;
+        for ( auto const &op : _operators )
+        {
+            auto const op_statistics = op->statistics();
+            auto const &sizes = op_statistics.stencil_sizes;
+            if ( sizes.size() > statistics.stencil_sizes.size() )
+                statistics.stencil_sizes.resize( sizes.size(), 0 );
+            for ( unsigned int s = 0; s < sizes.size(); ++s )
+                statistics.stencil_sizes[s] += sizes[s];
+            statistics.local_entries += op_statistics.local_entries;
+            statistics.remote_entries += op_statistics.remote_entries;
+            statistics.num_targets += op_statistics.num_targets;
+            statistics.num_underdetermined +=
+                op_statistics.num_underdetermined;
+        }
+        statistics.bytes_sent =
+            static_cast<long long>( _plan.remoteExportSize() ) *
+            sizeof( double );
+        statistics.bytes_received =
+            static_cast<long long>( _plan.remoteImportSize() ) *
+            sizeof( double );
+        statistics.send_neighbors = _plan.numSendNeighbors();
+        statistics.recv_neighbors = _plan.numRecvNeighbors();
+        statistics.target_imbalance =
+            Details::targetImbalance( _comm, statistics.num_targets );
+        return statistics;
+    }
+
+    /**
+     * Compute target_values[k] with the k-th operator given the same source
+     * values for all the operators. Collective.
+     */
+    void apply(
+        Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+            source_values,
+        std::vector<Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>>
+            const &target_values ) const
+    {
+        DTK_REQUIRE( target_values.size() == _operators.size() );
+
+        int const n_components = source_values.extent( 1 );
+        reserve( n_components );
+        auto const components = std::make_pair( 0, n_components );
+
+        // Exchange the source values once for all the operators.
+        auto fetched_values =
+            Kokkos::subview( _fetched_values, Kokkos::ALL, components );
+        _plan.fetch( source_values, fetched_values );
+
+        // Hand each operator its values in the order it requested them.
+        for ( int k = 0; k < size(); ++k )
+        {
+            auto positions = Kokkos::subview(
+                _positions, std::make_pair( _offsets[k], _offsets[k + 1] ) );
+            auto gathered_values = Kokkos::subview(
+                _gathered_values,
+                std::make_pair( 0, _offsets[k + 1] - _offsets[k] ),
+                components );
+            Kokkos::parallel_for(
+                DTK_MARK_REGION( "gather_values" ),
+                Kokkos::RangePolicy<ExecutionSpace>( 0,
+                                                     positions.extent( 0 ) ),
+                KOKKOS_LAMBDA( int i ) {
+                    for ( int j = 0; j < n_components; ++j )
+                        gathered_values( i, j ) =
+                            fetched_values( positions( i ), j );
+                } );
+            Kokkos::fence();
+            _operators[k]->applyFetched( gathered_values, target_values[k] );
+        }
+    }
+
+  private:
+    // Grow the buffers if needed to hold a given number of components.
+    void reserve( int n_components ) const
+    {
+        if ( _fetched_values.extent_int( 1 ) >= n_components )
+            return;
+        _fetched_values = Kokkos::View<double **, Kokkos::LayoutLeft,
+                                       DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "fetched_values" ),
+            fetchSize(), n_components );
+        _gathered_values = Kokkos::View<double **, Kokkos::LayoutLeft,
+                                        DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "gathered_values" ),
+            _max_requests, n_components );
+    }
+
+    MPI_Comm _comm;
+    std::vector<std::shared_ptr<PointCloudOperator<DeviceType> const>>
+        _operators;
+    // Requests of the k-th operator are positions(offsets[k]:offsets[k+1])
+    // in the list of distinct source values.
+    std::vector<int> _offsets;
+    Kokkos::View<int *, DeviceType> _positions;
+    int _max_requests = 0;
+    Details::CommunicationPlan<DeviceType> _plan;
+    mutable Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType>
+        _fetched_values;
+    mutable Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType>
+        _gathered_values;
+};
+
+} // namespace DataTransferKit
+
+#endif
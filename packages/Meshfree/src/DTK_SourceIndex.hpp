@@ -0,0 +1,74 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_SOURCE_INDEX_HPP
+#define DTK_SOURCE_INDEX_HPP
+
+#include <ArborX.hpp>
+#include <DTK_ConfigDefs.hpp>
+#include <DTK_DBC.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+namespace DataTransferKit
+{
+
+/**
+ * Distributed search tree over the source points, together with the points
+ * themselves. Building the tree is collective and is the most expensive part
+ * of setting up a point cloud operator, so an index can be built once and
+ * handed to every operator that maps from the same source points. The index
+ * keeps a reference to the points; they must not be modified while it is in
+ * use.
+ */
+template <typename DeviceType>
+class SourceIndex
+{
+  public:
+    using PointsView =
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>;
+
+    // Collective over comm.
+    SourceIndex( MPI_Comm comm, PointsView source_points )
+        : _comm( comm )
+        , _points( source_points )
+        , _tree( comm, source_points )
+    {
+        // NOTE: instead of checking the pre-condition that there is at least
+        // one source point passed to one of the rank, we let the tree handle
+        // the communication and just check that the tree is not empty.
+        DTK_CHECK( !_tree.empty() );
+    }
+
+    MPI_Comm comm() const { return _comm; }
+
+    // Local source points.
+    PointsView points() const { return _points; }
+
+    // Number of local source points.
+    int size() const { return _points.extent_int( 0 ); }
+
+    ArborX::DistributedSearchTree<DeviceType> const &tree() const
+    {
+        return _tree;
+    }
+
+  private:
+    MPI_Comm _comm;
+    PointsView _points;
+    ArborX::DistributedSearchTree<DeviceType> _tree;
+};
+
+} // namespace DataTransferKit
+
+#endif
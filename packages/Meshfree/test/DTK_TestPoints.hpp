@@ -0,0 +1,39 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_TEST_POINTS_HPP
+#define DTK_TEST_POINTS_HPP
+
+#include <DTK_Types.h>
+
+#include <Kokkos_Core.hpp>
+
+// n points spaced by one along the X axis starting at origin. Unless they are
+// aligned, the points are spread in Y and Z so that a linear basis in 3D can
+// be fitted to any few of them.
+template <typename DeviceType>
+Kokkos::View<DataTransferKit::Coordinate **, DeviceType>
+makePoints( int n, double origin, bool aligned = false )
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> points( "points",
+                                                                     n, 3 );
+    Kokkos::parallel_for( Kokkos::RangePolicy<ExecutionSpace>( 0, n ),
+                          KOKKOS_LAMBDA( int i ) {
+                              points( i, 0 ) = origin + i;
+                              points( i, 1 ) = aligned ? 0. : i % 3;
+                              points( i, 2 ) = aligned ? 0. : 0.5 * ( i % 5 );
+                          } );
+    Kokkos::fence();
+    return points;
+}
+
+#endif
@@ -22,9 +22,26 @@
 
 #include <functional>
 #include <string>
+#include <utility>
 
 namespace DataTransferKit
 {
+//---------------------------------------------------------------------------//
+// How the exodus files are read.
+//
+// - RankZero: rank 0 reads all the nodes and elements and sends them to
+//   their destination. Rank 0 must hold the whole mesh in memory.
+// - Hyperslab: every rank reads a contiguous slice of the nodes and of the
+//   elements of each block, and the mesh is then redistributed
+//   spatially. Both the memory and the reading time scale with the number of
+//   ranks.
+//
+enum class ExodusReadMode
+{
+    RankZero,
+    Hyperslab
+};
+
 //---------------------------------------------------------------------------//
 // Generate point cloud problem by reading exodus files.
 //
@@ -77,9 +94,10 @@ class ExodusProblemGenerator
 {
   public:
     // Constructor.
-    ExodusProblemGenerator( MPI_Comm comm,
-                            const std::string &source_exodus_file,
-                            const std::string &target_exodus_file );
+    ExodusProblemGenerator(
+        MPI_Comm comm, const std::string &source_exodus_file,
+        const std::string &target_exodus_file,
+        const ExodusReadMode read_mode = ExodusReadMode::RankZero );
 
     // Create a problem where all points are uniquely owned (i.e. no
     // ghosting). Both source and target fields have one component and are
@@ -110,7 +128,8 @@ class ExodusProblemGenerator
         override;
 
   private:
-    // Get host views of node data from file.
+    // Get host views of node data from file. Each rank gets the nodes of
+    // its slice.
     template <class Device>
     void getNodeDataFromFile(
         const std::string &exodus_file,
@@ -133,6 +152,21 @@ class ExodusProblemGenerator
         Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device>
             &partitioned_gids );
 
+    // Get the bounds of the coordinates in a given dimension over all ranks.
+    template <class Device>
+    std::pair<Coordinate, Coordinate> getGlobalBounds(
+        const int dim,
+        const Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device>
+            &coords );
+
+    // Given the total number of entities in a file, get the first and the
+    // end index of the entities read by this rank.
+    std::pair<size_t, size_t> getSlice( const size_t num_entities );
+
+    // Given the total number of entities in a file, get the rank reading
+    // the entity of the given index.
+    int getSliceRank( const size_t index, const size_t num_entities );
+
     // Given a netcdf handle and a dimension name get the length of that
     // dimension.
     size_t getNetcdfDimensionLength( const int nc_id,
@@ -145,6 +179,9 @@ class ExodusProblemGenerator
     // Filenames
     std::string _src_exodus_file;
     std::string _tgt_exodus_file;
+
+    // Read mode.
+    ExodusReadMode _read_mode;
 };
 
 //---------------------------------------------------------------------------//
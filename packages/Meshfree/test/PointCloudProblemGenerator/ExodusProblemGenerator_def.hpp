@@ -17,10 +17,12 @@
 
 #include <netcdf.h>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <limits>
 #include <set>
+#include <tuple>
 #include <vector>
 
 namespace DataTransferKit
@@ -30,10 +32,12 @@ template <class Scalar, class SourceDevice, class TargetDevice>
 ExodusProblemGenerator<Scalar, SourceDevice, TargetDevice>::
     ExodusProblemGenerator( MPI_Comm comm,
                             const std::string &source_exodus_file,
-                            const std::string &target_exodus_file )
+                            const std::string &target_exodus_file,
+                            const ExodusReadMode read_mode )
     : _comm( comm )
     , _src_exodus_file( source_exodus_file )
     , _tgt_exodus_file( target_exodus_file )
+    , _read_mode( read_mode )
 { /* ... */
 }
 
@@ -102,7 +106,7 @@ void ExodusProblemGenerator<Scalar, SourceDevice, TargetDevice>::
 
 //---------------------------------------------------------------------------//
 // Read coordinate data from file and generate unqiue global ids for the
-// points.
+// points. Each rank reads the nodes of its slice.
 template <class Scalar, class SourceDevice, class TargetDevice>
 template <class Device>
 void ExodusProblemGenerator<Scalar, SourceDevice, TargetDevice>::
@@ -111,24 +115,28 @@ void ExodusProblemGenerator<Scalar, SourceDevice, TargetDevice>::
         Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device> &coords,
         Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device> &gids )
 {
-    // Only populate views on rank 0.
+    // In the rank 0 mode, only populate views on rank 0.
     int comm_rank;
     MPI_Comm_rank( _comm, &comm_rank );
-    if ( comm_rank == 0 )
+    if ( _read_mode == ExodusReadMode::Hyperslab || comm_rank == 0 )
     {
         // Open the exodus file.
         int nc_id;
         DTK_CHECK_ERROR_CODE(
             nc_open( exodus_file.c_str(), NC_NOWRITE, &nc_id ) );
 
-        // Get the number of nodes.
+        // Get the number of nodes and the slice read by this rank.
         auto num_nodes = getNetcdfDimensionLength( nc_id, "num_nodes" );
+        size_t begin;
+        size_t end;
+        std::tie( begin, end ) = getSlice( num_nodes );
+        size_t num_local_nodes = end - begin;
 
         // Allocate the coordinate and global id arrray.
         coords = Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device>(
-            "coords", num_nodes, 3 );
+            "coords", num_local_nodes, 3 );
         gids = Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device>(
-            "gids", num_nodes );
+            "gids", num_local_nodes );
 
         // Get the coordinate variable ids.
         int coord_var_id_x;
@@ -141,20 +149,24 @@ void ExodusProblemGenerator<Scalar, SourceDevice, TargetDevice>::
         DTK_CHECK_ERROR_CODE(
             nc_inq_varid( nc_id, "coordz", &coord_var_id_z ) );
 
-        // Get the coordinates.
+        // Get the coordinates of the slice.
+        DTK_CHECK_ERROR_CODE( nc_get_vara_double(
+            nc_id, coord_var_id_x, &begin, &num_local_nodes, coords.data() ) );
         DTK_CHECK_ERROR_CODE(
-            nc_get_var_double( nc_id, coord_var_id_x, coords.data() ) );
-        DTK_CHECK_ERROR_CODE( nc_get_var_double( nc_id, coord_var_id_y,
-                                                 coords.data() + num_nodes ) );
-        DTK_CHECK_ERROR_CODE( nc_get_var_double(
-            nc_id, coord_var_id_z, coords.data() + 2 * num_nodes ) );
+            nc_get_vara_double( nc_id, coord_var_id_y, &begin,
+                                &num_local_nodes,
+                                coords.data() + num_local_nodes ) );
+        DTK_CHECK_ERROR_CODE(
+            nc_get_vara_double( nc_id, coord_var_id_z, &begin,
+                                &num_local_nodes,
+                                coords.data() + 2 * num_local_nodes ) );
 
         // Close the exodus file.
         DTK_CHECK_ERROR_CODE( nc_close( nc_id ) );
 
         // Create unique global ids starting at 1.
-        for ( size_t i = 0; i < num_nodes; ++i )
-            gids( i ) = i + 1;
+        for ( size_t i = 0; i < num_local_nodes; ++i )
+            gids( i ) = begin + i + 1;
     }
     else
     {
@@ -187,13 +199,12 @@ void ExodusProblemGenerator<Scalar, SourceDevice, TargetDevice>::
                                                          num_node_export );
     int comm_size;
     MPI_Comm_size( _comm, &comm_size );
+
+    // Figure out the min and max coordinates in the given dimension.
+    Coordinate dim_max, dim_min;
+    std::tie( dim_min, dim_max ) = getGlobalBounds( dim, export_coords );
     if ( 0 < num_node_export )
     {
-        // Figure out the min and max coordinates in the given dimension.
-        Coordinate dim_max, dim_min;
-        std::tie( dim_min, dim_max ) = ArborX::minMax(
-            Kokkos::subview( export_coords, Kokkos::ALL, dim ) );
-
         double dim_frac = 0.0;
         for ( int n = 0; n < num_node_export; ++n )
         {
@@ -228,51 +239,72 @@ void ExodusProblemGenerator<Scalar, SourceDevice, TargetDevice>::
         Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device>
             &partitioned_gids )
 {
-    // Get the node data.
+    // Get the node data of the slice of this rank.
     Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device> input_coords;
     Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device> input_gids;
     getNodeDataFromFile( exodus_file, input_coords, input_gids );
+    auto host_coords = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), input_coords );
+
+    // Figure out the min and max coordinates.
+    Coordinate dim_max, dim_min;
+    std::tie( dim_min, dim_max ) = getGlobalBounds( dim, input_coords );
 
     // Partition based on the dimension coordinate of the first node in each
     // cell. All nodes belonging to that cell will be sent to that rank to
     // simulate an element-based partitioning. This means nodes belonging to
     // elements on partition boundaries will exist on multiple ranks.
-    std::vector<GlobalOrdinal> export_gids;
-    std::vector<int> export_ranks;
-    std::vector<Coordinate> export_coords;
-    std::set<std::pair<int, GlobalOrdinal>> unique_exports;
-
-    // Read connectivity data on rank 0.
+    //
+    // The nodes and the elements are read in slices, so the nodes of an
+    // element are generally not on the rank reading the element. The
+    // partitioning is done in three steps:
+    // 1. Each element node is sent, along with the first node of its element,
+    //    to the rank reading the first node.
+    // 2. That rank finds the destination of the element from the coordinates
+    //    of its first node and sends the element nodes, along with the
+    //    destination, to the ranks reading them.
+    // 3. These ranks send the coordinates of their nodes to the destinations.
     int comm_rank;
     MPI_Comm_rank( _comm, &comm_rank );
     int comm_size;
     MPI_Comm_size( _comm, &comm_size );
-    if ( comm_rank == 0 )
+    using NodePairs =
+        Kokkos::View<GlobalOrdinal * [2], Kokkos::HostSpace,
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+
+    // Read the connectivity of the elements of the slices of this rank.
+    // Neighboring elements often share their first node and then most of
+    // their other nodes, so each (first node, node) pair is only sent once.
+    std::vector<GlobalOrdinal> element_nodes;
+    std::vector<int> element_node_ranks;
+    std::set<std::pair<GlobalOrdinal, GlobalOrdinal>> unique_element_nodes;
+    size_t num_nodes = 0;
+    size_t node_begin = 0;
+    if ( _read_mode == ExodusReadMode::Hyperslab || comm_rank == 0 )
     {
-        // Figure out the min and max coordinates.
-        Coordinate dim_max, dim_min;
-        std::tie( dim_min, dim_max ) =
-            ArborX::minMax( Kokkos::subview( input_coords, Kokkos::ALL, dim ) );
-
         // Open the exodus file.
         int nc_id;
         DTK_CHECK_ERROR_CODE(
             nc_open( exodus_file.c_str(), NC_NOWRITE, &nc_id ) );
 
+        // Get the number of nodes and the first node of the slice.
+        num_nodes = getNetcdfDimensionLength( nc_id, "num_nodes" );
+        node_begin = getSlice( num_nodes ).first;
+
         // Get the number of element blocks.
         auto num_el_blks = getNetcdfDimensionLength( nc_id, "num_el_blk" );
 
         // Loop over blocks. Block ids start at 1.
-        GlobalOrdinal node_gid;
-        double x_frac = 0.0;
-        int send_rank;
         for ( size_t b = 1; b < num_el_blks + 1; ++b )
         {
-            // Get the number of elements in the block.
+            // Get the number of elements in the block and the slice of
+            // elements read by this rank.
             std::string num_elem_dim_name =
                 "num_el_in_blk" + std::to_string( b );
             auto num_elem =
                 getNetcdfDimensionLength( nc_id, num_elem_dim_name );
+            auto elem_slice = getSlice( num_elem );
+            size_t num_local_elem = elem_slice.second - elem_slice.first;
 
             // Get the number of nodes per element in the block.
             std::string node_per_elem_dim_name =
@@ -281,69 +313,37 @@ void ExodusProblemGenerator<Scalar, SourceDevice, TargetDevice>::
                 getNetcdfDimensionLength( nc_id, node_per_elem_dim_name );
 
             // Allocate a temporary view to load the block connectivity data.
-            Kokkos::View<int **, Kokkos::LayoutLeft, Device> connectivity(
-                "connectivity", node_per_elem, num_elem );
+            Kokkos::View<int **, Kokkos::LayoutLeft, Kokkos::HostSpace>
+                connectivity( "connectivity", node_per_elem, num_local_elem );
 
-            // Get the connectivity.
+            // Get the connectivity of the slice.
             std::string conn_var_name = "connect" + std::to_string( b );
             int conn_var_id;
             DTK_CHECK_ERROR_CODE(
                 nc_inq_varid( nc_id, conn_var_name.c_str(), &conn_var_id ) );
-            DTK_CHECK_ERROR_CODE(
-                nc_get_var_int( nc_id, conn_var_id, connectivity.data() ) );
-
-            // Loop over elements in the block
-            for ( size_t e = 0; e < num_elem; ++e )
+            size_t start[2] = {elem_slice.first, 0};
+            size_t count[2] = {num_local_elem, node_per_elem};
+            DTK_CHECK_ERROR_CODE( nc_get_vara_int(
+                nc_id, conn_var_id, start, count, connectivity.data() ) );
+
+            // Send each element node to the rank reading the first node of
+            // the element - connectivity indices start at 1.
+            for ( size_t e = 0; e < num_local_elem; ++e )
             {
-                // Get the first element node - connectivity indices start at 1.
-                node_gid = connectivity( 0, e );
-
-                // Partition in the given dimension. Each comm rank is
-                // assigned a spatial bin along the given dimension. All
-                // elements that have their first node in this spatial bin are
-                // assigned to that comm rank.
-                x_frac = ( input_coords( node_gid - 1, dim ) - dim_min ) /
-                         ( dim_max - dim_min );
-                send_rank = ( x_frac < 1.0 ) ? std::floor( x_frac * comm_size )
-                                             : comm_size - 1;
-
-                // Only add this node/rank combo if we haven't already. This
-                // keeps us from sending the same node to the same rank more
-                // than once.
-                bool inserted = false;
-                std::tie( std::ignore, inserted ) = unique_exports.insert(
-                    std::make_pair( send_rank, node_gid ) );
-                if ( inserted )
+                GlobalOrdinal first_gid = connectivity( 0, e );
+                int first_rank = getSliceRank( first_gid - 1, num_nodes );
+                for ( size_t n = 0; n < node_per_elem; ++n )
                 {
-                    export_gids.push_back( node_gid );
-                    export_ranks.push_back( send_rank );
-                    export_coords.push_back( input_coords( node_gid - 1, 0 ) );
-                    export_coords.push_back( input_coords( node_gid - 1, 1 ) );
-                    export_coords.push_back( input_coords( node_gid - 1, 2 ) );
-                }
-
-                // Add the rest of the cell nodes to that sending rank.
-                for ( size_t n = 1; n < node_per_elem; ++n )
-                {
-                    // Get the next node id.
-                    node_gid = connectivity( n, e );
-
-                    // Only add this node/rank combo if we haven't
-                    // already. This keeps us from sending the same node to
-                    // the same rank more than once.
-                    if ( !unique_exports.count(
-                             std::make_pair( send_rank, node_gid ) ) )
+                    GlobalOrdinal node_gid = connectivity( n, e );
+                    bool inserted = false;
+                    std::tie( std::ignore, inserted ) =
+                        unique_element_nodes.insert(
+                            std::make_pair( first_gid, node_gid ) );
+                    if ( inserted )
                     {
-                        export_gids.push_back( node_gid );
-                        export_ranks.push_back( send_rank );
-                        export_coords.push_back(
-                            input_coords( node_gid - 1, 0 ) );
-                        export_coords.push_back(
-                            input_coords( node_gid - 1, 1 ) );
-                        export_coords.push_back(
-                            input_coords( node_gid - 1, 2 ) );
-                        unique_exports.insert(
-                            std::make_pair( send_rank, node_gid ) );
+                        element_nodes.push_back( first_gid );
+                        element_nodes.push_back( node_gid );
+                        element_node_ranks.push_back( first_rank );
                     }
                 }
             }
@@ -352,6 +352,84 @@ void ExodusProblemGenerator<Scalar, SourceDevice, TargetDevice>::
         // Close the exodus file.
         DTK_CHECK_ERROR_CODE( nc_close( nc_id ) );
     }
+    ArborX::Details::Distributor<Device> element_distributor( _comm );
+    int num_element_import = element_distributor.createFromSends(
+        Kokkos::View<int const *, Kokkos::HostSpace,
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
+            element_node_ranks.data(), element_node_ranks.size() ) );
+    Kokkos::View<GlobalOrdinal * [2], Kokkos::HostSpace> import_element_nodes(
+        "", num_element_import );
+    ArborX::Details::DistributedSearchTreeImpl<Device>::sendAcrossNetwork(
+        element_distributor,
+        NodePairs( element_nodes.data(), element_nodes.size() / 2 ),
+        import_element_nodes );
+    element_nodes.clear();
+    element_node_ranks.clear();
+    unique_element_nodes.clear();
+
+    // Partition in the given dimension. Each comm rank is assigned a spatial
+    // bin along the given dimension. All elements that have their first node
+    // in this spatial bin are assigned to that comm rank. Only add each
+    // node/rank combo once. This keeps us from sending the same node to the
+    // same rank more than once.
+    std::vector<GlobalOrdinal> node_destinations;
+    std::vector<int> node_ranks;
+    std::set<std::pair<int, GlobalOrdinal>> unique_exports;
+    for ( int i = 0; i < num_element_import; ++i )
+    {
+        GlobalOrdinal first_gid = import_element_nodes( i, 0 );
+        GlobalOrdinal node_gid = import_element_nodes( i, 1 );
+        double x_frac =
+            ( host_coords( first_gid - 1 - node_begin, dim ) - dim_min ) /
+            ( dim_max - dim_min );
+        int send_rank = ( x_frac < 1.0 ) ? std::floor( x_frac * comm_size )
+                                         : comm_size - 1;
+        bool inserted = false;
+        std::tie( std::ignore, inserted ) =
+            unique_exports.insert( std::make_pair( send_rank, node_gid ) );
+        if ( inserted )
+        {
+            node_destinations.push_back( send_rank );
+            node_destinations.push_back( node_gid );
+            node_ranks.push_back( getSliceRank( node_gid - 1, num_nodes ) );
+        }
+    }
+    unique_exports.clear();
+    ArborX::Details::Distributor<Device> node_distributor( _comm );
+    int num_node_import = node_distributor.createFromSends(
+        Kokkos::View<int const *, Kokkos::HostSpace,
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
+            node_ranks.data(), node_ranks.size() ) );
+    Kokkos::View<GlobalOrdinal * [2], Kokkos::HostSpace> import_destinations(
+        "", num_node_import );
+    ArborX::Details::DistributedSearchTreeImpl<Device>::sendAcrossNetwork(
+        node_distributor,
+        NodePairs( node_destinations.data(), node_destinations.size() / 2 ),
+        import_destinations );
+    node_destinations.clear();
+    node_ranks.clear();
+
+    // Send the nodes to their destinations. The same node/rank combo may
+    // come from several ranks.
+    std::vector<GlobalOrdinal> export_gids;
+    std::vector<int> export_ranks;
+    std::vector<Coordinate> export_coords;
+    for ( int i = 0; i < num_node_import; ++i )
+    {
+        int send_rank = import_destinations( i, 0 );
+        GlobalOrdinal node_gid = import_destinations( i, 1 );
+        bool inserted = false;
+        std::tie( std::ignore, inserted ) =
+            unique_exports.insert( std::make_pair( send_rank, node_gid ) );
+        if ( inserted )
+        {
+            export_gids.push_back( node_gid );
+            export_ranks.push_back( send_rank );
+            for ( int d = 0; d < 3; ++d )
+                export_coords.push_back(
+                    host_coords( node_gid - 1 - node_begin, d ) );
+        }
+    }
 
     // Build a communication plan for the sources.
     ArborX::Details::Distributor<Device> distributor( _comm );
@@ -389,6 +467,63 @@ void ExodusProblemGenerator<Scalar, SourceDevice, TargetDevice>::
     Kokkos::deep_copy( partitioned_coords, import_coords );
 }
 
+//---------------------------------------------------------------------------//
+// Get the bounds of the coordinates in a given dimension over all ranks.
+template <class Scalar, class SourceDevice, class TargetDevice>
+template <class Device>
+std::pair<Coordinate, Coordinate>
+ExodusProblemGenerator<Scalar, SourceDevice, TargetDevice>::getGlobalBounds(
+    const int dim,
+    const Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device> &coords )
+{
+    Coordinate dim_min = std::numeric_limits<Coordinate>::max();
+    Coordinate dim_max = std::numeric_limits<Coordinate>::lowest();
+    if ( 0 < coords.extent( 0 ) )
+        std::tie( dim_min, dim_max ) =
+            ArborX::minMax( Kokkos::subview( coords, Kokkos::ALL, dim ) );
+    MPI_Allreduce( MPI_IN_PLACE, &dim_min, 1, MPI_DOUBLE, MPI_MIN, _comm );
+    MPI_Allreduce( MPI_IN_PLACE, &dim_max, 1, MPI_DOUBLE, MPI_MAX, _comm );
+    return std::make_pair( dim_min, dim_max );
+}
+
+//---------------------------------------------------------------------------//
+// Given the total number of entities in a file, get the first and the end
+// index of the entities read by this rank. In the hyperslab mode, the
+// entities are split in contiguous slices of equal size.
+template <class Scalar, class SourceDevice, class TargetDevice>
+std::pair<size_t, size_t>
+ExodusProblemGenerator<Scalar, SourceDevice, TargetDevice>::getSlice(
+    const size_t num_entities )
+{
+    int comm_rank;
+    MPI_Comm_rank( _comm, &comm_rank );
+    if ( _read_mode == ExodusReadMode::RankZero )
+        return std::make_pair( 0, comm_rank == 0 ? num_entities : 0 );
+
+    int comm_size;
+    MPI_Comm_size( _comm, &comm_size );
+    size_t slice_size = ( num_entities + comm_size - 1 ) / comm_size;
+    return std::make_pair(
+        std::min( comm_rank * slice_size, num_entities ),
+        std::min( ( comm_rank + 1 ) * slice_size, num_entities ) );
+}
+
+//---------------------------------------------------------------------------//
+// Given the total number of entities in a file, get the rank reading the
+// entity of the given index.
+template <class Scalar, class SourceDevice, class TargetDevice>
+int ExodusProblemGenerator<Scalar, SourceDevice, TargetDevice>::getSliceRank(
+    const size_t index, const size_t num_entities )
+{
+    if ( _read_mode == ExodusReadMode::RankZero )
+        return 0;
+
+    int comm_size;
+    MPI_Comm_size( _comm, &comm_size );
+    size_t slice_size = ( num_entities + comm_size - 1 ) / comm_size;
+    return index / slice_size;
+}
+
 //---------------------------------------------------------------------------//
 // Given a netcdf handle and a dimension name get the length of that
 // dimension.
@@ -0,0 +1,250 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_SYNTHETICPROBLEMGENERATOR_HPP
+#define DTK_SYNTHETICPROBLEMGENERATOR_HPP
+
+#include "DTK_ConfigDefs.hpp"
+#include "DTK_Types.h"
+#include "PointCloudProblemGenerator.hpp"
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <cmath> // cos, log, sin, sqrt
+
+namespace DataTransferKit
+{
+//---------------------------------------------------------------------------//
+// Shape of a synthetic point cloud, inside the slab [rank, rank + 1] x [0, 1]
+// x [0, 1] of each rank.
+//
+// - Uniform: uniformly distributed in the slab.
+// - Clustered: normally distributed around cluster centers drawn at random
+//   in the slab, then clamped to the slab.
+// - Shells: uniformly distributed on concentric cylinders of axis
+//   y = z = 0.5, with radii evenly spaced up to 0.45.
+// - Anisotropic: uniformly distributed in the slab flattened to a thickness
+//   of anisotropy in the Z direction.
+//
+enum class PointDistribution
+{
+    Uniform,
+    Clustered,
+    Shells,
+    Anisotropic
+};
+
+struct SyntheticPointCloudOptions
+{
+    PointDistribution distribution = PointDistribution::Uniform;
+    // Points generated by every rank.
+    int points_per_rank = 1000;
+    // Clusters of every rank and standard deviation around their centers.
+    int num_clusters = 4;
+    double cluster_width = 0.05;
+    // Number of cylinders, each of them gets the same number of points.
+    int num_shells = 2;
+    // Thickness of the flattened slab.
+    double anisotropy = 1e-3;
+};
+
+//---------------------------------------------------------------------------//
+// Point i of the cloud generated by a rank. The points are functions of the
+// seed, the stream, the rank and i only, so that every rank generates its
+// points independently and can generate the points of other ranks as well.
+struct SyntheticPointCloudSampler
+{
+    SyntheticPointCloudOptions options;
+    unsigned int seed;
+    int stream;
+    // Translation of the cloud in the Y direction.
+    double y_offset;
+
+    // Value in [0, 1).
+    KOKKOS_INLINE_FUNCTION
+    double uniform( int s, int rank, long long i, int k ) const
+    {
+        unsigned long long h = seed;
+        unsigned long long const values[4] = {
+            static_cast<unsigned long long>( s ),
+            static_cast<unsigned long long>( rank ),
+            static_cast<unsigned long long>( i ),
+            static_cast<unsigned long long>( k )};
+        for ( int v = 0; v < 4; ++v )
+        {
+            // splitmix64
+            h += values[v] + 0x9e3779b97f4a7c15ULL;
+            h = ( h ^ ( h >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+            h = ( h ^ ( h >> 27 ) ) * 0x94d049bb133111ebULL;
+            h ^= h >> 31;
+        }
+        return ( h >> 11 ) * ( 1. / 9007199254740992. );
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()( int rank, long long i, Coordinate p[3] ) const
+    {
+        double const two_pi = 6.283185307179586;
+        double const u0 = uniform( stream, rank, i, 0 );
+        double const u1 = uniform( stream, rank, i, 1 );
+        double const u2 = uniform( stream, rank, i, 2 );
+        switch ( options.distribution )
+        {
+        case PointDistribution::Uniform:
+            p[0] = rank + u0;
+            p[1] = u1;
+            p[2] = u2;
+            break;
+        case PointDistribution::Clustered:
+        {
+            // The centers do not depend on the stream so that the source and
+            // target clusters coincide.
+            int c = u0 * options.num_clusters;
+            c = c < options.num_clusters ? c : options.num_clusters - 1;
+            double const u3 = uniform( stream, rank, i, 3 );
+            double const u4 = uniform( stream, rank, i, 4 );
+            double const r1 = sqrt( -2. * log( 1. - u1 ) );
+            double const r2 = sqrt( -2. * log( 1. - u3 ) );
+            double const normal[3] = {r1 * cos( two_pi * u2 ),
+                                      r1 * sin( two_pi * u2 ),
+                                      r2 * cos( two_pi * u4 )};
+            for ( int d = 0; d < 3; ++d )
+            {
+                double const lo = d == 0 ? rank : 0.;
+                double const center =
+                    lo + 0.1 + 0.8 * uniform( -1, rank, c, d );
+                double const x = center + options.cluster_width * normal[d];
+                p[d] = x < lo ? lo : ( x > lo + 1. ? lo + 1. : x );
+            }
+            break;
+        }
+        case PointDistribution::Shells:
+        {
+            int s = u0 * options.num_shells;
+            s = s < options.num_shells ? s : options.num_shells - 1;
+            double const radius = 0.45 * ( s + 1 ) / options.num_shells;
+            p[0] = rank + u1;
+            p[1] = 0.5 + radius * cos( two_pi * u2 );
+            p[2] = 0.5 + radius * sin( two_pi * u2 );
+            break;
+        }
+        case PointDistribution::Anisotropic:
+            p[0] = rank + u0;
+            p[1] = u1;
+            p[2] = options.anisotropy * u2;
+            break;
+        }
+        p[1] += y_offset;
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Generate point cloud problems in parallel, without reading any file.
+//
+// Every rank generates the points of its own slab [rank, rank + 1] x [0, 1]
+// x [0, 1], so that the size of the problem grows with the number of ranks
+// for weak scaling studies. The source and the target clouds may follow
+// different distributions and the ratio of their points_per_rank is the
+// density ratio of the problem. The target clouds are translated by
+// 1 - overlap in the Y direction, so that an overlap of 1 puts both clouds in
+// the same box and an overlap of 0 puts them side by side.
+//
+// The source field is field() evaluated at the source points and the target
+// field is the exact value of field() at the target points, i.e. the
+// expected result of the transfer.
+//
+// In the ghosted case, each rank also gets the points of the neighboring
+// ranks that are within halo_width of its slab in the X direction, with the
+// same global ids as on their owner.
+//
+template <class Scalar, class SourceDevice, class TargetDevice>
+class SyntheticProblemGenerator
+    : public PointCloudProblemGenerator<Scalar, SourceDevice, TargetDevice>
+{
+  public:
+    // Constructor.
+    SyntheticProblemGenerator( MPI_Comm comm,
+                               SyntheticPointCloudOptions const &source,
+                               SyntheticPointCloudOptions const &target,
+                               double overlap = 1., double halo_width = 0.1,
+                               unsigned int seed = 0 );
+
+    // Linear field transferred in the problems, which the moving least
+    // squares operator reproduces exactly.
+    KOKKOS_INLINE_FUNCTION
+    static Scalar field( Coordinate x, Coordinate y, Coordinate z )
+    {
+        return 1. + x + 2. * y + 3. * z;
+    }
+
+    // Create a problem where all points are uniquely owned (i.e. no
+    // ghosting). Both fields have one component.
+    void createUniquelyOwnedProblem(
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, SourceDevice>
+            &src_coords,
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, SourceDevice> &src_field,
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, TargetDevice>
+            &tgt_coords,
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, TargetDevice> &tgt_field )
+        override;
+
+    // Create a general problem where points may exist on multiple
+    // processors. Both fields have one component.
+    void createGhostedProblem(
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, SourceDevice>
+            &src_coords,
+        Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, SourceDevice>
+            &src_gids,
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, SourceDevice> &src_field,
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, TargetDevice>
+            &tgt_coords,
+        Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, TargetDevice>
+            &tgt_gids,
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, TargetDevice> &tgt_field )
+        override;
+
+  private:
+    // Generate the points of a cloud on this rank, and the ones of the
+    // neighboring ranks within the halo if ghosted is true.
+    template <class Device>
+    void generate(
+        SyntheticPointCloudSampler const &sampler, bool ghosted,
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device> &coords,
+        Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device> &gids,
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, Device> &values );
+
+  private:
+    // Comm
+    MPI_Comm _comm;
+
+    // Samplers of the source and target clouds.
+    SyntheticPointCloudSampler _src_sampler;
+    SyntheticPointCloudSampler _tgt_sampler;
+
+    // Width of the ghosted layers.
+    double _halo_width;
+};
+
+//---------------------------------------------------------------------------//
+
+} // namespace DataTransferKit
+
+//---------------------------------------------------------------------------//
+// Template includes
+//---------------------------------------------------------------------------//
+
+#include "SyntheticProblemGenerator_def.hpp"
+
+//---------------------------------------------------------------------------//
+
+#endif // end  DTK_SYNTHETICPROBLEMGENERATOR_HPP
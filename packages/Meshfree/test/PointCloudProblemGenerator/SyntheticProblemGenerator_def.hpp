@@ -0,0 +1,171 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_SYNTHETICPROBLEMGENERATOR_DEF_HPP
+#define DTK_SYNTHETICPROBLEMGENERATOR_DEF_HPP
+
+#include <DTK_DBC.hpp>
+
+#include <vector>
+
+namespace DataTransferKit
+{
+//---------------------------------------------------------------------------//
+template <class Scalar, class SourceDevice, class TargetDevice>
+SyntheticProblemGenerator<Scalar, SourceDevice, TargetDevice>::
+    SyntheticProblemGenerator( MPI_Comm comm,
+                               SyntheticPointCloudOptions const &source,
+                               SyntheticPointCloudOptions const &target,
+                               double overlap, double halo_width,
+                               unsigned int seed )
+    : _comm( comm )
+    , _src_sampler{source, seed, 0, 0.}
+    , _tgt_sampler{target, seed, 1, 1. - overlap}
+    , _halo_width( halo_width )
+{
+    for ( auto const &options : {source, target} )
+    {
+        DTK_REQUIRE( options.points_per_rank >= 0 );
+        DTK_REQUIRE( options.num_clusters > 0 );
+        DTK_REQUIRE( options.num_shells > 0 );
+    }
+    DTK_REQUIRE( overlap >= 0. && overlap <= 1. );
+    DTK_REQUIRE( halo_width >= 0. && halo_width <= 1. );
+}
+
+//---------------------------------------------------------------------------//
+// Create a problem where all points are uniquely owned (i.e. no ghosting)
+template <class Scalar, class SourceDevice, class TargetDevice>
+void SyntheticProblemGenerator<Scalar, SourceDevice, TargetDevice>::
+    createUniquelyOwnedProblem(
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, SourceDevice>
+            &src_coords,
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, SourceDevice> &src_field,
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, TargetDevice>
+            &tgt_coords,
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, TargetDevice> &tgt_field )
+{
+    Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, SourceDevice> src_gids;
+    generate( _src_sampler, false, src_coords, src_gids, src_field );
+    Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, TargetDevice> tgt_gids;
+    generate( _tgt_sampler, false, tgt_coords, tgt_gids, tgt_field );
+}
+
+//---------------------------------------------------------------------------//
+// Create a general problem where points may exist on multiple
+// processors. Points have a unique global id.
+template <class Scalar, class SourceDevice, class TargetDevice>
+void SyntheticProblemGenerator<Scalar, SourceDevice, TargetDevice>::
+    createGhostedProblem(
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, SourceDevice>
+            &src_coords,
+        Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, SourceDevice>
+            &src_gids,
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, SourceDevice> &src_field,
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, TargetDevice>
+            &tgt_coords,
+        Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, TargetDevice>
+            &tgt_gids,
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, TargetDevice> &tgt_field )
+{
+    generate( _src_sampler, true, src_coords, src_gids, src_field );
+    generate( _tgt_sampler, true, tgt_coords, tgt_gids, tgt_field );
+}
+
+//---------------------------------------------------------------------------//
+// Generate the points of this rank, followed by the points of the
+// neighboring ranks that fall in the halo.
+template <class Scalar, class SourceDevice, class TargetDevice>
+template <class Device>
+void SyntheticProblemGenerator<Scalar, SourceDevice, TargetDevice>::generate(
+    SyntheticPointCloudSampler const &sampler, bool ghosted,
+    Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device> &coords,
+    Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device> &gids,
+    Kokkos::View<Scalar **, Kokkos::LayoutLeft, Device> &values )
+{
+    using ExecutionSpace = typename Device::execution_space;
+
+    int comm_rank;
+    MPI_Comm_rank( _comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( _comm, &comm_size );
+
+    // Ranks whose points may end up on this rank, this rank first.
+    std::vector<int> ranks = {comm_rank};
+    if ( ghosted && comm_rank > 0 )
+        ranks.push_back( comm_rank - 1 );
+    if ( ghosted && comm_rank < comm_size - 1 )
+        ranks.push_back( comm_rank + 1 );
+    int const n_ranks = ranks.size();
+    Kokkos::View<int *, Device> candidate_ranks( "candidate_ranks", n_ranks );
+    Kokkos::deep_copy(
+        candidate_ranks,
+        Kokkos::View<int *, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>(
+            ranks.data(), n_ranks ) );
+
+    // Position of the kept candidates among the generated points.
+    long long const n = sampler.options.points_per_rank;
+    long long const n_candidates = n * n_ranks;
+    double const lo = comm_rank - _halo_width;
+    double const hi = comm_rank + 1 + _halo_width;
+    Kokkos::View<long long *, Device> offsets( "offsets", n_candidates + 1 );
+    Kokkos::parallel_scan(
+        DTK_MARK_REGION( "count_synthetic_points" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_candidates ),
+        KOKKOS_LAMBDA( long long k, long long &update, bool final ) {
+            if ( final )
+                offsets( k ) = update;
+            Coordinate p[3];
+            sampler( candidate_ranks( k / n ), k % n, p );
+            if ( k < n || ( p[0] >= lo && p[0] <= hi ) )
+                ++update;
+            if ( final && k == n_candidates - 1 )
+                offsets( n_candidates ) = update;
+        } );
+    Kokkos::fence();
+    long long n_points = 0;
+    if ( n_candidates > 0 )
+        Kokkos::deep_copy(
+            n_points, Kokkos::subview( offsets, n_candidates ) );
+
+    coords = Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device>(
+        "coords", n_points, 3 );
+    gids = Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device>(
+        "gids", n_points );
+    values = Kokkos::View<Scalar **, Kokkos::LayoutLeft, Device>( "field",
+                                                                  n_points, 1 );
+    auto coords_out = coords;
+    auto gids_out = gids;
+    auto values_out = values;
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "fill_synthetic_points" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_candidates ),
+        KOKKOS_LAMBDA( long long k ) {
+            long long const position = offsets( k );
+            if ( offsets( k + 1 ) == position )
+                return;
+            int const rank = candidate_ranks( k / n );
+            Coordinate p[3];
+            sampler( rank, k % n, p );
+            for ( int d = 0; d < 3; ++d )
+                coords_out( position, d ) = p[d];
+            gids_out( position ) = rank * n + k % n;
+            values_out( position, 0 ) =
+                SyntheticProblemGenerator::field( p[0], p[1], p[2] );
+        } );
+    Kokkos::fence();
+}
+
+//---------------------------------------------------------------------------//
+
+} // namespace DataTransferKit
+
+#endif // end  DTK_SYNTHETICPROBLEMGENERATOR_DEF_HPP
@@ -0,0 +1,123 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "DTK_TestPoints.hpp"
+
+#include <DTK_ComposedOperator.hpp>
+#include <DTK_MovingLeastSquaresOperator.hpp>
+#include <DTK_NearestNeighborOperator.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <Teuchos_UnitTestHarness.hpp>
+
+#include <utility>
+#include <vector>
+
+template <typename DeviceType>
+Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType>
+makeValues( int n, int n_components, double seed )
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> values(
+        "values", n, n_components );
+    Kokkos::parallel_for( Kokkos::RangePolicy<ExecutionSpace>( 0, n ),
+                          KOKKOS_LAMBDA( int i ) {
+                              for ( int j = 0; j < n_components; ++j )
+                                  values( i, j ) = seed * ( i % 7 ) - j;
+                          } );
+    Kokkos::fence();
+    return values;
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( ComposedOperator, chained_transfer,
+                                   DeviceType )
+{
+    using PointCloudOperator = DataTransferKit::PointCloudOperator<DeviceType>;
+
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+
+    // The intermediate points are owned by the next rank and the targets by
+    // the previous one.
+    int const n_sources = 20;
+    int const n_intermediates = 25;
+    int const n_targets = 30;
+    auto source_points =
+        makePoints<DeviceType>( n_sources, n_sources * comm_rank );
+    auto intermediate_points = makePoints<DeviceType>(
+        n_intermediates,
+        n_sources * ( ( comm_rank + 1 ) % comm_size ) + 0.1 );
+    auto target_points = makePoints<DeviceType>(
+        n_targets,
+        n_sources * ( ( comm_rank + comm_size - 1 ) % comm_size ) + 0.3 );
+
+    DataTransferKit::NearestNeighborOperator<DeviceType> nn(
+        comm, source_points, intermediate_points );
+    DataTransferKit::MovingLeastSquaresOperator<DeviceType> mls_first(
+        comm, source_points, intermediate_points );
+    DataTransferKit::MovingLeastSquaresOperator<DeviceType> mls_second(
+        comm, intermediate_points, target_points );
+
+    int const n_components = 2;
+    auto source_values =
+        makeValues<DeviceType>( n_sources, n_components, 0.3 );
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType>
+        intermediate_values( "intermediate_values", n_intermediates,
+                             n_components );
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> expected(
+        "expected", n_targets, n_components );
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> target_values(
+        "target_values", n_targets, n_components );
+    using Chain =
+        std::pair<PointCloudOperator const *, PointCloudOperator const *>;
+    std::vector<Chain> chains = {{&nn, &mls_second}, {&mls_first, &mls_second}};
+    for ( auto const &chain : chains )
+    {
+        // The product gives the same values as the two transfers in a row.
+        DataTransferKit::ComposedOperator<DeviceType> composed(
+            comm, *chain.first, *chain.second );
+        chain.first->apply( source_values, intermediate_values );
+        chain.second->apply( intermediate_values, expected );
+        composed.apply( source_values, target_values );
+        auto expected_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), expected );
+        auto target_values_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), target_values );
+        for ( int i = 0; i < n_targets; ++i )
+            for ( int j = 0; j < n_components; ++j )
+                TEST_FLOATING_EQUALITY( target_values_host( i, j ) + 10.,
+                                        expected_host( i, j ) + 10., 1e-12 );
+
+        // The product exports like the operators it was built from.
+        auto matrix = composed.crsMatrix();
+        TEST_EQUALITY( matrix.numLocalRows(), n_targets );
+        TEST_EQUALITY( matrix.num_local_columns, n_sources );
+    }
+}
+
+// Include the test macros.
+#include "DataTransferKit_ETIHelperMacros.h"
+
+// Create the test group
+#define UNIT_TEST_GROUP( NODE )                                                \
+    using DeviceType##NODE = typename NODE::device_type;                       \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( ComposedOperator,                    \
+                                          chained_transfer, DeviceType##NODE )
+
+// Demangle the types
+DTK_ETI_MANGLING_TYPEDEFS()
+
+// Instantiate the tests
+DTK_INSTANTIATE_N( UNIT_TEST_GROUP )
@@ -0,0 +1,191 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <ArborX.hpp>
+#include <DTK_DetailsNearestNeighborOperatorImpl.hpp> // fetch
+#include <DTK_DetailsPayloadCodec.hpp>
+
+#include <Teuchos_UnitTestHarness.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+std::vector<double> makePayload( int n_rows, int n_cols )
+{
+    std::vector<double> values( n_rows * n_cols );
+    for ( int i = 0; i < n_rows; ++i )
+        for ( int j = 0; j < n_cols; ++j )
+            values[i * n_cols + j] = 100. * j + std::sin( 0.01 * i + j );
+    return values;
+}
+
+TEUCHOS_UNIT_TEST( PayloadCodec, lossless )
+{
+    using DataTransferKit::PayloadCompression;
+    using DataTransferKit::Details::PayloadCodec;
+
+    int const n_rows = 1000;
+    int const n_cols = 3;
+    auto values = makePayload( n_rows, n_cols );
+    // Repeated and special values must survive the round trip.
+    values[3] = values[0];
+    values[4] = 0.;
+    values[5] = -0.;
+    values[6] = std::numeric_limits<double>::infinity();
+
+    std::vector<unsigned char> bytes;
+    PayloadCodec::encode( PayloadCompression::Lossless, 0., values.data(),
+                          n_rows, n_cols, bytes );
+    TEST_COMPARE( bytes.size(), <, values.size() * sizeof( double ) );
+
+    std::vector<double> decoded( values.size() );
+    TEST_EQUALITY( PayloadCodec::decode( bytes.data(), bytes.size(), n_rows,
+                                         n_cols, decoded.data() ),
+                   bytes.size() );
+    TEST_EQUALITY( std::memcmp( decoded.data(), values.data(),
+                                values.size() * sizeof( double ) ),
+                   0 );
+
+    // Empty payload
+    bytes.clear();
+    PayloadCodec::encode( PayloadCompression::Lossless, 0., nullptr, 0, n_cols,
+                          bytes );
+    TEST_EQUALITY( PayloadCodec::decode( bytes.data(), bytes.size(), 0, n_cols,
+                                         nullptr ),
+                   bytes.size() );
+}
+
+TEUCHOS_UNIT_TEST( PayloadCodec, bounded_float32 )
+{
+    using DataTransferKit::PayloadCompression;
+    using DataTransferKit::Details::PayloadCodec;
+
+    int const n_rows = 1000;
+    int const n_cols = 3;
+    auto const values = makePayload( n_rows, n_cols );
+
+    std::vector<unsigned char> bytes;
+    PayloadCodec::encode( PayloadCompression::BoundedFloat32,
+                          std::numeric_limits<double>::infinity(),
+                          values.data(), n_rows, n_cols, bytes );
+    TEST_COMPARE( bytes.size(), <=,
+                  n_cols * ( 1 + sizeof( double ) +
+                             n_rows * ( sizeof( float ) + 1 ) ) );
+
+    std::vector<double> decoded( values.size() );
+    PayloadCodec::decode( bytes.data(), bytes.size(), n_rows, n_cols,
+                          decoded.data() );
+    // The extent of each component is at most 2.
+    for ( unsigned int i = 0; i < values.size(); ++i )
+        TEST_COMPARE( std::abs( decoded[i] - values[i] ), <=,
+                      std::ldexp( 2., -24 ) + 1e-12 );
+
+    // A tolerance that cannot be met falls back to the lossless encoding.
+    bytes.clear();
+    PayloadCodec::encode( PayloadCompression::BoundedFloat32, 1e-15,
+                          values.data(), n_rows, n_cols, bytes );
+    PayloadCodec::decode( bytes.data(), bytes.size(), n_rows, n_cols,
+                          decoded.data() );
+    TEST_EQUALITY( std::memcmp( decoded.data(), values.data(),
+                                values.size() * sizeof( double ) ),
+                   0 );
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( DetailsNearestNeighborOperatorImpl,
+                                   compressed_fetch, DeviceType )
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+    using DataTransferKit::PayloadCompression;
+    using DataTransferKit::PayloadCompressionStatistics;
+    using Impl = DataTransferKit::Details::NearestNeighborOperatorImpl<
+        DeviceType>;
+
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+
+    // Every rank requests all the entries owned by the next rank.
+    int const n = 500;
+    int const DIM = 3;
+    Kokkos::View<int *, DeviceType> indices( "indices", n );
+    Kokkos::View<int *, DeviceType> ranks( "ranks", n );
+    Kokkos::parallel_for( Kokkos::RangePolicy<ExecutionSpace>( 0, n ),
+                          KOKKOS_LAMBDA( int i ) {
+                              indices( i ) = n - 1 - i;
+                              ranks( i ) = ( comm_rank + 1 ) % comm_size;
+                          } );
+    Kokkos::fence();
+
+    Kokkos::View<double **, DeviceType> points( "points", n, DIM );
+    Kokkos::parallel_for( Kokkos::RangePolicy<ExecutionSpace>( 0, n ),
+                          KOKKOS_LAMBDA( int i ) {
+                              for ( int j = 0; j < DIM; ++j )
+                                  points( i, j ) =
+                                      comm_rank + 0.001 * i + 10. * j;
+                          } );
+    Kokkos::fence();
+
+    auto ref = Impl::fetch( comm, ranks, indices, points );
+    auto ref_host = Kokkos::create_mirror_view( ref );
+    Kokkos::deep_copy( ref_host, ref );
+
+    PayloadCompressionStatistics lossless_statistics;
+    auto lossless =
+        Impl::fetch( comm, ranks, indices, points, PayloadCompression::Lossless,
+                     0., lossless_statistics );
+    auto lossless_host = Kokkos::create_mirror_view( lossless );
+    Kokkos::deep_copy( lossless_host, lossless );
+    for ( int i = 0; i < n; ++i )
+        for ( int j = 0; j < DIM; ++j )
+            TEST_EQUALITY( lossless_host( i, j ), ref_host( i, j ) );
+
+    PayloadCompressionStatistics float32_statistics;
+    auto float32 = Impl::fetch( comm, ranks, indices, points,
+                                PayloadCompression::BoundedFloat32, 1e-6,
+                                float32_statistics );
+    auto float32_host = Kokkos::create_mirror_view( float32 );
+    Kokkos::deep_copy( float32_host, float32 );
+    for ( int i = 0; i < n; ++i )
+        for ( int j = 0; j < DIM; ++j )
+            TEST_COMPARE( std::abs( float32_host( i, j ) - ref_host( i, j ) ),
+                          <=, 1e-6 );
+
+    if ( comm_size > 1 )
+    {
+        TEST_EQUALITY( lossless_statistics.raw_bytes,
+                       n * DIM * sizeof( double ) );
+        TEST_COMPARE( lossless_statistics.ratio(), >, 1. );
+        TEST_COMPARE( float32_statistics.ratio(), >, 1. );
+    }
+    else
+    {
+        TEST_EQUALITY( lossless_statistics.raw_bytes, 0u );
+    }
+}
+
+// Include the test macros.
+#include "DataTransferKit_ETIHelperMacros.h"
+
+// Create the test group
+#define UNIT_TEST_GROUP( NODE )                                                \
+    using DeviceType##NODE = typename NODE::device_type;                       \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( DetailsNearestNeighborOperatorImpl,  \
+                                          compressed_fetch, DeviceType##NODE )
+
+// Demangle the types
+DTK_ETI_MANGLING_TYPEDEFS()
+
+// Instantiate the tests
+DTK_INSTANTIATE_N( UNIT_TEST_GROUP )
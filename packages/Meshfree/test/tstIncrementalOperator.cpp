@@ -0,0 +1,117 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "DTK_TestPoints.hpp"
+
+#include <DTK_IncrementalOperator.hpp>
+#include <DTK_MovingLeastSquaresOperator.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <Teuchos_UnitTestHarness.hpp>
+
+template <typename View1, typename View2>
+void checkEqual( View1 const &a, View2 const &b, bool &success,
+                 Teuchos::FancyOStream &out )
+{
+    auto a_host = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), a );
+    auto b_host = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), b );
+    for ( unsigned int i = 0; i < a_host.extent( 0 ); ++i )
+        for ( unsigned int j = 0; j < a_host.extent( 1 ); ++j )
+            TEST_FLOATING_EQUALITY( a_host( i, j ) + 10., b_host( i, j ) + 10.,
+                                    1e-12 );
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( IncrementalOperator, changed_values,
+                                   DeviceType )
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+
+    // The targets are owned by the next rank.
+    int const n_sources = 20;
+    int const n_targets = 30;
+    auto source_points =
+        makePoints<DeviceType>( n_sources, n_sources * comm_rank );
+    auto target_points = makePoints<DeviceType>(
+        n_targets, n_sources * ( ( comm_rank + 1 ) % comm_size ) + 0.2 );
+    DataTransferKit::MovingLeastSquaresOperator<DeviceType> mls(
+        comm, source_points, target_points );
+    DataTransferKit::IncrementalOperator<DeviceType> incremental( comm, mls );
+
+    int const n_components = 2;
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> source_values(
+        "source_values", n_sources, n_components );
+    auto source_values_host = Kokkos::create_mirror_view( source_values );
+    for ( int i = 0; i < n_sources; ++i )
+        for ( int j = 0; j < n_components; ++j )
+            source_values_host( i, j ) = 0.3 * ( i % 7 ) - j + comm_rank;
+    Kokkos::deep_copy( source_values, source_values_host );
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> target_values(
+        "target_values", n_targets, n_components );
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> expected(
+        "expected", n_targets, n_components );
+
+    incremental.apply( source_values, target_values );
+    mls.apply( source_values, expected );
+    checkEqual( target_values, expected, success, out );
+    int const full_send_size = incremental.lastSendSize();
+
+    // Change a few source values on the first rank only.
+    Kokkos::View<bool *, DeviceType> changed( "changed", n_sources );
+    auto changed_host = Kokkos::create_mirror_view( changed );
+    if ( comm_rank == 0 )
+        for ( int i = 0; i < 3; ++i )
+        {
+            changed_host( i ) = true;
+            source_values_host( i, 0 ) += 1.;
+        }
+    Kokkos::deep_copy( changed, changed_host );
+    Kokkos::deep_copy( source_values, source_values_host );
+    incremental.applyChanged( source_values, changed, target_values );
+    mls.apply( source_values, expected );
+    checkEqual( target_values, expected, success, out );
+    TEST_COMPARE( incremental.lastSendSize(), <=, full_send_size );
+    if ( comm_rank != 0 )
+        TEST_EQUALITY( incremental.lastSendSize(), 0 );
+
+    // Changes below the tolerance are not sent until they add up.
+    double const tolerance = 0.1;
+    for ( int j = 0; j < n_components; ++j )
+        source_values_host( n_sources - 1, j ) += 0.6 * tolerance;
+    Kokkos::deep_copy( source_values, source_values_host );
+    incremental.applyChanged( source_values, tolerance, target_values );
+    TEST_EQUALITY( incremental.lastSendSize(), 0 );
+    for ( int j = 0; j < n_components; ++j )
+        source_values_host( n_sources - 1, j ) += 0.6 * tolerance;
+    Kokkos::deep_copy( source_values, source_values_host );
+    incremental.applyChanged( source_values, tolerance, target_values );
+    mls.apply( source_values, expected );
+    checkEqual( target_values, expected, success, out );
+}
+
+// Include the test macros.
+#include "DataTransferKit_ETIHelperMacros.h"
+
+// Create the test group
+#define UNIT_TEST_GROUP( NODE )                                                \
+    using DeviceType##NODE = typename NODE::device_type;                       \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( IncrementalOperator,                 \
+                                          changed_values, DeviceType##NODE )
+
+// Demangle the types
+DTK_ETI_MANGLING_TYPEDEFS()
+
+// Instantiate the tests
+DTK_INSTANTIATE_N( UNIT_TEST_GROUP )
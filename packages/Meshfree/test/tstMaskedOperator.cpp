@@ -0,0 +1,123 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "DTK_TestPoints.hpp"
+
+#include <DTK_MaskedOperator.hpp>
+#include <DTK_MovingLeastSquaresOperator.hpp>
+#include <DTK_NearestNeighborOperator.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <Teuchos_UnitTestHarness.hpp>
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( MaskedOperator, target_subset, DeviceType )
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+
+    // The targets are owned by the next rank.
+    int const n_sources = 20;
+    int const n_targets = 30;
+    auto source_points =
+        makePoints<DeviceType>( n_sources, n_sources * comm_rank );
+    auto target_points = makePoints<DeviceType>(
+        n_targets, n_sources * ( ( comm_rank + 1 ) % comm_size ) + 0.2 );
+    DataTransferKit::NearestNeighborOperator<DeviceType> nn(
+        comm, source_points, target_points );
+    DataTransferKit::MovingLeastSquaresOperator<DeviceType> mls(
+        comm, source_points, target_points );
+
+    int const n_components = 2;
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> source_values(
+        "source_values", n_sources, n_components );
+    auto source_values_host = Kokkos::create_mirror_view( source_values );
+    for ( int i = 0; i < n_sources; ++i )
+        for ( int j = 0; j < n_components; ++j )
+            source_values_host( i, j ) = 0.3 * ( i % 7 ) - j + comm_rank;
+    Kokkos::deep_copy( source_values, source_values_host );
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> expected(
+        "expected", n_targets, n_components );
+
+    // Every third target on each rank, and the first ten on the last rank.
+    Kokkos::View<bool *, DeviceType> mask( "mask", n_targets );
+    auto mask_host = Kokkos::create_mirror_view( mask );
+    for ( int i = 0; i < n_targets; ++i )
+        mask_host( i ) = ( i % 3 == 0 ) ||
+                         ( comm_rank == comm_size - 1 && i < 10 );
+    Kokkos::deep_copy( mask, mask_host );
+    int n_selected = 0;
+    for ( int i = 0; i < n_targets; ++i )
+        n_selected += mask_host( i ) ? 1 : 0;
+    Kokkos::View<int *, DeviceType> indices( "indices", n_selected );
+    auto indices_host = Kokkos::create_mirror_view( indices );
+    for ( int i = 0, k = 0; i < n_targets; ++i )
+        if ( mask_host( i ) )
+            indices_host( k++ ) = i;
+    Kokkos::deep_copy( indices, indices_host );
+
+    for ( DataTransferKit::PointCloudOperator<DeviceType> const *op :
+          {static_cast<DataTransferKit::PointCloudOperator<DeviceType> const *>(
+               &nn ),
+           static_cast<DataTransferKit::PointCloudOperator<DeviceType> const *>(
+               &mls )} )
+    {
+        DataTransferKit::MaskedOperator<DeviceType> masked( comm, *op );
+        op->apply( source_values, expected );
+        auto expected_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), expected );
+
+        // The selected targets match the full transfer and the others are
+        // left untouched.
+        for ( int pass = 0; pass < 2; ++pass )
+        {
+            Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType>
+                target_values( "target_values", n_targets, n_components );
+            Kokkos::deep_copy( target_values, -1. );
+            if ( pass == 0 )
+                masked.apply( source_values, indices, target_values );
+            else
+                masked.applyMasked( source_values, mask, target_values );
+            auto target_values_host = Kokkos::create_mirror_view_and_copy(
+                Kokkos::HostSpace(), target_values );
+            for ( int i = 0; i < n_targets; ++i )
+                for ( int j = 0; j < n_components; ++j )
+                    TEST_FLOATING_EQUALITY(
+                        target_values_host( i, j ) + 10.,
+                        ( mask_host( i ) ? expected_host( i, j ) : -1. ) +
+                            10.,
+                        1e-12 );
+        }
+
+        // Both calls selected the same targets so they share one plan.
+        TEST_EQUALITY( masked.cacheSize(), 1 );
+        masked.clearCache();
+        TEST_EQUALITY( masked.cacheSize(), 0 );
+    }
+}
+
+// Include the test macros.
+#include "DataTransferKit_ETIHelperMacros.h"
+
+// Create the test group
+#define UNIT_TEST_GROUP( NODE )                                                \
+    using DeviceType##NODE = typename NODE::device_type;                       \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( MaskedOperator, target_subset,       \
+                                          DeviceType##NODE )
+
+// Demangle the types
+DTK_ETI_MANGLING_TYPEDEFS()
+
+// Instantiate the tests
+DTK_INSTANTIATE_N( UNIT_TEST_GROUP )
@@ -420,6 +420,104 @@ TEUCHOS_UNIT_TEST_TEMPLATE_3_DECL( MovingLeastSquaresOperator,
         TEST_ASSERT( std::isfinite( target_values_host[i] ) );
 }
 
+TEUCHOS_UNIT_TEST_TEMPLATE_3_DECL( MovingLeastSquaresOperator, offset_type,
+                                   DeviceType, RadialBasisFunction,
+                                   PolynomialBasis )
+{
+    // The operators with 32-bit and 64-bit stencil offsets must be identical.
+    using namespace DataTransferKit;
+
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+
+    std::array<int, DIM> n_source_points_grid = {10, 10, 2};
+    std::array<double, DIM> offset = {0., 0., 2. * comm_rank};
+    auto source_points_arr =
+        Helper<DeviceType>::makeGridPoints( n_source_points_grid, offset );
+    std::array<int, DIM> n_target_points_grid = {9, 9, 1};
+    offset = {0.5, 0.5, 2. * comm_rank + 0.5};
+    auto target_points_arr =
+        Helper<DeviceType>::makeGridPoints( n_target_points_grid, offset );
+
+    std::vector<double> source_values_arr( source_points_arr.size() );
+    for ( unsigned int i = 0; i < source_points_arr.size(); ++i )
+        source_values_arr[i] = std::sin( source_points_arr[i][0] ) +
+                               std::cos( source_points_arr[i][1] );
+    std::vector<double> target_values_arr( target_points_arr.size() );
+
+    auto source_points = Helper<DeviceType>::makePoints( source_points_arr );
+    auto source_values = Helper<DeviceType>::makeValues( source_values_arr );
+    auto target_points = Helper<DeviceType>::makePoints( target_points_arr );
+    auto target_values = Helper<DeviceType>::makeValues( target_values_arr );
+    auto target_values_64 =
+        Helper<DeviceType>::makeValues( target_values_arr );
+
+    MovingLeastSquaresOperator<DeviceType, RadialBasisFunction,
+                               PolynomialBasis>
+        mlsop( comm, source_points, target_points );
+    MovingLeastSquaresOperator<DeviceType, RadialBasisFunction,
+                               PolynomialBasis, long long>
+        mlsop_64( comm, source_points, target_points );
+
+    mlsop.apply( source_values, target_values );
+    mlsop_64.apply( source_values, target_values_64 );
+
+    auto target_values_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), target_values );
+    auto target_values_64_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), target_values_64 );
+    TEST_COMPARE_ARRAYS( target_values_host, target_values_64_host );
+
+    // Same with a field that has several components, in both directions.
+    int const n_components = 2;
+    int const n_source_points = source_points.extent( 0 );
+    int const n_target_points = target_points.extent( 0 );
+    Kokkos::View<double **, DeviceType> source_field(
+        "source_field", n_source_points, n_components );
+    for ( int c = 0; c < n_components; ++c )
+        Kokkos::deep_copy( Kokkos::subview( source_field, Kokkos::ALL, c ),
+                           source_values );
+    Kokkos::View<double **, DeviceType> target_field(
+        "target_field", n_target_points, n_components );
+    Kokkos::View<double **, DeviceType> target_field_64(
+        "target_field_64", n_target_points, n_components );
+    mlsop.apply( source_field, target_field );
+    mlsop_64.apply( source_field, target_field_64 );
+    Kokkos::View<double **, DeviceType> transpose_field(
+        "transpose_field", n_source_points, n_components );
+    Kokkos::View<double **, DeviceType> transpose_field_64(
+        "transpose_field_64", n_source_points, n_components );
+    mlsop.applyTranspose( target_field, transpose_field );
+    mlsop_64.applyTranspose( target_field, transpose_field_64 );
+
+    auto target_field_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), target_field );
+    auto target_field_64_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), target_field_64 );
+    for ( int i = 0; i < n_target_points; ++i )
+        for ( int c = 0; c < n_components; ++c )
+            TEST_EQUALITY( target_field_host( i, c ),
+                           target_field_64_host( i, c ) );
+    auto transpose_field_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), transpose_field );
+    auto transpose_field_64_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), transpose_field_64 );
+    for ( int i = 0; i < n_source_points; ++i )
+        for ( int c = 0; c < n_components; ++c )
+            TEST_FLOATING_EQUALITY( transpose_field_host( i, c ),
+                                    transpose_field_64_host( i, c ), 1e-14 );
+
+    auto row_offsets = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), mlsop.crsMatrix().row_offsets );
+    auto row_offsets_64 = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), mlsop_64.crsMatrix().row_offsets );
+    TEST_COMPARE_ARRAYS( row_offsets, row_offsets_64 );
+
+    TEST_COMPARE_ARRAYS( mlsop.statistics().stencil_sizes,
+                         mlsop_64.statistics().stencil_sizes );
+}
+
 // Include the test macros.
 #include "DataTransferKit_ETIHelperMacros.h"
 
@@ -471,7 +569,13 @@ using Quadratic3 =
         Wendland0, Linear3 )                                                   \
     TEUCHOS_UNIT_TEST_TEMPLATE_3_INSTANT(                                      \
         MovingLeastSquaresOperator, single_point_in_radius, DeviceType##NODE,  \
-        Wendland0, Quadratic3 )
+        Wendland0, Quadratic3 )                                                \
+    TEUCHOS_UNIT_TEST_TEMPLATE_3_INSTANT(                                      \
+        MovingLeastSquaresOperator, offset_type, DeviceType##NODE, Wendland0,  \
+        Linear3 )                                                              \
+    TEUCHOS_UNIT_TEST_TEMPLATE_3_INSTANT(                                      \
+        MovingLeastSquaresOperator, offset_type, DeviceType##NODE, Wendland0,  \
+        Quadratic3 )
 
 // Demangle the types
 DTK_ETI_MANGLING_TYPEDEFS()
@@ -250,7 +250,9 @@ void testUniquelyOwnedProblem(
 
 //---------------------------------------------------------------------------//
 // Partition the grids one-to-one
-TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( ExodusProblemGenerator, one_to_one, Node )
+template <class Node>
+void testOneToOne( const DataTransferKit::ExodusReadMode read_mode,
+                   bool &success, Teuchos::FancyOStream &out )
 {
     // Type aliases.
     using DeviceType = typename Node::device_type;
@@ -268,7 +270,7 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( ExodusProblemGenerator, one_to_one, Node )
         generator(
             *( Teuchos::rcp_dynamic_cast<Teuchos::MpiComm<int> const>( comm )
                    ->getRawMpiComm() ),
-            src_exodus_file, tgt_exodus_file );
+            src_exodus_file, tgt_exodus_file, read_mode );
 
     // Generate a uniquely owned problem.
     Kokkos::View<DataTransferKit::Coordinate **, Kokkos::LayoutLeft, DeviceType>
@@ -287,7 +289,9 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( ExodusProblemGenerator, one_to_one, Node )
 
 //---------------------------------------------------------------------------//
 // Partition the grids with standard ghosting from connectivity.
-TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( ExodusProblemGenerator, ghosted, Node )
+template <class Node>
+void testGhosted( const DataTransferKit::ExodusReadMode read_mode,
+                  bool &success, Teuchos::FancyOStream &out )
 {
     // Type aliases.
     using DeviceType = typename Node::device_type;
@@ -311,7 +315,7 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( ExodusProblemGenerator, ghosted, Node )
         generator(
             *( Teuchos::rcp_dynamic_cast<Teuchos::MpiComm<int> const>( comm )
                    ->getRawMpiComm() ),
-            src_exodus_file, tgt_exodus_file );
+            src_exodus_file, tgt_exodus_file, read_mode );
 
     // Generate a ghosted owned problem.
     Kokkos::View<DataTransferKit::Coordinate **, Kokkos::LayoutLeft, DeviceType>
@@ -382,6 +386,38 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( ExodusProblemGenerator, ghosted, Node )
                               success, out );
 }
 
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( ExodusProblemGenerator, one_to_one, Node )
+{
+    testOneToOne<Node>( DataTransferKit::ExodusReadMode::RankZero, success,
+                        out );
+}
+
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( ExodusProblemGenerator, ghosted, Node )
+{
+    testGhosted<Node>( DataTransferKit::ExodusReadMode::RankZero, success,
+                       out );
+}
+
+//---------------------------------------------------------------------------//
+// Every rank reads a slice of the files.
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( ExodusProblemGenerator, one_to_one_hyperslab,
+                                   Node )
+{
+    testOneToOne<Node>( DataTransferKit::ExodusReadMode::Hyperslab, success,
+                        out );
+}
+
+//---------------------------------------------------------------------------//
+// Every rank reads a slice of the files.
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( ExodusProblemGenerator, ghosted_hyperslab,
+                                   Node )
+{
+    testGhosted<Node>( DataTransferKit::ExodusReadMode::Hyperslab, success,
+                       out );
+}
+
 //---------------------------------------------------------------------------//
 
 // Include the test macros.
@@ -392,7 +428,11 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( ExodusProblemGenerator, ghosted, Node )
     TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( ExodusProblemGenerator, one_to_one,  \
                                           NODE )                               \
     TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( ExodusProblemGenerator, ghosted,     \
-                                          NODE )
+                                          NODE )                               \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( ExodusProblemGenerator,              \
+                                          one_to_one_hyperslab, NODE )         \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( ExodusProblemGenerator,              \
+                                          ghosted_hyperslab, NODE )
 
 // Demangle the types
 DTK_ETI_MANGLING_TYPEDEFS()
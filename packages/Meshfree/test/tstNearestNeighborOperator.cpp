@@ -269,6 +269,73 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( NearestNeighborOperator, mixed_clouds,
     }
 }
 
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( NearestNeighborOperator,
+                                   multiple_components, DeviceType )
+{
+    // Same setup as structured_clouds but every coordinate of the source
+    // points is transferred at once.
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+
+    double const Lx = 2.;
+    double const Ly = 3.;
+    double const Lz = 5.;
+    unsigned int const nx = 7;
+    unsigned int const ny = 11;
+    unsigned int const nz = 13;
+    int const target_rank = ( comm_rank + 1 ) % comm_size;
+
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> source_points(
+        "source_points", 0, 0 );
+    copyPointsFromCloud<DeviceType>(
+        makeStructuredCloud( Lx, Ly, Lz, nx, ny, nz, comm_rank * Lx,
+                             comm_rank * Ly, comm_rank * Lz ),
+        source_points );
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> target_points(
+        "target_points", 0, 0 );
+    copyPointsFromCloud<DeviceType>(
+        makeStructuredCloud( Lx, Ly, Lz, nx, ny, nz, target_rank * Lx,
+                             target_rank * Ly, target_rank * Lz ),
+        target_points );
+
+    DataTransferKit::NearestNeighborOperator<DeviceType> nnop(
+        comm, source_points, target_points );
+
+    unsigned int const n_points = source_points.extent( 0 );
+    int const n_components = 3;
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> source_values(
+        "source_values", n_points, n_components );
+    Kokkos::deep_copy( source_values, source_points );
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> target_values(
+        "target_values", n_points, n_components );
+
+    nnop.apply( source_values, target_values );
+
+    // Check results
+    auto target_values_host = Kokkos::create_mirror_view( target_values );
+    Kokkos::deep_copy( target_values_host, target_values );
+    auto target_points_host = Kokkos::create_mirror_view( target_points );
+    Kokkos::deep_copy( target_points_host, target_points );
+    for ( unsigned int i = 0; i < n_points; ++i )
+        for ( int d = 0; d < n_components; ++d )
+            TEST_FLOATING_EQUALITY(
+                target_values_host( i, d ),
+                static_cast<double>( target_points_host( i, d ) ), 1e-14 );
+
+    // Views in another layout are accepted without being repacked.
+    Kokkos::deep_copy( target_values, 0. );
+    nnop.apply( source_points, target_values );
+    Kokkos::deep_copy( target_values_host, target_values );
+    for ( unsigned int i = 0; i < n_points; ++i )
+        for ( int d = 0; d < n_components; ++d )
+            TEST_FLOATING_EQUALITY(
+                target_values_host( i, d ),
+                static_cast<double>( target_points_host( i, d ) ), 1e-14 );
+}
+
 // Include the test macros.
 #include "DataTransferKit_ETIHelperMacros.h"
 
@@ -280,7 +347,9 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( NearestNeighborOperator, mixed_clouds,
     TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT(                                      \
         NearestNeighborOperator, structured_clouds, DeviceType##NODE )         \
     TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( NearestNeighborOperator,             \
-                                          mixed_clouds, DeviceType##NODE )
+                                          mixed_clouds, DeviceType##NODE )     \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT(                                      \
+        NearestNeighborOperator, multiple_components, DeviceType##NODE )
 
 // Demangle the types
 DTK_ETI_MANGLING_TYPEDEFS()
@@ -0,0 +1,115 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "DTK_TestPoints.hpp"
+
+#include <DTK_MovingLeastSquaresOperator.hpp>
+#include <DTK_NearestNeighborOperator.hpp>
+#include <DTK_Profiling.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <Teuchos_UnitTestHarness.hpp>
+
+#include <algorithm>
+
+// Bytes per target point of the buffers an operator holds at once while it
+// is set up, for stencils of k source points and polynomial bases of size m
+// (zero for the nearest neighbor operator).
+long long setupBytesPerTarget( int k, int m )
+{
+    // the distributed search, with the query and its forwarded copies, then
+    // the index, rank and distance of a few candidates per stencil entry
+    long long const search = 4 * 64 + k * 4 * 16;
+    // indices, ranks and offset
+    long long const stencils = k * ( 4 + 4 ) + 2 * 4;
+    if ( m == 0 )
+        return search + stencils;
+    // fetched and transformed coordinates, with their exchange buffers, then
+    // P, phi and the coefficients
+    long long const entries = k * ( 4 * 3 * 8 + m * 8 + 8 + 8 );
+    // radius, then A, its inverse and the auxiliary space of the SVD (3 m^2)
+    long long const matrices = 8 + 5 * m * m * 8;
+    return search + stencils + entries + matrices;
+}
+
+// The memory needed to set up an operator must grow linearly with the number
+// of target points. The bounds are twice the buffers listed above, they catch
+// a temporary copied a few times or a change of complexity.
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( OperatorMemory, setup, DeviceType )
+{
+    namespace Profiling = DataTransferKit::Profiling;
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+
+    // The targets are owned by the next rank.
+    int const n_sources = 1000;
+    int const n_targets = 1000;
+    auto source_points =
+        makePoints<DeviceType>( n_sources, n_sources * comm_rank );
+    auto target_points = makePoints<DeviceType>(
+        n_targets, n_sources * ( ( comm_rank + 1 ) % comm_size ) + 0.2 );
+
+    Profiling::reset();
+    Profiling::enable();
+    {
+        DataTransferKit::NearestNeighborOperator<DeviceType> nn(
+            comm, source_points, target_points );
+        DataTransferKit::MovingLeastSquaresOperator<DeviceType> mls(
+            comm, source_points, target_points );
+    }
+    Profiling::disable();
+
+    TEST_ASSERT( Profiling::tracksMemory() );
+    out << Profiling::memoryReport( comm );
+
+    long long const nn_increase =
+        Profiling::peakMemoryIncrease( "DTK_nearest_neighbor_setup" );
+    TEST_ASSERT( nn_increase > 0 );
+    TEST_COMPARE( nn_increase, <=,
+                  2 * setupBytesPerTarget( 1, 0 ) * n_targets );
+
+    long long const mls_increase =
+        Profiling::peakMemoryIncrease( "DTK_moving_least_squares_setup" );
+    TEST_ASSERT( mls_increase > 0 );
+    int const basis_size =
+        DataTransferKit::MultivariatePolynomialBasis<DataTransferKit::Linear,
+                                                     3>::size;
+    TEST_COMPARE( mls_increase, <=,
+                  2 * setupBytesPerTarget( basis_size, basis_size ) *
+                      n_targets );
+
+    // The regions nested in the setup cannot use more than the setup.
+    TEST_COMPARE( Profiling::peakMemory( "DTK_distributed_search" ), <=,
+                  std::max( Profiling::peakMemory(
+                                "DTK_nearest_neighbor_setup" ),
+                            Profiling::peakMemory(
+                                "DTK_moving_least_squares_setup" ) ) );
+    Profiling::reset();
+}
+
+// Include the test macros.
+#include "DataTransferKit_ETIHelperMacros.h"
+
+// Create the test group
+#define UNIT_TEST_GROUP( NODE )                                                \
+    using DeviceType##NODE = typename NODE::device_type;                       \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( OperatorMemory, setup,               \
+                                          DeviceType##NODE )
+
+// Demangle the types
+DTK_ETI_MANGLING_TYPEDEFS()
+
+// Instantiate the tests
+DTK_INSTANTIATE_N( UNIT_TEST_GROUP )
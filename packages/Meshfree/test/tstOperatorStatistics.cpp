@@ -0,0 +1,186 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "DTK_TestPoints.hpp"
+
+#include <DTK_DetailsNearestNeighborOperatorImpl.hpp>
+#include <DTK_MovingLeastSquaresOperator.hpp>
+#include <DTK_NearestNeighborOperator.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <Teuchos_UnitTestHarness.hpp>
+
+#include <numeric>
+
+// Check the properties that hold for any operator.
+void checkStatistics( DataTransferKit::OperatorStatistics const &statistics,
+                      int n_targets, bool &success,
+                      Teuchos::FancyOStream &out )
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    TEST_EQUALITY( statistics.num_targets, n_targets );
+    auto const &sizes = statistics.stencil_sizes;
+    TEST_EQUALITY( std::accumulate( sizes.begin(), sizes.end(), 0 ),
+                   n_targets );
+    int n_entries = 0;
+    for ( unsigned int s = 0; s < sizes.size(); ++s )
+        n_entries += s * sizes[s];
+    TEST_EQUALITY( statistics.local_entries + statistics.remote_entries,
+                   n_entries );
+    TEST_EQUALITY( statistics.bytes_received,
+                   statistics.remote_entries *
+                       static_cast<long long>( sizeof( double ) ) );
+
+    // Every byte sent is received by another rank.
+    long long bytes[2] = {statistics.bytes_sent, statistics.bytes_received};
+    long long total_bytes[2];
+    MPI_Allreduce( bytes, total_bytes, 2, MPI_LONG_LONG, MPI_SUM, comm );
+    TEST_EQUALITY( total_bytes[0], total_bytes[1] );
+    int neighbors[2] = {statistics.send_neighbors, statistics.recv_neighbors};
+    int total_neighbors[2];
+    MPI_Allreduce( neighbors, total_neighbors, 2, MPI_INT, MPI_SUM, comm );
+    TEST_EQUALITY( total_neighbors[0], total_neighbors[1] );
+
+    // All the ranks own the same number of targets.
+    TEST_FLOATING_EQUALITY( statistics.target_imbalance, 1., 1e-14 );
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( OperatorStatistics, stencils, DeviceType )
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+
+    // The targets are owned by the next rank.
+    int const n_sources = 20;
+    int const n_targets = 30;
+    auto source_points =
+        makePoints<DeviceType>( n_sources, n_sources * comm_rank );
+    auto target_points = makePoints<DeviceType>(
+        n_targets, n_sources * ( ( comm_rank + 1 ) % comm_size ) + 0.2 );
+
+    DataTransferKit::NearestNeighborOperator<DeviceType> nn(
+        comm, source_points, target_points );
+    auto const nn_statistics = nn.statistics();
+    checkStatistics( nn_statistics, n_targets, success, out );
+    TEST_EQUALITY( nn_statistics.stencil_sizes.size(), 2u );
+    TEST_EQUALITY( nn_statistics.num_underdetermined, 0 );
+
+    DataTransferKit::MovingLeastSquaresOperator<DeviceType> mls(
+        comm, source_points, target_points );
+    checkStatistics( mls.statistics(), n_targets, success, out );
+}
+
+// Operators that compress the values never build a communication plan, their
+// statistics must not depend on it.
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( OperatorStatistics, compressed_values,
+                                   DeviceType )
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+
+    int const n_sources = 20;
+    int const n_targets = 30;
+    auto source_points =
+        makePoints<DeviceType>( n_sources, n_sources * comm_rank );
+    auto target_points = makePoints<DeviceType>(
+        n_targets, n_sources * ( ( comm_rank + 1 ) % comm_size ) + 0.2 );
+
+    DataTransferKit::PayloadCompressionOptions compression;
+    compression.values = DataTransferKit::PayloadCompression::Lossless;
+
+    // Compression is limited to the host memory space.
+    if ( !DataTransferKit::Details::NearestNeighborOperatorImpl<
+             DeviceType>::supportsCompression( compression ) )
+    {
+        TEST_THROW( DataTransferKit::NearestNeighborOperator<DeviceType>(
+                        comm, source_points, target_points, compression ),
+                    DataTransferKit::DataTransferKitException );
+        return;
+    }
+
+    // Same statistics as without compression, which are the volumes before
+    // encoding.
+    DataTransferKit::NearestNeighborOperator<DeviceType> nn(
+        comm, source_points, target_points );
+    DataTransferKit::NearestNeighborOperator<DeviceType> compressed_nn(
+        comm, source_points, target_points, compression );
+    auto const nn_statistics = nn.statistics();
+    auto const compressed_nn_statistics = compressed_nn.statistics();
+    checkStatistics( compressed_nn_statistics, n_targets, success, out );
+    TEST_COMPARE_ARRAYS( compressed_nn_statistics.stencil_sizes,
+                         nn_statistics.stencil_sizes );
+    TEST_EQUALITY( compressed_nn_statistics.bytes_sent,
+                   nn_statistics.bytes_sent );
+    TEST_EQUALITY( compressed_nn_statistics.send_neighbors,
+                   nn_statistics.send_neighbors );
+
+    DataTransferKit::MovingLeastSquaresOperator<DeviceType> mls(
+        comm, source_points, target_points );
+    DataTransferKit::MovingLeastSquaresOperator<DeviceType> compressed_mls(
+        comm, source_points, target_points, compression );
+    auto const mls_statistics = mls.statistics();
+    auto const compressed_mls_statistics = compressed_mls.statistics();
+    checkStatistics( compressed_mls_statistics, n_targets, success, out );
+    TEST_COMPARE_ARRAYS( compressed_mls_statistics.stencil_sizes,
+                         mls_statistics.stencil_sizes );
+    TEST_EQUALITY( compressed_mls_statistics.bytes_sent,
+                   mls_statistics.bytes_sent );
+    TEST_EQUALITY( compressed_mls_statistics.send_neighbors,
+                   mls_statistics.send_neighbors );
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( OperatorStatistics, underdetermined,
+                                   DeviceType )
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+
+    // A linear basis in 3D cannot be fitted to points on a line, so that all
+    // the moment matrices are rank deficient.
+    int const n_sources = 20;
+    int const n_targets = 10;
+    auto source_points =
+        makePoints<DeviceType>( n_sources, n_sources * comm_rank, true );
+    auto target_points =
+        makePoints<DeviceType>( n_targets, n_sources * comm_rank + 0.5, true );
+    DataTransferKit::MovingLeastSquaresOperator<DeviceType> mls(
+        comm, source_points, target_points );
+    TEST_EQUALITY( mls.statistics().num_underdetermined, n_targets );
+}
+
+// Include the test macros.
+#include "DataTransferKit_ETIHelperMacros.h"
+
+// Create the test group
+#define UNIT_TEST_GROUP( NODE )                                                \
+    using DeviceType##NODE = typename NODE::device_type;                       \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( OperatorStatistics, stencils,        \
+                                          DeviceType##NODE )                   \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( OperatorStatistics,                  \
+                                          compressed_values,                   \
+                                          DeviceType##NODE )                   \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( OperatorStatistics, underdetermined, \
+                                          DeviceType##NODE )
+
+// Demangle the types
+DTK_ETI_MANGLING_TYPEDEFS()
+
+// Instantiate the tests
+DTK_INSTANTIATE_N( UNIT_TEST_GROUP )
@@ -0,0 +1,170 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "DTK_TestPoints.hpp"
+
+#include <DTK_IncrementalOperator.hpp>
+#include <DTK_MovingLeastSquaresOperator.hpp>
+#include <DTK_NearestNeighborOperator.hpp>
+#include <DTK_Profiling.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <Teuchos_UnitTestHarness.hpp>
+
+// Number of Kokkos allocations made by f. The allocations are seen through the
+// memory hooks of the profiler.
+template <typename Functor>
+long long countAllocations( Functor const &f )
+{
+    namespace Profiling = DataTransferKit::Profiling;
+    Profiling::reset();
+    Profiling::enable();
+    f();
+    Profiling::disable();
+    return Profiling::allocationCount();
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointCloudOperator, repeated_apply,
+                                   DeviceType )
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+
+    // Shift the targets so that they are owned by the next rank.
+    int const n = 20;
+    auto source_points = makePoints<DeviceType>( n, n * comm_rank );
+    auto target_points = makePoints<DeviceType>(
+        n, n * ( ( comm_rank + 1 ) % comm_size ) + 0.2 );
+
+    Kokkos::View<double *, DeviceType> source_values( "source_values", n );
+    Kokkos::deep_copy( source_values, 1. );
+    Kokkos::View<double *, DeviceType> target_values( "target_values", n );
+
+    DataTransferKit::NearestNeighborOperator<DeviceType> nn(
+        comm, source_points, target_points );
+    DataTransferKit::MovingLeastSquaresOperator<DeviceType> mls(
+        comm, source_points, target_points );
+
+    // The first application sizes the communication buffers. It is profiled
+    // so that the memory hooks are in place afterwards.
+    countAllocations( [&]() {
+        nn.apply( source_values, target_values );
+        mls.apply( source_values, target_values );
+    } );
+    TEST_ASSERT( DataTransferKit::Profiling::tracksMemory() );
+
+    TEST_EQUALITY( countAllocations( [&]() {
+                       for ( int k = 0; k < 3; ++k )
+                           nn.apply( source_values, target_values );
+                   } ),
+                   0 );
+    TEST_EQUALITY( countAllocations( [&]() {
+                       for ( int k = 0; k < 3; ++k )
+                           mls.apply( source_values, target_values );
+                   } ),
+                   0 );
+
+    // Same with a field that has several components.
+    int const n_components = 3;
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> source_field(
+        "source_field", n, n_components );
+    Kokkos::deep_copy( source_field, 1. );
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> target_field(
+        "target_field", n, n_components );
+    nn.apply( source_field, target_field );
+    mls.apply( source_field, target_field );
+    TEST_EQUALITY( countAllocations( [&]() {
+                       nn.apply( source_field, target_field );
+                       mls.apply( source_field, target_field );
+                   } ),
+                   0 );
+    DataTransferKit::Profiling::reset();
+
+    auto target_field_host = Kokkos::create_mirror_view( target_field );
+    Kokkos::deep_copy( target_field_host, target_field );
+    for ( int i = 0; i < n; ++i )
+        for ( int d = 0; d < n_components; ++d )
+            TEST_FLOATING_EQUALITY( target_field_host( i, d ), 1., 1e-12 );
+
+    auto target_values_host = Kokkos::create_mirror_view( target_values );
+    Kokkos::deep_copy( target_values_host, target_values );
+    for ( int i = 0; i < n; ++i )
+        TEST_FLOATING_EQUALITY( target_values_host( i ), 1., 1e-12 );
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointCloudOperator,
+                                   repeated_incremental_apply, DeviceType )
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+
+    int const n = 20;
+    auto source_points = makePoints<DeviceType>( n, n * comm_rank );
+    auto target_points = makePoints<DeviceType>(
+        n, n * ( ( comm_rank + 1 ) % comm_size ) + 0.2 );
+
+    DataTransferKit::MovingLeastSquaresOperator<DeviceType> mls(
+        comm, source_points, target_points );
+    DataTransferKit::IncrementalOperator<DeviceType> incremental( comm, mls );
+
+    int const n_components = 2;
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> source_field(
+        "source_field", n, n_components );
+    Kokkos::deep_copy( source_field, 1. );
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> target_field(
+        "target_field", n, n_components );
+    Kokkos::View<bool *, DeviceType> changed( "changed", n );
+    Kokkos::deep_copy( changed, true );
+
+    // The first transfers size the buffers, the next ones reuse them.
+    auto const transfer = [&]() {
+        incremental.apply( source_field, target_field );
+        incremental.applyChanged( source_field, changed, target_field );
+        incremental.applyChanged( source_field, 0., target_field );
+    };
+    countAllocations( transfer );
+    TEST_EQUALITY( countAllocations( [&]() {
+                       for ( int k = 0; k < 3; ++k )
+                           transfer();
+                   } ),
+                   0 );
+    DataTransferKit::Profiling::reset();
+
+    auto target_field_host = Kokkos::create_mirror_view( target_field );
+    Kokkos::deep_copy( target_field_host, target_field );
+    for ( int i = 0; i < n; ++i )
+        for ( int d = 0; d < n_components; ++d )
+            TEST_FLOATING_EQUALITY( target_field_host( i, d ), 1., 1e-12 );
+}
+
+// Include the test macros.
+#include "DataTransferKit_ETIHelperMacros.h"
+
+// Create the test group
+#define UNIT_TEST_GROUP( NODE )                                                \
+    using DeviceType##NODE = typename NODE::device_type;                       \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( PointCloudOperator, repeated_apply,  \
+                                          DeviceType##NODE )                   \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT(                                      \
+        PointCloudOperator, repeated_incremental_apply, DeviceType##NODE )
+
+// Demangle the types
+DTK_ETI_MANGLING_TYPEDEFS()
+
+// Instantiate the tests
+DTK_INSTANTIATE_N( UNIT_TEST_GROUP )
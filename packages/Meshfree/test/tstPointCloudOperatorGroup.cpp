@@ -0,0 +1,117 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "DTK_TestPoints.hpp"
+
+#include <DTK_MovingLeastSquaresOperator.hpp>
+#include <DTK_NearestNeighborOperator.hpp>
+#include <DTK_PointCloudOperatorGroup.hpp>
+#include <DTK_SourceIndex.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <Teuchos_UnitTestHarness.hpp>
+
+#include <memory>
+#include <vector>
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointCloudOperatorGroup, fused_fetch,
+                                   DeviceType )
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+    using Operator = DataTransferKit::PointCloudOperator<DeviceType>;
+
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+
+    int const n = 20;
+    auto source_points = makePoints<DeviceType>( n, n * comm_rank );
+    DataTransferKit::SourceIndex<DeviceType> source_index( comm,
+                                                           source_points );
+
+    // The targets overlap so that some source values are needed by several
+    // operators.
+    std::vector<int> n_targets = {n, n, 2 * n};
+    std::vector<Kokkos::View<DataTransferKit::Coordinate **, DeviceType>>
+        target_points = {
+            makePoints<DeviceType>(
+                n, n * ( ( comm_rank + 1 ) % comm_size ) + 0.2 ),
+            makePoints<DeviceType>(
+                n, n * ( ( comm_rank + 1 ) % comm_size ) + 0.4 ),
+            makePoints<DeviceType>( 2 * n, 0.7 )};
+    std::vector<std::shared_ptr<Operator const>> operators = {
+        std::make_shared<DataTransferKit::NearestNeighborOperator<DeviceType>>(
+            source_index, target_points[0] ),
+        std::make_shared<
+            DataTransferKit::MovingLeastSquaresOperator<DeviceType>>(
+            source_index, target_points[1] ),
+        std::make_shared<DataTransferKit::NearestNeighborOperator<DeviceType>>(
+            source_index, target_points[2] )};
+    DataTransferKit::PointCloudOperatorGroup<DeviceType> group( comm,
+                                                                operators );
+    TEST_EQUALITY( group.size(), 3 );
+    // Each source value is fetched once even though the operators request
+    // 7 * n values. They are owned by the next rank or the first two ranks.
+    TEST_COMPARE( group.fetchSize(), <=, 3 * n );
+
+    int const n_components = 2;
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> source_values(
+        "source_values", n, n_components );
+    Kokkos::parallel_for( Kokkos::RangePolicy<ExecutionSpace>( 0, n ),
+                          KOKKOS_LAMBDA( int i ) {
+                              source_values( i, 0 ) = n * comm_rank + i;
+                              source_values( i, 1 ) = 1.;
+                          } );
+    Kokkos::fence();
+
+    std::vector<Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>>
+        group_values;
+    for ( int k = 0; k < 3; ++k )
+        group_values.push_back(
+            Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType>(
+                "group_values", n_targets[k], n_components ) );
+    group.apply( source_values, group_values );
+
+    // The group must give the same values as the operators on their own.
+    for ( int k = 0; k < 3; ++k )
+    {
+        Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> values(
+            "values", n_targets[k], n_components );
+        operators[k]->apply( source_values, values );
+
+        auto values_host = Kokkos::create_mirror_view( values );
+        Kokkos::deep_copy( values_host, values );
+        auto group_values_host = Kokkos::create_mirror_view( group_values[k] );
+        Kokkos::deep_copy( group_values_host, group_values[k] );
+        for ( int i = 0; i < n_targets[k]; ++i )
+            for ( int j = 0; j < n_components; ++j )
+                TEST_FLOATING_EQUALITY( group_values_host( i, j ),
+                                        values_host( i, j ), 1e-12 );
+    }
+}
+
+// Include the test macros.
+#include "DataTransferKit_ETIHelperMacros.h"
+
+// Create the test group
+#define UNIT_TEST_GROUP( NODE )                                                \
+    using DeviceType##NODE = typename NODE::device_type;                       \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( PointCloudOperatorGroup,             \
+                                          fused_fetch, DeviceType##NODE )
+
+// Demangle the types
+DTK_ETI_MANGLING_TYPEDEFS()
+
+// Instantiate the tests
+DTK_INSTANTIATE_N( UNIT_TEST_GROUP )
@@ -0,0 +1,116 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "DTK_TestPoints.hpp"
+
+#include <DTK_CrsMatrixTpetra.hpp>
+#include <DTK_MovingLeastSquaresOperator.hpp>
+#include <DTK_NearestNeighborOperator.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <Teuchos_DefaultComm.hpp>
+#include <Teuchos_UnitTestHarness.hpp>
+
+#include <Tpetra_Vector.hpp>
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointCloudOperator, crs_matrix, Node )
+{
+    using DeviceType = typename Node::device_type;
+    using Vector =
+        Tpetra::Vector<double, int, DataTransferKit::GlobalOrdinal, Node>;
+
+    auto teuchos_comm = Teuchos::DefaultComm<int>::getComm();
+    MPI_Comm comm =
+        *( Teuchos::rcp_dynamic_cast<Teuchos::MpiComm<int> const>(
+               teuchos_comm )
+               ->getRawMpiComm() );
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+
+    // The targets are owned by the next rank.
+    int const n_sources = 20;
+    int const n_targets = 30;
+    auto source_points =
+        makePoints<DeviceType>( n_sources, n_sources * comm_rank );
+    auto target_points = makePoints<DeviceType>(
+        n_targets, n_sources * ( ( comm_rank + 1 ) % comm_size ) + 0.2 );
+
+    DataTransferKit::NearestNeighborOperator<DeviceType> nn(
+        comm, source_points, target_points );
+    DataTransferKit::MovingLeastSquaresOperator<DeviceType> mls(
+        comm, source_points, target_points );
+
+    // The nearest neighbor operator has a single unit entry per row.
+    auto nn_matrix = nn.crsMatrix();
+    TEST_EQUALITY( nn_matrix.numLocalRows(), n_targets );
+    TEST_EQUALITY( nn_matrix.num_local_columns, n_sources );
+    TEST_EQUALITY( nn_matrix.first_row, n_targets * comm_rank );
+    TEST_EQUALITY( nn_matrix.first_column, n_sources * comm_rank );
+    TEST_EQUALITY( nn_matrix.num_global_rows, n_targets * comm_size );
+    TEST_EQUALITY( nn_matrix.num_global_columns, n_sources * comm_size );
+    auto nn_offsets = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), nn_matrix.row_offsets );
+    auto nn_values = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), nn_matrix.values );
+    for ( int i = 0; i < n_targets; ++i )
+    {
+        TEST_EQUALITY( nn_offsets( i ), i );
+        TEST_EQUALITY( nn_values( i ), 1. );
+    }
+
+    // Applying the exported matrix gives the same values as the operators.
+    Kokkos::View<double *, DeviceType> source_values( "source_values",
+                                                      n_sources );
+    auto source_values_host = Kokkos::create_mirror_view( source_values );
+    for ( int i = 0; i < n_sources; ++i )
+        source_values_host( i ) = 0.3 * ( i % 7 ) + comm_rank;
+    Kokkos::deep_copy( source_values, source_values_host );
+    Kokkos::View<double *, DeviceType> target_values( "target_values",
+                                                      n_targets );
+    for ( DataTransferKit::PointCloudOperator<DeviceType> const *op :
+          {static_cast<DataTransferKit::PointCloudOperator<DeviceType> const *>(
+               &nn ),
+           static_cast<DataTransferKit::PointCloudOperator<DeviceType> const *>(
+               &mls )} )
+    {
+        op->apply( source_values, target_values );
+        auto target_values_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), target_values );
+
+        auto matrix = DataTransferKit::createTpetraCrsMatrix<Node>(
+            teuchos_comm, op->crsMatrix() );
+        Vector x( matrix->getDomainMap() );
+        for ( int i = 0; i < n_sources; ++i )
+            x.replaceLocalValue( i, source_values_host( i ) );
+        Vector y( matrix->getRangeMap() );
+        matrix->apply( x, y );
+        auto y_data = y.getData();
+        for ( int i = 0; i < n_targets; ++i )
+            TEST_FLOATING_EQUALITY( y_data[i] + 1.,
+                                    target_values_host( i ) + 1., 1e-12 );
+    }
+}
+
+// Include the test macros.
+#include "DataTransferKit_ETIHelperMacros.h"
+
+// Create the test group
+#define UNIT_TEST_GROUP( NODE )                                                \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( PointCloudOperator, crs_matrix, NODE )
+
+// Demangle the types
+DTK_ETI_MANGLING_TYPEDEFS()
+
+// Instantiate the tests
+DTK_INSTANTIATE_N( UNIT_TEST_GROUP )
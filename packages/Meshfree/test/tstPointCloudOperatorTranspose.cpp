@@ -0,0 +1,122 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "DTK_TestPoints.hpp"
+
+#include <DTK_MovingLeastSquaresOperator.hpp>
+#include <DTK_NearestNeighborOperator.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <Teuchos_UnitTestHarness.hpp>
+
+template <typename DeviceType>
+Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType>
+makeValues( int n, int n_components, double seed )
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> values(
+        "values", n, n_components );
+    Kokkos::parallel_for( Kokkos::RangePolicy<ExecutionSpace>( 0, n ),
+                          KOKKOS_LAMBDA( int i ) {
+                              for ( int j = 0; j < n_components; ++j )
+                                  values( i, j ) = seed * ( i % 7 ) - j;
+                          } );
+    Kokkos::fence();
+    return values;
+}
+
+// Sum over all ranks of the dot product of two fields.
+template <typename View>
+double dot( MPI_Comm comm, View const &a, View const &b )
+{
+    auto a_host = Kokkos::create_mirror_view( a );
+    Kokkos::deep_copy( a_host, a );
+    auto b_host = Kokkos::create_mirror_view( b );
+    Kokkos::deep_copy( b_host, b );
+    double local = 0.;
+    for ( unsigned int i = 0; i < a_host.extent( 0 ); ++i )
+        for ( unsigned int j = 0; j < a_host.extent( 1 ); ++j )
+            local += a_host( i, j ) * b_host( i, j );
+    double global = 0.;
+    MPI_Allreduce( &local, &global, 1, MPI_DOUBLE, MPI_SUM, comm );
+    return global;
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointCloudOperator, transpose, DeviceType )
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+
+    // The targets are owned by the next rank and are more numerous than the
+    // sources.
+    int const n_sources = 20;
+    int const n_targets = 30;
+    auto source_points =
+        makePoints<DeviceType>( n_sources, n_sources * comm_rank );
+    auto target_points = makePoints<DeviceType>(
+        n_targets, n_sources * ( ( comm_rank + 1 ) % comm_size ) + 0.2 );
+
+    DataTransferKit::NearestNeighborOperator<DeviceType> nn(
+        comm, source_points, target_points );
+    DataTransferKit::MovingLeastSquaresOperator<DeviceType> mls(
+        comm, source_points, target_points );
+
+    // Check that <A x, y> = <x, A^T y> for fields with several components.
+    int const n_components = 2;
+    auto x = makeValues<DeviceType>( n_sources, n_components, 0.3 );
+    auto y = makeValues<DeviceType>( n_targets, n_components, 0.7 );
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> ax(
+        "ax", n_targets, n_components );
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> aty(
+        "aty", n_sources, n_components );
+    for ( DataTransferKit::PointCloudOperator<DeviceType> const *op :
+          {static_cast<DataTransferKit::PointCloudOperator<DeviceType> const *>(
+               &nn ),
+           static_cast<DataTransferKit::PointCloudOperator<DeviceType> const *>(
+               &mls )} )
+    {
+        op->apply( x, ax );
+        op->applyTranspose( y, aty );
+        TEST_FLOATING_EQUALITY( dot( comm, ax, y ), dot( comm, x, aty ),
+                                1e-12 );
+
+        // A single component gives the same result as the first column.
+        auto y_0 = Kokkos::subview( y, Kokkos::ALL, 0 );
+        Kokkos::View<double *, DeviceType> aty_0( "aty_0", n_sources );
+        op->applyTranspose( y_0, aty_0 );
+        auto aty_host = Kokkos::create_mirror_view( aty );
+        Kokkos::deep_copy( aty_host, aty );
+        auto aty_0_host = Kokkos::create_mirror_view( aty_0 );
+        Kokkos::deep_copy( aty_0_host, aty_0 );
+        for ( int i = 0; i < n_sources; ++i )
+            TEST_FLOATING_EQUALITY( aty_0_host( i ) + 1., aty_host( i, 0 ) + 1.,
+                                    1e-14 );
+    }
+}
+
+// Include the test macros.
+#include "DataTransferKit_ETIHelperMacros.h"
+
+// Create the test group
+#define UNIT_TEST_GROUP( NODE )                                                \
+    using DeviceType##NODE = typename NODE::device_type;                       \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( PointCloudOperator, transpose,       \
+                                          DeviceType##NODE )
+
+// Demangle the types
+DTK_ETI_MANGLING_TYPEDEFS()
+
+// Instantiate the tests
+DTK_INSTANTIATE_N( UNIT_TEST_GROUP )
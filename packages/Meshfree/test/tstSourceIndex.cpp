@@ -0,0 +1,108 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "DTK_TestPoints.hpp"
+
+#include <DTK_MovingLeastSquaresOperator.hpp>
+#include <DTK_NearestNeighborOperator.hpp>
+#include <DTK_SourceIndex.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <Teuchos_UnitTestHarness.hpp>
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( SourceIndex, shared_by_operators,
+                                   DeviceType )
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+
+    int const n = 20;
+    auto source_points = makePoints<DeviceType>( n, n * comm_rank );
+    auto first_target_points = makePoints<DeviceType>(
+        n, n * ( ( comm_rank + 1 ) % comm_size ) + 0.2 );
+    auto second_target_points = makePoints<DeviceType>( 2 * n, 0.7 );
+
+    Kokkos::View<double *, DeviceType> source_values( "source_values", n );
+    Kokkos::parallel_for( Kokkos::RangePolicy<ExecutionSpace>( 0, n ),
+                          KOKKOS_LAMBDA( int i ) {
+                              source_values( i ) = n * comm_rank + i;
+                          } );
+    Kokkos::fence();
+
+    // Operators built on a shared index must match the ones that build their
+    // own search tree.
+    DataTransferKit::SourceIndex<DeviceType> source_index( comm,
+                                                           source_points );
+    TEST_EQUALITY( source_index.size(), n );
+
+    auto check = [&]( DataTransferKit::PointCloudOperator<DeviceType> const
+                          &shared,
+                      DataTransferKit::PointCloudOperator<DeviceType> const
+                          &reference,
+                      int n_targets ) {
+        Kokkos::View<double *, DeviceType> shared_values( "shared_values",
+                                                          n_targets );
+        shared.apply( source_values, shared_values );
+        Kokkos::View<double *, DeviceType> reference_values(
+            "reference_values", n_targets );
+        reference.apply( source_values, reference_values );
+
+        auto shared_host = Kokkos::create_mirror_view( shared_values );
+        Kokkos::deep_copy( shared_host, shared_values );
+        auto reference_host = Kokkos::create_mirror_view( reference_values );
+        Kokkos::deep_copy( reference_host, reference_values );
+        for ( int i = 0; i < n_targets; ++i )
+            TEST_FLOATING_EQUALITY( shared_host( i ), reference_host( i ),
+                                    1e-12 );
+    };
+
+    check( DataTransferKit::NearestNeighborOperator<DeviceType>(
+               source_index, first_target_points ),
+           DataTransferKit::NearestNeighborOperator<DeviceType>(
+               comm, source_points, first_target_points ),
+           n );
+    check( DataTransferKit::NearestNeighborOperator<DeviceType>(
+               source_index, second_target_points ),
+           DataTransferKit::NearestNeighborOperator<DeviceType>(
+               comm, source_points, second_target_points ),
+           2 * n );
+    check( DataTransferKit::MovingLeastSquaresOperator<DeviceType>(
+               source_index, first_target_points ),
+           DataTransferKit::MovingLeastSquaresOperator<DeviceType>(
+               comm, source_points, first_target_points ),
+           n );
+    check( DataTransferKit::MovingLeastSquaresOperator<DeviceType>(
+               source_index, second_target_points ),
+           DataTransferKit::MovingLeastSquaresOperator<DeviceType>(
+               comm, source_points, second_target_points ),
+           2 * n );
+}
+
+// Include the test macros.
+#include "DataTransferKit_ETIHelperMacros.h"
+
+// Create the test group
+#define UNIT_TEST_GROUP( NODE )                                                \
+    using DeviceType##NODE = typename NODE::device_type;                       \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( SourceIndex, shared_by_operators,    \
+                                          DeviceType##NODE )
+
+// Demangle the types
+DTK_ETI_MANGLING_TYPEDEFS()
+
+// Instantiate the tests
+DTK_INSTANTIATE_N( UNIT_TEST_GROUP )
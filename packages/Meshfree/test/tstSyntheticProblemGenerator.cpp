@@ -0,0 +1,265 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "DTK_ConfigDefs.hpp"
+#include "DTK_Types.h"
+
+#include "PointCloudProblemGenerator/SyntheticProblemGenerator.hpp"
+#include <DTK_MovingLeastSquaresOperator_decl.hpp>
+#include <DTK_MovingLeastSquaresOperator_def.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <Teuchos_DefaultComm.hpp>
+#include <Teuchos_UnitTestHarness.hpp>
+
+#include <vector>
+
+//---------------------------------------------------------------------------//
+// Check the points of a cloud generated on this rank: the first
+// points_per_rank points are owned by this rank and lie in its slab, the
+// other ones come from the neighboring ranks and lie within the halo.
+template <class Generator, class... ViewProperties>
+void checkCloud(
+    Kokkos::View<DataTransferKit::Coordinate **, ViewProperties...> coords,
+    Kokkos::View<DataTransferKit::GlobalOrdinal *, ViewProperties...> gids,
+    Kokkos::View<double **, ViewProperties...> values, int comm_rank,
+    int comm_size, int points_per_rank, double y_offset, double halo_width,
+    bool &success, Teuchos::FancyOStream &out )
+{
+    auto coords_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), coords );
+    auto gids_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), gids );
+    auto values_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), values );
+
+    int const n = coords.extent( 0 );
+    TEST_ASSERT( n >= points_per_rank );
+    TEST_EQUALITY( coords.extent( 1 ), 3u );
+    TEST_EQUALITY( values.extent( 1 ), 1u );
+    for ( int i = 0; i < n; ++i )
+    {
+        double const x = coords_host( i, 0 );
+        double const y = coords_host( i, 1 );
+        double const z = coords_host( i, 2 );
+        TEST_FLOATING_EQUALITY( values_host( i, 0 ),
+                                Generator::field( x, y, z ), 1e-14 );
+        TEST_ASSERT( y >= y_offset && y <= y_offset + 1. );
+        TEST_ASSERT( z >= 0. && z <= 1. );
+        if ( i < points_per_rank )
+        {
+            TEST_EQUALITY( gids_host( i ),
+                           static_cast<DataTransferKit::GlobalOrdinal>(
+                               comm_rank ) * points_per_rank +
+                               i );
+            TEST_ASSERT( x >= comm_rank && x <= comm_rank + 1 );
+        }
+        else
+        {
+            int const owner = gids_host( i ) / points_per_rank;
+            TEST_ASSERT( owner == comm_rank - 1 || owner == comm_rank + 1 );
+            TEST_ASSERT( owner >= 0 && owner < comm_size );
+            TEST_ASSERT( x >= comm_rank - halo_width &&
+                         x <= comm_rank + 1 + halo_width );
+            TEST_ASSERT( x >= owner && x <= owner + 1 );
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( SyntheticProblemGenerator, distributions,
+                                   Node )
+{
+    // Type aliases.
+    using DeviceType = typename Node::device_type;
+    using Scalar = double;
+    using Generator =
+        DataTransferKit::SyntheticProblemGenerator<Scalar, DeviceType,
+                                                   DeviceType>;
+
+    // Get the communicator.
+    auto comm = Teuchos::DefaultComm<int>::getComm();
+    int const comm_rank = comm->getRank();
+    int const comm_size = comm->getSize();
+
+    for ( auto distribution :
+          {DataTransferKit::PointDistribution::Uniform,
+           DataTransferKit::PointDistribution::Clustered,
+           DataTransferKit::PointDistribution::Shells,
+           DataTransferKit::PointDistribution::Anisotropic} )
+    {
+        // The target cloud has half the density of the source cloud and
+        // overlaps half of it.
+        DataTransferKit::SyntheticPointCloudOptions source;
+        source.distribution = distribution;
+        source.points_per_rank = 200;
+        DataTransferKit::SyntheticPointCloudOptions target = source;
+        target.points_per_rank = 100;
+        double const overlap = 0.5;
+        double const halo_width = 0.2;
+        Generator generator(
+            *( Teuchos::rcp_dynamic_cast<Teuchos::MpiComm<int> const>( comm )
+                   ->getRawMpiComm() ),
+            source, target, overlap, halo_width );
+
+        // Generate a uniquely owned problem.
+        Kokkos::View<DataTransferKit::Coordinate **, Kokkos::LayoutLeft,
+                     DeviceType>
+            src_coords;
+        Kokkos::View<DataTransferKit::Coordinate **, Kokkos::LayoutLeft,
+                     DeviceType>
+            tgt_coords;
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, DeviceType> src_field;
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, DeviceType> tgt_field;
+        generator.createUniquelyOwnedProblem( src_coords, src_field,
+                                              tgt_coords, tgt_field );
+        TEST_EQUALITY( src_coords.extent( 0 ), 200u );
+        TEST_EQUALITY( tgt_coords.extent( 0 ), 100u );
+
+        // Generate a ghosted problem. The owned points come first and are
+        // the same as in the uniquely owned problem.
+        Kokkos::View<DataTransferKit::Coordinate **, Kokkos::LayoutLeft,
+                     DeviceType>
+            src_ghosted_coords;
+        Kokkos::View<DataTransferKit::Coordinate **, Kokkos::LayoutLeft,
+                     DeviceType>
+            tgt_ghosted_coords;
+        Kokkos::View<DataTransferKit::GlobalOrdinal *, Kokkos::LayoutLeft,
+                     DeviceType>
+            src_gids;
+        Kokkos::View<DataTransferKit::GlobalOrdinal *, Kokkos::LayoutLeft,
+                     DeviceType>
+            tgt_gids;
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, DeviceType>
+            src_ghosted_field;
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, DeviceType>
+            tgt_ghosted_field;
+        generator.createGhostedProblem( src_ghosted_coords, src_gids,
+                                        src_ghosted_field, tgt_ghosted_coords,
+                                        tgt_gids, tgt_ghosted_field );
+        checkCloud<Generator>( src_ghosted_coords, src_gids, src_ghosted_field,
+                               comm_rank, comm_size, 200, 0., halo_width,
+                               success, out );
+        checkCloud<Generator>( tgt_ghosted_coords, tgt_gids, tgt_ghosted_field,
+                               comm_rank, comm_size, 100, 1. - overlap,
+                               halo_width, success, out );
+
+        auto src_coords_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), src_coords );
+        auto src_ghosted_coords_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), src_ghosted_coords );
+        for ( int i = 0; i < 200; ++i )
+            for ( int d = 0; d < 3; ++d )
+                TEST_EQUALITY( src_coords_host( i, d ),
+                               src_ghosted_coords_host( i, d ) );
+
+        // Without neighbors in the X direction there is nothing to ghost.
+        if ( comm_size == 1 )
+        {
+            TEST_EQUALITY( src_ghosted_coords.extent( 0 ), 200u );
+            TEST_EQUALITY( tgt_ghosted_coords.extent( 0 ), 100u );
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+// The field is linear so that the moving least squares operator must
+// reproduce the target field exactly.
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( SyntheticProblemGenerator,
+                                   moving_least_squares, Node )
+{
+    // Type aliases.
+    using DeviceType = typename Node::device_type;
+    using ExecutionSpace = typename DeviceType::execution_space;
+    using Scalar = double;
+
+    // Get the communicator.
+    auto comm = Teuchos::DefaultComm<int>::getComm();
+    MPI_Comm mpi_comm =
+        *( Teuchos::rcp_dynamic_cast<Teuchos::MpiComm<int> const>( comm )
+               ->getRawMpiComm() );
+
+    for ( auto distribution : {DataTransferKit::PointDistribution::Uniform,
+                               DataTransferKit::PointDistribution::Clustered} )
+    {
+        DataTransferKit::SyntheticPointCloudOptions source;
+        source.distribution = distribution;
+        source.points_per_rank = 500;
+        DataTransferKit::SyntheticPointCloudOptions target;
+        target.points_per_rank = 50;
+        DataTransferKit::SyntheticProblemGenerator<Scalar, DeviceType,
+                                                   DeviceType>
+            generator( mpi_comm, source, target );
+
+        Kokkos::View<DataTransferKit::Coordinate **, Kokkos::LayoutLeft,
+                     DeviceType>
+            src_coords;
+        Kokkos::View<DataTransferKit::Coordinate **, Kokkos::LayoutLeft,
+                     DeviceType>
+            tgt_coords;
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, DeviceType> src_field;
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, DeviceType> tgt_field;
+        generator.createUniquelyOwnedProblem( src_coords, src_field,
+                                              tgt_coords, tgt_field );
+
+        // For now we copy the coordinates and the fields to the device
+        // default layout for compatibility with the current operator
+        // definition.
+        int const num_src = src_coords.extent( 0 );
+        int const num_tgt = tgt_coords.extent( 0 );
+        Kokkos::View<DataTransferKit::Coordinate **, DeviceType>
+            src_coords_device( "src_coords_device", num_src, 3 );
+        Kokkos::deep_copy( src_coords_device, src_coords );
+        Kokkos::View<DataTransferKit::Coordinate **, DeviceType>
+            tgt_coords_device( "tgt_coords_device", num_tgt, 3 );
+        Kokkos::deep_copy( tgt_coords_device, tgt_coords );
+        Kokkos::View<double *, DeviceType> src_field_device(
+            "src_field_device", num_src );
+        Kokkos::parallel_for( Kokkos::RangePolicy<ExecutionSpace>( 0, num_src ),
+                              KOKKOS_LAMBDA( int i ) {
+                                  src_field_device( i ) = src_field( i, 0 );
+                              } );
+        Kokkos::fence();
+        Kokkos::View<double *, DeviceType> tgt_field_device(
+            "tgt_field_device", num_tgt );
+
+        DataTransferKit::MovingLeastSquaresOperator<DeviceType> mls_op(
+            mpi_comm, src_coords_device, tgt_coords_device );
+        mls_op.apply( src_field_device, tgt_field_device );
+
+        auto tgt_field_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), tgt_field_device );
+        auto expected_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), tgt_field );
+        for ( int i = 0; i < num_tgt; ++i )
+            TEST_FLOATING_EQUALITY( tgt_field_host( i ), expected_host( i, 0 ),
+                                    1e-8 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+
+// Include the test macros.
+#include "DataTransferKit_ETIHelperMacros.h"
+
+// Create the test group
+#define UNIT_TEST_GROUP( NODE )                                                \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( SyntheticProblemGenerator,           \
+                                          distributions, NODE )                \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( SyntheticProblemGenerator,           \
+                                          moving_least_squares, NODE )
+
+// Demangle the types
+DTK_ETI_MANGLING_TYPEDEFS()
+
+// Instantiate the tests
+DTK_INSTANTIATE_N( UNIT_TEST_GROUP )
@@ -18,6 +18,7 @@
 #define DTK_CONFIGDEFS_HPP
 
 #include "DataTransferKit_config.hpp"
+#include "DTK_Profiling.hpp"
 
 #include <string>
 
@@ -26,7 +27,36 @@ namespace DataTransferKit
 
 #include "DTK_Types.h"
 
-#define DTK_MARK_REGION( x ) std::string( "DTK_" ) + x
+// Label of a parallel kernel, timed by the profiler for as long as the
+// kernel runs. The label is a string literal, the name of the region is built
+// once per call site so that marking a kernel does not allocate.
+#define DTK_MARK_REGION( x )                                                   \
+    ::DataTransferKit::Profiling::Region( []() -> std::string const * {        \
+        static std::string const name = "DTK_" x;                              \
+        return &name;                                                          \
+    }() )
+
+// Name of the region object of a scope, unique per line so that several
+// scopes can be marked in the same block.
+#define DTK_CONCAT_IMPL( a, b ) a##b
+#define DTK_CONCAT( a, b ) DTK_CONCAT_IMPL( a, b )
+#define DTK_SCOPE_NAME DTK_CONCAT( dtk_profiling_scope_, __LINE__ )
+
+// Time the rest of the enclosing scope, e.g. a communication step.
+#define DTK_MARK_SCOPE( x )                                                    \
+    ::DataTransferKit::Profiling::Region const DTK_SCOPE_NAME(                 \
+        []() -> std::string const * {                                          \
+            static std::string const name = "DTK_" x;                          \
+            return &name;                                                      \
+        }() )
+
+// Same as above for labels computed at run time, e.g. from a topology.
+#define DTK_MARK_DYNAMIC_REGION( x )                                           \
+    ::DataTransferKit::Profiling::Region( std::string( "DTK_" ) + x )
+
+#define DTK_MARK_DYNAMIC_SCOPE( x )                                            \
+    ::DataTransferKit::Profiling::Region const DTK_SCOPE_NAME(                 \
+        std::string( "DTK_" ) + x )
 
 } // namespace DataTransferKit
 
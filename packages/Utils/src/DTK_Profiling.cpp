@@ -0,0 +1,434 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#include "DTK_Profiling.hpp"
+#include "DTK_DBC.hpp"
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace DataTransferKit
+{
+namespace Profiling
+{
+namespace
+{ // anonymous
+
+struct Timing
+{
+    int calls = 0;
+    double total = 0.;
+    long long peak_bytes = 0;
+    long long peak_increase = 0;
+};
+
+// Bytes held when a region was opened and largest number of bytes held
+// since.
+struct OpenRegion
+{
+    long long entry_bytes;
+    long long peak_bytes;
+};
+
+struct Event
+{
+    std::string name;
+    double start;
+    double duration;
+};
+
+bool environmentRequests( char const *value )
+{
+    char const *variable = std::getenv( "DTK_PROFILING" );
+    return variable != nullptr &&
+           ( value == nullptr || std::strcmp( variable, value ) == 0 );
+}
+
+std::atomic<bool> profilingEnabled( environmentRequests( nullptr ) );
+bool tracingEnabled = environmentRequests( "trace" );
+std::map<std::string, Timing> timings;
+std::vector<Event> events;
+
+// Kokkos allocations made while profiling. The other allocations are
+// ignored when they are freed. Kokkos may allocate from any host thread, the
+// mutex guards the state below.
+std::mutex memoryMutex;
+bool memoryHooksInstalled = false;
+std::unordered_map<void const *, std::uint64_t> allocations;
+long long numAllocations = 0;
+long long liveBytes = 0;
+long long peakBytes = 0;
+std::vector<OpenRegion> openRegions;
+
+#if defined( KOKKOS_VERSION ) && KOKKOS_VERSION >= 30200
+using SpaceHandle = Kokkos::Tools::SpaceHandle;
+#else
+using SpaceHandle = Kokkos::Profiling::SpaceHandle;
+#endif
+
+void allocateData( SpaceHandle, char const *, void const *ptr,
+                   std::uint64_t size )
+{
+    Details::allocateData( ptr, size );
+}
+
+void deallocateData( SpaceHandle, char const *, void const *ptr,
+                     std::uint64_t )
+{
+    Details::deallocateData( ptr );
+}
+
+// Hook into the allocations of Kokkos, which must be initialized. The hooks
+// stay in place once installed so that the allocations made while profiling
+// are accounted for when they are freed. Before Kokkos 3.2 the hooks can only
+// be reached through a Kokkos Tools library, see Details::attachMemoryHooks().
+void installMemoryHooks()
+{
+#if defined( KOKKOS_VERSION ) && KOKKOS_VERSION >= 30200
+    if ( memoryHooksInstalled || Kokkos::Tools::profileLibraryLoaded() )
+        return;
+    Kokkos::Tools::Experimental::set_allocate_data_callback( allocateData );
+    Kokkos::Tools::Experimental::set_deallocate_data_callback(
+        deallocateData );
+    memoryHooksInstalled = true;
+#endif
+}
+
+// Seconds since the program started.
+double now()
+{
+    static auto const origin = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>( std::chrono::steady_clock::now() -
+                                          origin )
+        .count();
+}
+
+std::string escape( std::string const &s )
+{
+    std::string escaped;
+    for ( char c : s )
+    {
+        if ( c == '"' || c == '\\' )
+            escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+// Names of the regions timed on any rank of comm, sorted.
+std::vector<std::string> allRegionNames( MPI_Comm comm )
+{
+    std::string local_names;
+    for ( auto const &timing : timings )
+        local_names += timing.first + '\n';
+
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+    int local_size = local_names.size();
+    std::vector<int> sizes( comm_size );
+    MPI_Allgather( &local_size, 1, MPI_INT, sizes.data(), 1, MPI_INT, comm );
+    std::vector<int> offsets( comm_size + 1, 0 );
+    std::partial_sum( sizes.begin(), sizes.end(), offsets.begin() + 1 );
+    std::vector<char> all_names( offsets.back() );
+    MPI_Allgatherv( &local_names[0], local_size, MPI_CHAR, all_names.data(),
+                    sizes.data(), offsets.data(), MPI_CHAR, comm );
+
+    std::set<std::string> names;
+    std::istringstream is( std::string( all_names.begin(), all_names.end() ) );
+    std::string name;
+    while ( std::getline( is, name ) )
+        names.insert( name );
+    return std::vector<std::string>( names.begin(), names.end() );
+}
+
+} // namespace
+
+namespace Details
+{
+
+void attachMemoryHooks() { memoryHooksInstalled = true; }
+
+void allocateData( void const *ptr, std::uint64_t size )
+{
+    if ( !profilingEnabled )
+        return;
+    std::lock_guard<std::mutex> lock( memoryMutex );
+    allocations[ptr] = size;
+    ++numAllocations;
+    liveBytes += size;
+    peakBytes = std::max( peakBytes, liveBytes );
+    for ( auto &region : openRegions )
+        region.peak_bytes = std::max( region.peak_bytes, liveBytes );
+}
+
+void deallocateData( void const *ptr )
+{
+    std::lock_guard<std::mutex> lock( memoryMutex );
+    auto it = allocations.find( ptr );
+    if ( it == allocations.end() )
+        return;
+    liveBytes -= it->second;
+    allocations.erase( it );
+}
+
+} // namespace Details
+
+void enable( bool trace )
+{
+    profilingEnabled = true;
+    tracingEnabled = trace;
+}
+
+void disable() { profilingEnabled = false; }
+
+bool isEnabled() { return profilingEnabled; }
+
+void reset()
+{
+    timings.clear();
+    events.clear();
+    std::lock_guard<std::mutex> lock( memoryMutex );
+    numAllocations = 0;
+    peakBytes = liveBytes;
+}
+
+double totalTime( std::string const &region )
+{
+    auto it = timings.find( region );
+    return it != timings.end() ? it->second.total : 0.;
+}
+
+bool tracksMemory() { return memoryHooksInstalled; }
+
+long long allocationCount()
+{
+    std::lock_guard<std::mutex> lock( memoryMutex );
+    return numAllocations;
+}
+
+long long peakMemory( std::string const &region )
+{
+    auto it = timings.find( region );
+    return it != timings.end() ? it->second.peak_bytes : 0;
+}
+
+long long peakMemoryIncrease( std::string const &region )
+{
+    auto it = timings.find( region );
+    return it != timings.end() ? it->second.peak_increase : 0;
+}
+
+std::string memoryReport( MPI_Comm comm )
+{
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+    auto const names = allRegionNames( comm );
+    int const n_regions = names.size();
+
+    // The last entry is the peak over the whole run.
+    std::vector<long long> local_peaks( n_regions + 1, 0 );
+    std::vector<long long> local_increases( n_regions + 1, 0 );
+    for ( int i = 0; i < n_regions; ++i )
+    {
+        local_peaks[i] = peakMemory( names[i] );
+        local_increases[i] = peakMemoryIncrease( names[i] );
+    }
+    {
+        std::lock_guard<std::mutex> lock( memoryMutex );
+        local_peaks[n_regions] = peakBytes;
+        local_increases[n_regions] = peakBytes;
+    }
+    int const n = n_regions + 1;
+    std::vector<long long> min_peaks( n );
+    std::vector<long long> max_peaks( n );
+    std::vector<long long> sum_peaks( n );
+    std::vector<long long> max_increases( n );
+    MPI_Allreduce( local_peaks.data(), min_peaks.data(), n, MPI_LONG_LONG,
+                   MPI_MIN, comm );
+    MPI_Allreduce( local_peaks.data(), max_peaks.data(), n, MPI_LONG_LONG,
+                   MPI_MAX, comm );
+    MPI_Allreduce( local_peaks.data(), sum_peaks.data(), n, MPI_LONG_LONG,
+                   MPI_SUM, comm );
+    MPI_Allreduce( local_increases.data(), max_increases.data(), n,
+                   MPI_LONG_LONG, MPI_MAX, comm );
+
+    // The regions that need the most memory first.
+    std::vector<int> order( n_regions );
+    std::iota( order.begin(), order.end(), 0 );
+    std::stable_sort( order.begin(), order.end(),
+                      [&max_increases]( int a, int b ) {
+                          return max_increases[a] > max_increases[b];
+                      } );
+    order.insert( order.begin(), n_regions );
+
+    std::size_t width = std::strlen( "(all)" );
+    for ( auto const &name : names )
+        width = std::max( width, name.size() );
+    std::ostringstream os;
+    os << "DTK memory report over " << comm_size
+       << " rank(s), peak bytes held by Kokkos allocations\n";
+    os << std::left << std::setw( width ) << "region" << std::right
+       << std::setw( 16 ) << "max increase" << std::setw( 16 ) << "min peak"
+       << std::setw( 16 ) << "avg peak" << std::setw( 16 ) << "max peak"
+       << '\n';
+    for ( int i : order )
+        os << std::left << std::setw( width )
+           << ( i == n_regions ? std::string( "(all)" ) : names[i] )
+           << std::right << std::setw( 16 ) << max_increases[i]
+           << std::setw( 16 ) << min_peaks[i] << std::setw( 16 )
+           << sum_peaks[i] / comm_size << std::setw( 16 ) << max_peaks[i]
+           << '\n';
+    return os.str();
+}
+
+std::string report( MPI_Comm comm )
+{
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+    auto const names = allRegionNames( comm );
+    int const n_regions = names.size();
+
+    // Regions that did not run on a rank count as zero time there.
+    std::vector<double> local_times( n_regions, 0. );
+    std::vector<int> local_calls( n_regions, 0 );
+    for ( int i = 0; i < n_regions; ++i )
+    {
+        auto it = timings.find( names[i] );
+        if ( it != timings.end() )
+        {
+            local_times[i] = it->second.total;
+            local_calls[i] = it->second.calls;
+        }
+    }
+    std::vector<double> min_times( n_regions );
+    std::vector<double> max_times( n_regions );
+    std::vector<double> sum_times( n_regions );
+    std::vector<int> max_calls( n_regions );
+    MPI_Allreduce( local_times.data(), min_times.data(), n_regions,
+                   MPI_DOUBLE, MPI_MIN, comm );
+    MPI_Allreduce( local_times.data(), max_times.data(), n_regions,
+                   MPI_DOUBLE, MPI_MAX, comm );
+    MPI_Allreduce( local_times.data(), sum_times.data(), n_regions,
+                   MPI_DOUBLE, MPI_SUM, comm );
+    MPI_Allreduce( local_calls.data(), max_calls.data(), n_regions, MPI_INT,
+                   MPI_MAX, comm );
+
+    // The most expensive regions first.
+    std::vector<int> order( n_regions );
+    std::iota( order.begin(), order.end(), 0 );
+    std::stable_sort( order.begin(), order.end(), [&max_times]( int a, int b ) {
+        return max_times[a] > max_times[b];
+    } );
+
+    std::size_t width = std::strlen( "region" );
+    for ( auto const &name : names )
+        width = std::max( width, name.size() );
+    std::ostringstream os;
+    os << "DTK profiling report over " << comm_size
+       << " rank(s), times in seconds\n";
+    os << std::left << std::setw( width ) << "region" << std::right
+       << std::setw( 10 ) << "calls" << std::setw( 14 ) << "min"
+       << std::setw( 14 ) << "avg" << std::setw( 14 ) << "max" << '\n';
+    os << std::scientific << std::setprecision( 4 );
+    for ( int i : order )
+        os << std::left << std::setw( width ) << names[i] << std::right
+           << std::setw( 10 ) << max_calls[i] << std::setw( 14 )
+           << min_times[i] << std::setw( 14 ) << sum_times[i] / comm_size
+           << std::setw( 14 ) << max_times[i] << '\n';
+
+    // Tracking memory is a local decision, all the ranks must take part in
+    // the memory report if one of them does.
+    int local_tracks = tracksMemory() ? 1 : 0;
+    int tracks = 0;
+    MPI_Allreduce( &local_tracks, &tracks, 1, MPI_INT, MPI_MAX, comm );
+    if ( tracks )
+        os << '\n' << memoryReport( comm );
+    return os.str();
+}
+
+void writeChromeTrace( std::string const &filename )
+{
+    int world_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &world_rank );
+    std::ofstream file( filename );
+    if ( !file )
+        throw DataTransferKitException( "Cannot open " + filename +
+                                        " to write the profiling trace" );
+    file << "{\"traceEvents\":[";
+    file << std::fixed << std::setprecision( 3 );
+    for ( std::size_t i = 0; i < events.size(); ++i )
+        file << ( i == 0 ? "" : "," ) << "\n{\"name\":\""
+             << escape( events[i].name ) << "\",\"ph\":\"X\",\"ts\":"
+             << events[i].start * 1e6
+             << ",\"dur\":" << events[i].duration * 1e6
+             << ",\"pid\":" << world_rank << ",\"tid\":0}";
+    file << "\n]}\n";
+}
+
+Region::Region( std::string name )
+    : Region( &_owned_name )
+{
+    _owned_name = std::move( name );
+}
+
+Region::Region( std::string const *name )
+    : _name( name )
+    , _active( profilingEnabled )
+{
+    if ( !_active )
+        return;
+    installMemoryHooks();
+    std::lock_guard<std::mutex> lock( memoryMutex );
+    openRegions.push_back( {liveBytes, liveBytes} );
+    _start = now();
+}
+
+Region::~Region()
+{
+    if ( !_active )
+        return;
+    Kokkos::fence();
+    double const duration = now() - _start;
+    auto &timing = timings[*_name];
+    ++timing.calls;
+    timing.total += duration;
+    OpenRegion region;
+    {
+        std::lock_guard<std::mutex> lock( memoryMutex );
+        DTK_CHECK( !openRegions.empty() );
+        region = openRegions.back();
+        openRegions.pop_back();
+    }
+    timing.peak_bytes = std::max( timing.peak_bytes, region.peak_bytes );
+    timing.peak_increase = std::max( timing.peak_increase,
+                                     region.peak_bytes - region.entry_bytes );
+    if ( tracingEnabled )
+        events.push_back( {*_name, _start, duration} );
+}
+
+} // namespace Profiling
+} // namespace DataTransferKit
@@ -0,0 +1,147 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+/*!
+ * \file
+ * \brief Timers of the regions marked in DTK.
+ */
+#ifndef DTK_PROFILING_HPP
+#define DTK_PROFILING_HPP
+
+#include <mpi.h>
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace DataTransferKit
+{
+namespace Profiling
+{
+
+/*! Start timing the marked regions. When trace is true, every region is
+ * also recorded for writeChromeTrace(). Profiling is also enabled when the
+ * environment variable DTK_PROFILING is set, and tracing when it is set to
+ * "trace".
+ */
+void enable( bool trace = false );
+
+/*! Stop timing the marked regions. The timings are kept. */
+void disable();
+
+/*! Whether the marked regions are timed. */
+bool isEnabled();
+
+/*! Forget all the timings. */
+void reset();
+
+/*! Summary of the time spent in every region on the ranks of comm, with the
+ * minimum, average and maximum over the ranks, followed by memoryReport().
+ * Collective, the same string is returned on every rank.
+ */
+std::string report( MPI_Comm comm = MPI_COMM_WORLD );
+
+/*! Seconds spent in the region on this rank since the last reset(), summed
+ * over its calls. Zero if the region never ran.
+ */
+double totalTime( std::string const &region );
+
+/*! Whether the bytes held by Kokkos allocations are tracked. With Kokkos 3.2
+ * or later the hooks are installed when the first region is opened, unless a
+ * Kokkos Tools library is loaded so that its hooks are not replaced. Older
+ * versions of Kokkos only report allocations to a Kokkos Tools library, which
+ * must forward them through the functions of Details below.
+ */
+bool tracksMemory();
+
+/*! Number of Kokkos allocations made while profiling since the last
+ * reset(). Zero if memory is not tracked.
+ */
+long long allocationCount();
+
+/*! Largest number of bytes held by the Kokkos allocations made while
+ * profiling, on this rank, while the region was open. Zero if the region
+ * never ran or memory is not tracked.
+ */
+long long peakMemory( std::string const &region );
+
+/*! Same as above for the growth above the bytes held when the region was
+ * opened, i.e. the memory used by the region itself.
+ */
+long long peakMemoryIncrease( std::string const &region );
+
+/*! Summary of the peak memory of every region on the ranks of comm, with the
+ * minimum, average and maximum over the ranks. Collective, the same string
+ * is returned on every rank.
+ */
+std::string memoryReport( MPI_Comm comm = MPI_COMM_WORLD );
+
+/*! Write the regions recorded on this rank as a timeline in the Chrome
+ * trace event format (chrome://tracing). The process id of the events is
+ * the rank in MPI_COMM_WORLD so that the files of several ranks can be
+ * concatenated.
+ */
+void writeChromeTrace( std::string const &filename );
+
+namespace Details
+{
+/*! Entry points for a Kokkos Tools library that forwards the Kokkos
+ * allocations to the profiler, e.g. from its kokkosp_init_library(),
+ * kokkosp_allocate_data() and kokkosp_deallocate_data(). DTK does not define
+ * these symbols itself so as not to clash with the tools loaded by the
+ * application.
+ */
+void attachMemoryHooks();
+
+void allocateData( void const *ptr, std::uint64_t size );
+
+void deallocateData( void const *ptr );
+} // namespace Details
+
+/*! Timer for the lifetime of the object. DTK_MARK_REGION creates a
+ * temporary one used as the label of a parallel kernel, which lives until
+ * the kernel returns. When profiling is enabled, the destructor fences so
+ * that device kernels are timed until completion. Regions must be destroyed
+ * in the reverse order of their creation, as scoped objects are. The timings
+ * are not guarded: regions, as the other functions of this file, are meant
+ * for the master thread only. Only the memory hooks may be called by Kokkos
+ * from any thread.
+ */
+class Region
+{
+  public:
+    explicit Region( std::string name );
+
+    // The name must outlive the region, e.g. a static string.
+    explicit Region( std::string const *name );
+
+    ~Region();
+
+    Region( Region const & ) = delete;
+    Region &operator=( Region const & ) = delete;
+
+    operator std::string const &() const { return *_name; }
+
+  private:
+    std::string _owned_name;
+    std::string const *_name;
+    double _start = 0.;
+    bool _active = false;
+};
+
+inline std::ostream &operator<<( std::ostream &os, Region const &region )
+{
+    return os << static_cast<std::string const &>( region );
+}
+
+} // namespace Profiling
+} // namespace DataTransferKit
+
+#endif // DTK_PROFILING_HPP
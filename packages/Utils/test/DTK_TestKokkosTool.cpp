@@ -0,0 +1,47 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+// Kokkos Tools library that forwards the Kokkos allocations to the DTK
+// profiler, for the tests that count them with Kokkos older than 3.2. Kokkos
+// loads it from KOKKOS_PROFILE_LIBRARY. The DTK symbols are left unresolved
+// and found in the test executable or in the DTK libraries it loaded, so that
+// the allocations reach the same profiler as the test.
+
+#include <DTK_Profiling.hpp>
+
+#include <cstdint>
+
+namespace
+{
+// Same layout as the space handle of Kokkos, which is passed by value.
+struct SpaceHandle
+{
+    char name[64];
+};
+} // namespace
+
+extern "C" void kokkosp_init_library( int, std::uint64_t, std::uint32_t,
+                                      void * )
+{
+    DataTransferKit::Profiling::Details::attachMemoryHooks();
+}
+
+extern "C" void kokkosp_allocate_data( SpaceHandle, char const *,
+                                       void const *ptr, std::uint64_t size )
+{
+    DataTransferKit::Profiling::Details::allocateData( ptr, size );
+}
+
+extern "C" void kokkosp_deallocate_data( SpaceHandle, char const *,
+                                         void const *ptr, std::uint64_t )
+{
+    DataTransferKit::Profiling::Details::deallocateData( ptr );
+}
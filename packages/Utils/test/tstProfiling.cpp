@@ -0,0 +1,104 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <DTK_ConfigDefs.hpp>
+#include <DTK_Profiling.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <Teuchos_UnitTestHarness.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace
+{
+void runKernel( int n )
+{
+    Kokkos::View<double *> values( "values", n );
+    Kokkos::parallel_for( DTK_MARK_REGION( "fill_values" ),
+                          Kokkos::RangePolicy<>( 0, n ),
+                          KOKKOS_LAMBDA( int i ) { values( i ) = 2. * i; } );
+    Kokkos::fence();
+}
+} // namespace
+
+TEUCHOS_UNIT_TEST( Profiling, report )
+{
+    namespace Profiling = DataTransferKit::Profiling;
+    Profiling::reset();
+
+    // Nothing is recorded until profiling is enabled.
+    Profiling::disable();
+    runKernel( 10 );
+    auto const empty_report = Profiling::report( MPI_COMM_WORLD );
+    TEST_ASSERT( empty_report.find( "DTK_fill_values" ) == std::string::npos );
+
+    Profiling::enable();
+    TEST_ASSERT( Profiling::isEnabled() );
+    for ( int k = 0; k < 3; ++k )
+        runKernel( 100 );
+    {
+        // Several scopes may be marked in the same block.
+        DTK_MARK_SCOPE( "communication" );
+        MPI_Barrier( MPI_COMM_WORLD );
+        DTK_MARK_SCOPE( "second_communication" );
+        MPI_Barrier( MPI_COMM_WORLD );
+    }
+    Profiling::disable();
+
+    // The report is the same on every rank.
+    auto const report = Profiling::report( MPI_COMM_WORLD );
+    out << report;
+    TEST_ASSERT( report.find( "DTK_fill_values" ) != std::string::npos );
+    TEST_ASSERT( report.find( "DTK_communication" ) != std::string::npos );
+    TEST_ASSERT( report.find( "DTK_second_communication" ) !=
+                 std::string::npos );
+    std::string root_report = report;
+    int size = root_report.size();
+    MPI_Bcast( &size, 1, MPI_INT, 0, MPI_COMM_WORLD );
+    root_report.resize( size );
+    MPI_Bcast( &root_report[0], size, MPI_CHAR, 0, MPI_COMM_WORLD );
+    TEST_EQUALITY( report, root_report );
+
+    TEST_ASSERT( Profiling::totalTime( "DTK_communication" ) > 0. );
+    TEST_EQUALITY( Profiling::totalTime( "DTK_not_a_region" ), 0. );
+
+    Profiling::reset();
+    TEST_EQUALITY( Profiling::totalTime( "DTK_communication" ), 0. );
+    auto const reset_report = Profiling::report( MPI_COMM_WORLD );
+    TEST_ASSERT( reset_report.find( "DTK_fill_values" ) == std::string::npos );
+}
+
+TEUCHOS_UNIT_TEST( Profiling, chrome_trace )
+{
+    namespace Profiling = DataTransferKit::Profiling;
+    Profiling::reset();
+    Profiling::enable( true );
+    runKernel( 10 );
+    Profiling::disable();
+
+    int comm_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+    std::string const filename =
+        "dtk_trace_" + std::to_string( comm_rank ) + ".json";
+    Profiling::writeChromeTrace( filename );
+    std::ifstream file( filename );
+    std::string const trace( ( std::istreambuf_iterator<char>( file ) ),
+                             std::istreambuf_iterator<char>() );
+    TEST_ASSERT( trace.find( "\"traceEvents\"" ) != std::string::npos );
+    TEST_ASSERT( trace.find( "\"name\":\"DTK_fill_values\",\"ph\":\"X\"" ) !=
+                 std::string::npos );
+    std::remove( filename.c_str() );
+    Profiling::reset();
+}